@@ -0,0 +1,476 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include <algorithm>
+
+#include "comm/NetBench.h"
+
+namespace
+{
+
+const int BENCH_OPCODE = 1;
+
+#pragma pack(push, 1)
+/**
+ * Bench packet payload header, payload padding follow it.
+ */
+struct BenchHeader
+{
+    sint64 sendTime;        // client send time, in micro-seconds.
+    uint32 token;           // client token, use to identify the origin client in broadcast mode.
+    sint32 sessionId;       // client side session Id.
+};
+#pragma pack(pop)
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp(bool broadcast)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _broadcast(broadcast)
+    , _handledMsgs(0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (!sessionInfo.IsListenSession())
+            _sessionIds.insert(sessionInfo.GetSessionId());
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        _sessionIds.erase(destroyInfo.GetSessionId());
+    }
+
+public:
+    void OnBenchData(LLBC_Packet &packet)
+    {
+        ++_handledMsgs;
+        if (_broadcast)
+            GetService()->Multicast(_sessionIds, BENCH_OPCODE, packet.GetPayload(), packet.GetPayloadLength());
+        else
+            GetService()->Send(packet.GetSessionId(), BENCH_OPCODE, packet.GetPayload(), packet.GetPayloadLength());
+    }
+
+    sint64 GetHandledMsgs() const { return _handledMsgs; }
+
+private:
+    bool _broadcast;
+    sint64 _handledMsgs;
+    LLBC_SessionIdSet _sessionIds;
+};
+
+class ClientComp : public LLBC_Component
+{
+public:
+    ClientComp(const NetBenchCfg &cfg, sint64 measureBegin, sint64 measureEnd)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _cfg(cfg)
+    , _token(static_cast<uint32>(LLBC_GetMicroSeconds()))
+    , _measureBegin(measureBegin)
+    , _measureEnd(measureEnd)
+    , _sentMsgs(0)
+    , _recvMsgs(0)
+    , _recvBytes(0)
+    {
+        _payload.resize(std::max<size_t>(cfg.payloadSize, sizeof(BenchHeader)));
+        memset(&_payload[0], 'x', _payload.size());
+        _latencies.reserve(1024 * 1024);
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (sessionInfo.IsListenSession())
+            return;
+
+        for (int i = 0; i < _cfg.pipeline; ++i)
+            SendBenchData(sessionInfo.GetSessionId(), LLBC_GetMicroSeconds());
+    }
+
+public:
+    void OnBenchData(LLBC_Packet &packet)
+    {
+        if (UNLIKELY(packet.GetPayloadLength() < sizeof(BenchHeader)))
+            return;
+
+        BenchHeader header;
+        memcpy(&header, packet.GetPayload(), sizeof(BenchHeader));
+
+        const sint64 now = LLBC_GetMicroSeconds();
+        if (now >= _measureBegin && now < _measureEnd)
+        {
+            ++_recvMsgs;
+            _recvBytes += packet.GetPayloadLength();
+            _latencies.push_back(now - header.sendTime);
+        }
+
+        // In broadcast mode, only the origin session keep pipeline going.
+        if (header.token == _token &&
+            header.sessionId == packet.GetSessionId() &&
+            now < _measureEnd)
+            SendBenchData(packet.GetSessionId(), now);
+    }
+
+    void FillResult(NetBenchResult &result)
+    {
+        result.sentMsgs = _sentMsgs;
+        result.recvMsgs = _recvMsgs;
+        result.recvBytes = _recvBytes;
+        if (_latencies.empty())
+            return;
+
+        std::sort(_latencies.begin(), _latencies.end());
+        const size_t count = _latencies.size();
+        auto percentile = [this, count](double p) {
+            return _latencies[std::min(count - 1, static_cast<size_t>(count * p))];
+        };
+
+        double latSum = 0.0;
+        for (auto &lat : _latencies)
+            latSum += lat;
+
+        result.latMin = _latencies.front();
+        result.latAvg = latSum / count;
+        result.latP50 = percentile(0.5);
+        result.latP90 = percentile(0.9);
+        result.latP99 = percentile(0.99);
+        result.latP999 = percentile(0.999);
+        result.latMax = _latencies.back();
+    }
+
+private:
+    void SendBenchData(int sessionId, sint64 now)
+    {
+        BenchHeader header;
+        header.sendTime = now;
+        header.token = _token;
+        header.sessionId = sessionId;
+        memcpy(&_payload[0], &header, sizeof(BenchHeader));
+
+        if (GetService()->Send(sessionId, BENCH_OPCODE, _payload.data(), _payload.size()) == LLBC_OK &&
+            now >= _measureBegin)
+            ++_sentMsgs;
+    }
+
+private:
+    const NetBenchCfg &_cfg;
+    const uint32 _token;
+    const sint64 _measureBegin;
+    const sint64 _measureEnd;
+
+    sint64 _sentMsgs;
+    sint64 _recvMsgs;
+    sint64 _recvBytes;
+    LLBC_String _payload;
+    std::vector<sint64> _latencies;
+};
+
+}
+
+NetBenchCfg::NetBenchCfg()
+: mode("echo")
+, transport("tcp")
+, role("both")
+, format("text")
+, ip("127.0.0.1")
+, port(7900)
+, sessions(8)
+, payloadSize(64)
+, pipeline(1)
+, serverPollers(1)
+, clientPollers(1)
+, fps(LLBC_CFG_COMM_DFT_SERVICE_FPS)
+, busyPoll(0)
+, warmup(1)
+, duration(5)
+{
+}
+
+int NetBenchCfg::Parse(int argc, char *argv[])
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const LLBC_String arg(argv[i]);
+        if (!arg.startswith("--"))
+        {
+            LLBC_FilePrintLn(stderr, "Invalid argument: %s", arg.c_str());
+            return LLBC_FAILED;
+        }
+
+        const LLBC_Strings kv = arg.substr(2).split('=', 1);
+        if (kv.size() != 2 || kv[1].empty())
+        {
+            LLBC_FilePrintLn(stderr, "Invalid argument: %s", arg.c_str());
+            return LLBC_FAILED;
+        }
+
+        const LLBC_String &key = kv[0];
+        const LLBC_String &val = kv[1];
+        if (key == "mode")
+            mode = val;
+        else if (key == "transport")
+            transport = val;
+        else if (key == "role")
+            role = val;
+        else if (key == "format")
+            format = val;
+        else if (key == "ip")
+            ip = val;
+        else if (key == "port")
+            port = static_cast<uint16>(LLBC_Str2Int32(val.c_str()));
+        else if (key == "sessions")
+            sessions = LLBC_Str2Int32(val.c_str());
+        else if (key == "payload")
+            payloadSize = LLBC_Str2Int32(val.c_str());
+        else if (key == "pipeline")
+            pipeline = LLBC_Str2Int32(val.c_str());
+        else if (key == "server-pollers")
+            serverPollers = LLBC_Str2Int32(val.c_str());
+        else if (key == "client-pollers")
+            clientPollers = LLBC_Str2Int32(val.c_str());
+        else if (key == "fps")
+            fps = LLBC_Str2Int32(val.c_str());
+        else if (key == "busy-poll")
+            busyPoll = LLBC_Str2Int32(val.c_str());
+        else if (key == "warmup")
+            warmup = LLBC_Str2Int32(val.c_str());
+        else if (key == "duration")
+            duration = LLBC_Str2Int32(val.c_str());
+        else
+        {
+            LLBC_FilePrintLn(stderr, "Unknown argument: %s", arg.c_str());
+            return LLBC_FAILED;
+        }
+    }
+
+    return LLBC_OK;
+}
+
+int NetBenchCfg::Validate() const
+{
+    if ((mode != "echo" && mode != "broadcast") ||
+        (transport != "tcp" && transport != "local") ||
+        (role != "both" && role != "server" && role != "client") ||
+        (format != "text" && format != "json" && format != "csv"))
+        return LLBC_FAILED;
+
+    if (transport == "local" && role != "both")
+    {
+        LLBC_FilePrintLn(stderr, "Local transport only support role 'both'");
+        return LLBC_FAILED;
+    }
+
+    if (sessions <= 0 ||
+        payloadSize < static_cast<int>(sizeof(BenchHeader)) ||
+        pipeline <= 0 ||
+        serverPollers <= 0 || serverPollers > LLBC_CFG_COMM_MAX_POLLER_COUNT ||
+        clientPollers <= 0 || clientPollers > LLBC_CFG_COMM_MAX_POLLER_COUNT ||
+        fps < LLBC_CFG_COMM_MIN_SERVICE_FPS || fps > LLBC_CFG_COMM_MAX_SERVICE_FPS ||
+        busyPoll < 0 ||
+        warmup < 0 ||
+        duration <= 0)
+        return LLBC_FAILED;
+
+    return LLBC_OK;
+}
+
+LLBC_String NetBenchCfg::GetUsage(const char *progName)
+{
+    LLBC_String usage;
+    usage.format("Usage: %s [--key=value]...\n", progName);
+    usage.append_format("  --mode=echo|broadcast       bench mode, default echo\n");
+    usage.append_format("  --transport=tcp|local       tcp over loopback or in-process local session, default tcp\n");
+    usage.append_format("  --role=both|server|client   run server/client in same process or separately, default both\n");
+    usage.append_format("  --format=text|json|csv      report format, default text\n");
+    usage.append_format("  --ip=<ip> --port=<port>     server address, default 127.0.0.1:7900\n");
+    usage.append_format("  --sessions=<n>              client session count, default 8\n");
+    usage.append_format("  --payload=<bytes>           payload size, min %d, default 64\n", static_cast<int>(sizeof(BenchHeader)));
+    usage.append_format("  --pipeline=<n>              in-flight packets per session, default 1\n");
+    usage.append_format("  --server-pollers=<n>        server poller count, default 1\n");
+    usage.append_format("  --client-pollers=<n>        client poller count, default 1\n");
+    usage.append_format("  --fps=<n>                   service fps, default %d\n", LLBC_CFG_COMM_DFT_SERVICE_FPS);
+    usage.append_format("  --busy-poll=<us>            pollers busy poll window, default 0(disabled)\n");
+    usage.append_format("  --warmup=<seconds>          warmup time, default 1\n");
+    usage.append_format("  --duration=<seconds>        measure time, default 5");
+
+    return usage;
+}
+
+NetBenchResult::NetBenchResult()
+: sentMsgs(0)
+, recvMsgs(0)
+, recvBytes(0)
+, serverMsgs(0)
+, elapsed(0.0)
+, msgsPerSec(0.0)
+, mbPerSec(0.0)
+, latMin(0)
+, latAvg(0.0)
+, latP50(0)
+, latP90(0)
+, latP99(0)
+, latP999(0)
+, latMax(0)
+{
+}
+
+int RunNetBench(const NetBenchCfg &cfg, NetBenchResult &result)
+{
+    const bool runServer = cfg.role != "client";
+    const bool runClient = cfg.role != "server";
+
+    LLBC_Service *server = nullptr;
+    LLBC_Service *client = nullptr;
+    LLBC_Defer(delete client; delete server);
+
+    // Create and start server service.
+    ServerComp *serverComp = nullptr;
+    if (runServer)
+    {
+        server = LLBC_Service::Create("NetBenchServer");
+        serverComp = new ServerComp(cfg.mode == "broadcast");
+        server->AddComponent(serverComp);
+        server->Subscribe(BENCH_OPCODE, serverComp, &ServerComp::OnBenchData);
+        server->SuppressCoderNotFoundWarning();
+        server->SetFPS(cfg.fps);
+        server->SetPollerBusyPoll(cfg.busyPoll);
+        if (server->Start(cfg.serverPollers) != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Start server service failed, err: %s", LLBC_FormatLastError());
+            return LLBC_FAILED;
+        }
+
+        if (cfg.transport == "tcp" &&
+            server->Listen(cfg.ip.c_str(), cfg.port) == 0)
+        {
+            LLBC_FilePrintLn(stderr, "Listen on %s:%d failed, err: %s",
+                             cfg.ip.c_str(), cfg.port, LLBC_FormatLastError());
+            return LLBC_FAILED;
+        }
+    }
+
+    // Create and start client service, connect all sessions.
+    const sint64 measureBegin = LLBC_GetMicroSeconds() + cfg.warmup * 1000000ll;
+    const sint64 measureEnd = measureBegin + cfg.duration * 1000000ll;
+
+    ClientComp *clientComp = nullptr;
+    if (runClient)
+    {
+        client = LLBC_Service::Create("NetBenchClient");
+        clientComp = new ClientComp(cfg, measureBegin, measureEnd);
+        client->AddComponent(clientComp);
+        client->Subscribe(BENCH_OPCODE, clientComp, &ClientComp::OnBenchData);
+        client->SuppressCoderNotFoundWarning();
+        client->SetFPS(cfg.fps);
+        client->SetPollerBusyPoll(cfg.busyPoll);
+        if (client->Start(cfg.clientPollers) != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Start client service failed, err: %s", LLBC_FormatLastError());
+            return LLBC_FAILED;
+        }
+
+        for (int i = 0; i < cfg.sessions; ++i)
+        {
+            const int sessionId = cfg.transport == "tcp" ?
+                client->AsyncConn(cfg.ip.c_str(), cfg.port) : client->ConnectLocal(server);
+            if (sessionId == 0)
+            {
+                LLBC_FilePrintLn(stderr, "Connect to server failed, err: %s", LLBC_FormatLastError());
+                return LLBC_FAILED;
+            }
+        }
+    }
+
+    // Wait measure finished, leave a little time to drain in-flight packets.
+    while (LLBC_GetMicroSeconds() < measureEnd)
+        LLBC_Sleep(100);
+    LLBC_Sleep(200);
+
+    // Stop services, after stopped, all components data can be safely access.
+    if (client)
+        client->Stop();
+    if (server)
+        server->Stop();
+
+    if (serverComp)
+        result.serverMsgs = serverComp->GetHandledMsgs();
+    if (clientComp)
+        clientComp->FillResult(result);
+
+    result.elapsed = cfg.duration;
+    result.msgsPerSec = result.recvMsgs / result.elapsed;
+    result.mbPerSec = result.recvBytes / result.elapsed / (1024.0 * 1024.0);
+
+    return LLBC_OK;
+}
+
+LLBC_String FormatNetBenchResult(const NetBenchCfg &cfg, const NetBenchResult &result)
+{
+    LLBC_String report;
+    const LLBC_String version = LLBC_String().format("%d.%d.%d", LLBC_majorVersion, LLBC_minorVersion, LLBC_updateNo);
+    if (cfg.format == "json")
+    {
+        report.format("{\"version\":\"%s\",\"mode\":\"%s\",\"transport\":\"%s\",\"role\":\"%s\","
+                      "\"sessions\":%d,\"payload\":%d,\"pipeline\":%d,\"server_pollers\":%d,\"client_pollers\":%d,"
+                      "\"fps\":%d,\"busy_poll\":%d,"
+                      "\"duration\":%.3f,\"sent_msgs\":%lld,\"recv_msgs\":%lld,\"recv_bytes\":%lld,\"server_msgs\":%lld,"
+                      "\"msgs_per_sec\":%.2f,\"mb_per_sec\":%.3f,"
+                      "\"latency_us\":{\"min\":%lld,\"avg\":%.2f,\"p50\":%lld,\"p90\":%lld,\"p99\":%lld,\"p999\":%lld,\"max\":%lld}}",
+                      version.c_str(), cfg.mode.c_str(), cfg.transport.c_str(), cfg.role.c_str(),
+                      cfg.sessions, cfg.payloadSize, cfg.pipeline, cfg.serverPollers, cfg.clientPollers,
+                      cfg.fps, cfg.busyPoll,
+                      result.elapsed, result.sentMsgs, result.recvMsgs, result.recvBytes, result.serverMsgs,
+                      result.msgsPerSec, result.mbPerSec,
+                      result.latMin, result.latAvg, result.latP50, result.latP90, result.latP99, result.latP999, result.latMax);
+    }
+    else if (cfg.format == "csv")
+    {
+        report.format("version,mode,transport,role,sessions,payload,pipeline,server_pollers,client_pollers,fps,busy_poll,"
+                      "duration,sent_msgs,recv_msgs,recv_bytes,server_msgs,msgs_per_sec,mb_per_sec,"
+                      "lat_min_us,lat_avg_us,lat_p50_us,lat_p90_us,lat_p99_us,lat_p999_us,lat_max_us\n");
+        report.append_format("%s,%s,%s,%s,%d,%d,%d,%d,%d,%d,%d,%.3f,%lld,%lld,%lld,%lld,%.2f,%.3f,%lld,%.2f,%lld,%lld,%lld,%lld,%lld",
+                             version.c_str(), cfg.mode.c_str(), cfg.transport.c_str(), cfg.role.c_str(),
+                             cfg.sessions, cfg.payloadSize, cfg.pipeline, cfg.serverPollers, cfg.clientPollers,
+                             cfg.fps, cfg.busyPoll,
+                             result.elapsed, result.sentMsgs, result.recvMsgs, result.recvBytes, result.serverMsgs,
+                             result.msgsPerSec, result.mbPerSec,
+                             result.latMin, result.latAvg, result.latP50, result.latP90, result.latP99, result.latP999, result.latMax);
+    }
+    else
+    {
+        report.format("NetBench report(llbc %s):\n", version.c_str());
+        report.append_format("  mode: %s, transport: %s, role: %s\n", cfg.mode.c_str(), cfg.transport.c_str(), cfg.role.c_str());
+        report.append_format("  sessions: %d, payload: %d bytes, pipeline: %d, pollers(server/client): %d/%d, fps: %d, busy poll: %dus\n",
+                             cfg.sessions, cfg.payloadSize, cfg.pipeline, cfg.serverPollers, cfg.clientPollers, cfg.fps, cfg.busyPoll);
+        report.append_format("  duration: %.3fs, sent: %lld, recv: %lld, server handled: %lld\n",
+                             result.elapsed, result.sentMsgs, result.recvMsgs, result.serverMsgs);
+        report.append_format("  throughput: %.2f msgs/s, %.3f MB/s\n", result.msgsPerSec, result.mbPerSec);
+        report.append_format("  latency(us): min %lld, avg %.2f, p50 %lld, p90 %lld, p99 %lld, p99.9 %lld, max %lld",
+                             result.latMin, result.latAvg, result.latP50, result.latP90, result.latP99, result.latP999, result.latMax);
+    }
+
+    return report;
+}
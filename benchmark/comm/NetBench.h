@@ -0,0 +1,111 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc.h"
+using namespace llbc;
+
+/**
+ * \brief The network benchmark config.
+ */
+struct NetBenchCfg
+{
+    LLBC_String mode;       // bench mode: echo/broadcast.
+    LLBC_String transport;  // transport: tcp/local(in-process local session, role must be both).
+    LLBC_String role;       // role: both/server/client.
+    LLBC_String format;     // report format: text/json/csv.
+
+    LLBC_String ip;         // server listen/connect ip.
+    uint16 port;            // server listen/connect port.
+
+    int sessions;           // client session count.
+    int payloadSize;        // packet payload size, in bytes.
+    int pipeline;           // in-flight packets per client session.
+    int serverPollers;      // server service poller count.
+    int clientPollers;      // client service poller count.
+    int fps;                // server/client service FPS.
+    int busyPoll;           // server/client pollers busy poll window, in micro-seconds, 0 means disable.
+
+    int warmup;             // warmup time, in seconds, not included in report.
+    int duration;           // measure time, in seconds.
+
+    NetBenchCfg();
+
+    /**
+     * Parse config from command line arguments(--key=value).
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Parse(int argc, char *argv[]);
+
+    /**
+     * Validate config.
+     * @return int - return 0 if valid, otherwise return -1.
+     */
+    int Validate() const;
+
+    /**
+     * Get usage info.
+     */
+    static LLBC_String GetUsage(const char *progName);
+};
+
+/**
+ * \brief The network benchmark result.
+ */
+struct NetBenchResult
+{
+    sint64 sentMsgs;        // client sent message count(in measure window).
+    sint64 recvMsgs;        // client received message count(in measure window).
+    sint64 recvBytes;       // client received payload bytes(in measure window).
+    sint64 serverMsgs;      // server handled message count(whole run).
+    double elapsed;         // measure window, in seconds.
+
+    double msgsPerSec;      // received messages per second.
+    double mbPerSec;        // received payload MB(1024*1024 bytes) per second.
+
+    sint64 latMin;          // latency statistics, in micro-seconds.
+    double latAvg;
+    sint64 latP50;
+    sint64 latP90;
+    sint64 latP99;
+    sint64 latP999;
+    sint64 latMax;
+
+    NetBenchResult();
+};
+
+/**
+ * Run network benchmark.
+ * @param[in] cfg     - the benchmark config.
+ * @param[out] result - the benchmark result.
+ * @return int - return 0 if success, otherwise return -1.
+ */
+int RunNetBench(const NetBenchCfg &cfg, NetBenchResult &result);
+
+/**
+ * Format benchmark result as report, according to cfg.format.
+ * @param[in] cfg    - the benchmark config.
+ * @param[in] result - the benchmark result.
+ * @return LLBC_String - the report string.
+ */
+LLBC_String FormatNetBenchResult(const NetBenchCfg &cfg, const NetBenchResult &result);
@@ -23,6 +23,8 @@
 
 #include "llbc/comm/PollerEvent.h"
 #include "llbc/comm/AsyncConnInfo.h"
+#include "llbc/comm/QueueStats.h"
+#include "llbc/comm/IdleWheel.h"
 
 __LLBC_NS_BEGIN
 
@@ -90,6 +92,54 @@ public:
      */
     void SetPollerMgr(LLBC_PollerMgr *mgr);
 
+    /**
+     * Get poller traffic bytes per second(sent + received), update every LLBC_CFG_COMM_POLLER_BALANCE_INTERVAL.
+     * @return sint64 - the bytes per second.
+     */
+    sint64 GetBytesPerSec() const;
+
+    /**
+     * Drain poller, all sessions will be migrated to other alive pollers(use to remove poller).
+     */
+    void Drain();
+
+    /**
+     * Check poller is drained or not, drained poller has no sessions and could be stopped safety.
+     * @return bool - return true if drained, otherwise return false.
+     */
+    bool IsDrained() const;
+
+    /**
+     * Get/Set poller busy poll window, in micro-seconds.
+     * In busy poll mode, poller thread(and epoll monitor thread) will spin on queued events(and non-blocking epoll)
+     * for busy poll window before fall back to blocking wait, and connected sockets will set SO_BUSY_POLL option.
+     * @param[in] busyPollWindow - the busy poll window, in micro-seconds, 0 means disable busy poll mode.
+     */
+    int GetBusyPollWindow() const;
+    void SetBusyPollWindow(int busyPollWindow);
+
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    /**
+     * Push message block to poller, stamp event enqueue time if queue statistics enabled.
+     * @param[in] block - the poller event block.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Push(LLBC_MessageBlock *block);
+
+    /**
+     * Enable/Disable poller queue statistics.
+     * @param[in] enabled - the enable flag.
+     */
+    void SetQueueStatsEnabled(bool enabled);
+
+    /**
+     * Get/Reset poller queue statistics(thread safe).
+     * @param[out] stat - the queue statistics.
+     */
+    void GetQueueStat(LLBC_QueueStat &stat) const;
+    void ResetQueueStat();
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 public:
     /**
      * Startup poller to work.
@@ -119,6 +169,8 @@ protected:
     virtual void HandleEv_Monitor(LLBC_PollerEvent &ev);
     virtual void HandleEv_TakeOverSession(LLBC_PollerEvent &ev);
     virtual void HandleEv_CtrlProtocolStack(LLBC_PollerEvent &ev);
+    virtual void HandleEv_MigrateSession(LLBC_PollerEvent &ev);
+    virtual void HandleEv_SendFile(LLBC_PollerEvent &ev);
 
     /**
      * Create new session from socket.
@@ -149,6 +201,92 @@ protected:
      */
     virtual void RemoveSession(LLBC_Session *session);
 
+    /**
+     * Detach session from poller, session will not be deleted(use to migrate session).
+     */
+    virtual void DetachSession(LLBC_Session *session);
+
+protected:
+    /**
+     * Check given session can migrate to other poller or not.
+     * Note: Listen session, datagram peer session(shared handle) and pinned session could not migrate.
+     * @param[in] session - the session.
+     * @return bool - return true if can migrate, otherwise return false.
+     */
+    virtual bool IsMigratable(LLBC_Session *session) const;
+
+    /**
+     * Migrate session to other poller.
+     * @param[in] session    - the session.
+     * @param[in] toPollerId - the target poller Id.
+     */
+    void MigrateSession(LLBC_Session *session, int toPollerId);
+
+    /**
+     * Forward migrated session's event to new poller.
+     * @param[in] ev    - the poller event.
+     * @param[in] block - the event block.
+     * @return bool - return true if forwarded(block stolen), otherwise return false.
+     */
+    bool ForwardMigratedEv(LLBC_PollerEvent &ev, LLBC_MessageBlock *block);
+
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    /**
+     * Stat dequeued event, call when queue statistics enabled.
+     * @param[in] ev     - the poller event.
+     * @param[in] wakeup - the event is the first popped event in this wakeup or not.
+     */
+    void StatDequeuedEv(const LLBC_PollerEvent &ev, bool wakeup);
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+    /**
+     * Update poller load statistic info, and auto balance sessions if need.
+     */
+    void UpdateLoadStats();
+
+    /**
+     * Migrate idle sessions to least loaded poller, if poller sessions not balanced.
+     * @param[in] now - the now time, in milli-seconds.
+     */
+    void BalanceSessions(sint64 now);
+
+    /**
+     * Migrate all sessions to alive pollers, call when poller draining.
+     */
+    void DrainSessions();
+
+    /**
+     * Schedule session idle check, if session enabled read idle timeout or auto heartbeat.
+     * @param[in] session - the session.
+     * @param[in] now     - the now time, in milli-seconds.
+     */
+    void ScheduleIdleCheck(LLBC_Session *session, sint64 now);
+
+    /**
+     * Check expired idle sessions, close read idle sessions & send heartbeat to write idle sessions.
+     */
+    void UpdateIdleSessions();
+
+    /**
+     * Add traffic bytes, call by session.
+     * @param[in] bytes - the sent/received bytes.
+     */
+    void AddTrafficBytes(size_t bytes);
+
+    /**
+     * Session recv budget exhausted handler, call by session.
+     * Note: Level-triggered pollers will be notified by OS again, so default do nothing.
+     * @param[in] session - the session.
+     */
+    virtual void OnRecvBudgetExhausted(LLBC_Session *session);
+
+    /**
+     * Flush session pending send data, call when data appended to session outside of send event(eg: heartbeat).
+     * Note: Default force call session OnSend() one time in Non-Win32 platform, session maybe removed in it.
+     * @param[in] session - the session.
+     */
+    virtual void FlushSend(LLBC_Session *session);
+
 protected:
     /**
      * Set connected socket options.
@@ -157,12 +295,32 @@ protected:
      */
     void SetConnectedSocketOpts(LLBC_Socket *sock, const LLBC_SessionOpts &sessionOpts);
 
+    /**
+     * Spin wait queued events in busy poll window.
+     * @return bool - return true if has queued events, otherwise return false(busy poll window timeout).
+     */
+    bool BusyWaitQueuedEvents();
+
+    /**
+     * Check service overload protection paused sessions reading or not.
+     * @return bool - return true if read paused, otherwise return false.
+     */
+    bool IsReadPaused() const;
+
+    /**
+     * Check service overload protection rejected new accepted sessions or not.
+     * @return bool - return true if accept rejected, otherwise return false.
+     */
+    bool IsAcceptRejected() const;
+
 private:
     /**
      * Decleare friend class: LLBC_Session.
      * Access method list:
      *      AddSession(LLBC_Session *)
      *      RemoveSession(LLBC_Session *)
+     *      AddTrafficBytes(size_t)
+     *      OnRecvBudgetExhausted(LLBC_Session *)
      */
     friend class LLBC_Session;
 
@@ -183,6 +341,28 @@ protected:
     typedef std::map<LLBC_SocketHandle, LLBC_AsyncConnInfo> _Connecting;
     _Connecting _connecting;
 
+    volatile bool _draining;
+    volatile bool _drained;
+
+    volatile sint64 _bytesPerSec;
+    sint64 _statBytes;
+    sint64 _statBeginTime;
+
+    // Migrated sessions, sessionId -> <new poller Id, migrate time>.
+    typedef std::map<int, std::pair<int, sint64> > _MigratedSessions;
+    _MigratedSessions _migratedSessions;
+
+    volatile int _busyPollWindow;
+
+    LLBC_IdleWheel _idleWheel;
+    std::vector<LLBC_IdleWheel::Entry> _expiredIdles;
+
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    volatile bool _queueStatsEnabled;
+    LLBC_QueueStat _queueStat;
+    mutable LLBC_SpinLock _queueStatLock;
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 protected:
     typedef LLBC_PollerEvent _Ev;
     typedef void (LLBC_BasePoller::*_Handler)(_Ev &);
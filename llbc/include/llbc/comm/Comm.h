@@ -26,7 +26,15 @@
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/Coder.h"
 #include "llbc/comm/Component.h"
+#include "llbc/comm/OpcodeStats.h"
+#include "llbc/comm/FrameProfile.h"
+#include "llbc/comm/QueueStats.h"
 #include "llbc/comm/PollerType.h"
+#include "llbc/comm/PollerPlacePolicy.h"
+#include "llbc/comm/PacketPriority.h"
+#include "llbc/comm/OverloadPolicy.h"
+#include "llbc/comm/Rpc.h"
+#include "llbc/comm/PacketCapture.h"
 #include "llbc/comm/BasePoller.h"
 #include "llbc/comm/Service.h"
 #include "llbc/comm/ServiceMgr.h"
@@ -36,8 +44,12 @@
 #include "llbc/comm/protocol/ProtoReportLevel.h"
 #include "llbc/comm/protocol/RawProtocolFactory.h"
 #include "llbc/comm/protocol/NormalProtocolFactory.h"
+#include "llbc/comm/protocol/DatagramProtocolFactory.h"
+#include "llbc/comm/protocol/CompactProtocolFactory.h"
 #include "llbc/comm/protocol/RawProtocol.h"
 #include "llbc/comm/protocol/PacketProtocol.h"
+#include "llbc/comm/protocol/DatagramProtocol.h"
+#include "llbc/comm/protocol/CompactPacketProtocol.h"
 #include "llbc/comm/protocol/CompressProtocol.h"
 #include "llbc/comm/protocol/CodecProtocol.h"
 #include "llbc/comm/protocol/ProtocolStack.h"
@@ -0,0 +1,132 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous declare LLBC_Packet class.
+ */
+class LLBC_Packet;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The compact packet header assembler encapsulation.
+ *
+ * Compact header format, all integer fields use unsigned varint(LEB128) encoding,
+ * and the zero value fields will be omitted(use field mask to indicate).
+ *   |       Type       |     Len    |
+ * --|------------------|------------|--
+ *   |    Field Mask    |      1     |
+ *   |  Payload Length  |    1 - 5   |
+ *   |      Opcode      | 0, 1 - 5   |
+ *   |      Status      | 0, 1 - 3   |
+ *   | Sender ServiceId | 0, 1 - 5   |
+ *   | Recver ServiceId | 0, 1 - 5   |
+ *   |      Flags       | 0, 1 - 3   |
+ *   |     ExtData1     | 0, 1 - 10  |
+ *Header total length: 2 - 37 bytes.
+ */
+class LLBC_EXPORT LLBC_CompactPacketHeaderAssembler
+{
+public:
+    /**
+     * The header field mask bits.
+     */
+    enum FieldMask
+    {
+        OpcodeField = 0x01,
+        StatusField = 0x02,
+        SenderServiceIdField = 0x04,
+        RecverServiceIdField = 0x08,
+        FlagsField = 0x10,
+        ExtData1Field = 0x20,
+
+        AllFields = 0x3f
+    };
+
+    /**
+     * The max header length.
+     */
+    static const size_t MaxHeaderLen = 37;
+
+public:
+    /**
+     * Constructor & Destructor.
+     */
+    LLBC_CompactPacketHeaderAssembler();
+    virtual ~LLBC_CompactPacketHeaderAssembler();
+
+public:
+    /**
+     * Assemble packet header.
+     * Note: If the header malformed, will return true too, and SetToPacket() will return false.
+     * @param[in] data  - the stream data.
+     * @param[in] len   - the stream data length, in bytes.
+     * @param[out] used - the used stream data, in bytes.
+     * @return bool - return true if header assembled, otherwise return false.
+     */
+    bool Assemble(const void *data, size_t len, size_t &used);
+
+    /**
+     * Reset the header assembler.
+     */
+    void Reset();
+
+    /**
+     * Get the assembled header length.
+     * @return size_t - the header length, in bytes.
+     */
+    size_t GetHeaderLen() const;
+
+public:
+    /**
+     * Set header content to packet, the packet length will be set to header length + payload length.
+     * @param[in] packet - the packet.
+     * @return bool - return true if success, otherwise return false(header malformed).
+     */
+    bool SetToPacket(LLBC_Packet &packet) const;
+
+    /**
+     * Build packet compact header.
+     * @param[in] packet  - the packet.
+     * @param[out] header - the header buffer, buffer size must be greater than or equal to MaxHeaderLen.
+     * @return size_t - the header length, in bytes.
+     */
+    static size_t BuildHeader(const LLBC_Packet &packet, char *header);
+
+private:
+    char _header[MaxHeaderLen];
+    size_t _curRecved;
+
+    int _needVarints;
+    int _recvedVarints;
+    bool _assembled;
+};
+
+__LLBC_NS_END
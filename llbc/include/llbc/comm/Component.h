@@ -22,6 +22,7 @@
 #pragma once
 
 #include "llbc/comm/ComponentEvents.h"
+#include "llbc/comm/OverloadPolicy.h"
 
 __LLBC_NS_BEGIN
 
@@ -601,6 +602,12 @@ public:
      */
     virtual void OnUnHandledPacket(const LLBC_Packet &packet);
 
+    /**
+     * When service enter/leave overload state, will call this event handler.
+     * @param[in] info - the overload state transition info.
+     */
+    virtual void OnOverloadChanged(const LLBC_OverloadInfo &info);
+
 private:
     /**
      * Friend class: LLBC_ServiceImpl.
@@ -51,6 +51,7 @@ public:
         OnAsyncConnResult,
         OnProtoReport,
         OnUnHandledPacket,
+        OnOverloadChanged,
 
         OnAppEarlyStart,
         OnAppStartFail,
@@ -87,6 +88,7 @@ public:
     static constexpr uint64 OnAsyncConnResult = 1 << LLBC_ComponentEventIndex::OnAsyncConnResult;
     static constexpr uint64 OnProtoReport = 1 << LLBC_ComponentEventIndex::OnProtoReport;
     static constexpr uint64 OnUnHandledPacket = 1 << LLBC_ComponentEventIndex::OnUnHandledPacket;
+    static constexpr uint64 OnOverloadChanged = 1 << LLBC_ComponentEventIndex::OnOverloadChanged;
 
     static constexpr uint64 OnAppWillStart = 1 << LLBC_ComponentEventIndex::OnAppEarlyStart;
     static constexpr uint64 OnAppStartFail = 1 << LLBC_ComponentEventIndex::OnAppStartFail;
@@ -272,6 +272,10 @@ inline void LLBC_Component::OnUnHandledPacket(const LLBC_Packet &packet)
 {
 }
 
+inline void LLBC_Component::OnOverloadChanged(const LLBC_OverloadInfo &info)
+{
+}
+
 inline void LLBC_Component::SetService(LLBC_Service *svc)
 {
     _svc = svc;
@@ -84,6 +84,16 @@ protected:
      */
     virtual void RemoveSession(LLBC_Session *session);
 
+    /**
+     * Detach session from poller.
+     */
+    virtual void DetachSession(LLBC_Session *session);
+
+    /**
+     * Session recv budget exhausted handler, add session to recv ready list.
+     */
+    virtual void OnRecvBudgetExhausted(LLBC_Session *session);
+
 private:
     /**
      * Startup monitor.
@@ -110,10 +120,44 @@ private:
      */
     void Accept(LLBC_Session *session);
 
+    /**
+     * Receive datagrams from datagram listen session, and dispatch them to peer sessions.
+     */
+    void RecvDatagrams(LLBC_Session *session);
+
+    /**
+     * Get datagram peer session, if not found, create it.
+     */
+    LLBC_Session *GetDatagramPeer(LLBC_Session *session, const LLBC_SockAddr_IN &peerAddr);
+
+    /**
+     * Flush all datagram peer sessions will send datagrams.
+     */
+    void FlushDatagramPeers(LLBC_Session *session);
+
+    /**
+     * Close all datagram peer sessions.
+     */
+    void CloseDatagramPeers(LLBC_Session *session);
+
+    /**
+     * Read all recv ready sessions(recv budget exhausted in last loop, or readable while read paused) again.
+     */
+    void HandleRecvReadySessions();
+
 private:
     LLBC_Handle _epoll;
     LLBC_PollerMonitor *_monitor;
 
+    typedef std::map<uint64, LLBC_Session *> _DatagramPeers;
+    std::map<int, _DatagramPeers> _datagramPeers;
+
+    // Edge-triggered mode will not notify again, the recv budget exhausted sessions must read by self.
+    std::vector<int> _recvReadySessions;
+    std::vector<int> _handlingRecvReadySessions;
+    // Read paused(service overloaded) but readable sessions, read them again when read resumed.
+    std::set<int> _readPausedSessions;
+
     LLBC_EpollEvent _events[LLBC_CFG_COMM_MAX_EVENT_COUNT];
 };
 
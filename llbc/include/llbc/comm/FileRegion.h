@@ -0,0 +1,50 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous-declare Packet class.
+ */
+class LLBC_Packet;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The file region send request structure encapsulation.
+ *        The file region will be received by peer as the header packet payload.
+ */
+struct LLBC_HIDDEN LLBC_FileRegion
+{
+    LLBC_Packet *header; // The header packet(no payload).
+    int fd;              // The file descriptor, owned by file region.
+    sint64 offset;       // The file region offset.
+    size_t length;       // The file region length.
+};
+
+__LLBC_NS_END
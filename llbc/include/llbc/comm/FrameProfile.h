@@ -0,0 +1,121 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/comm/OpcodeStats.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The service frame phase enumeration.
+ */
+class LLBC_EXPORT LLBC_FramePhase
+{
+public:
+    enum
+    {
+        Begin,
+
+        FrameTasks = Begin,  // Handle frame tasks(include begin & end frame tasks).
+        QueuedEvents,        // Handle queued events(packets, session events, ...).
+        UpdateComps,         // Update components.
+        UpdateTimers,        // Update timer scheduler.
+        UpdateReleasePool,   // Update auto release pool and statistics dump.
+
+        End
+    };
+
+    /**
+     * Get frame phase string representation.
+     * @param[in] phase - the frame phase.
+     * @return const LLBC_String & - the phase string representation.
+     */
+    static const LLBC_String &Phase2Str(int phase);
+};
+
+/**
+ * \brief The slow frame info class encapsulation, all time values in nano-seconds.
+ */
+class LLBC_EXPORT LLBC_SlowFrameInfo
+{
+public:
+    LLBC_SlowFrameInfo();
+
+public:
+    /**
+     * Reset slow frame info.
+     */
+    void Reset();
+
+    /**
+     * Get slow frame info string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+public:
+    sint64 frameTime; // frame cost time(not include idle process & sleep time).
+    sint64 budget; // frame budget.
+    sint64 phaseTimes[LLBC_FramePhase::End]; // every phase cost time.
+
+    LLBC_String slowestComp; // the slowest OnUpdate() component name, empty if no component updated.
+    sint64 slowestCompTime; // the slowest OnUpdate() component cost time.
+
+    LLBC_TimerId slowestTimerId; // the slowest timeout timer Id, 0 if no timer timeout.
+    sint64 slowestTimerTime; // the slowest timeout timer cost time.
+
+    int slowestOpcode; // the slowest handled opcode, -1 if no packet handled.
+    sint64 slowestOpcodeTime; // the slowest handled opcode cost time.
+};
+
+/**
+ * \brief The service frame profile class encapsulation.
+ */
+class LLBC_EXPORT LLBC_FrameProfile
+{
+public:
+    LLBC_FrameProfile();
+
+public:
+    /**
+     * Reset frame profile.
+     */
+    void Reset();
+
+    /**
+     * Get frame profile string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+public:
+    sint64 beginTime; // profile window begin time, in milli-seconds.
+    uint64 frameCount; // profiled frames count.
+    uint64 overrunCount; // frame budget overrun frames count.
+
+    LLBC_LatencyHistogram frameTime; // frame cost time.
+    LLBC_LatencyHistogram phaseTimes[LLBC_FramePhase::End]; // every phase cost time.
+    std::map<LLBC_String, LLBC_LatencyHistogram> compUpdateTimes; // every component OnUpdate() cost time.
+};
+
+__LLBC_NS_END
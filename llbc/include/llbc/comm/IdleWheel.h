@@ -0,0 +1,91 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The idle session timing wheel, use to detect poller idle sessions.
+ *        Session entry keyed by check deadline, session activity only update session last recv/send time,
+ *        not touch the wheel(O(1) per packet), the not expired entry will be re-added when it's slot expired,
+ *        so every tick cost O(expired).
+ * Note: Not thread safe, owned by poller.
+ */
+class LLBC_HIDDEN LLBC_IdleWheel
+{
+public:
+    /**
+     * The wheel entry.
+     */
+    struct Entry
+    {
+        int sessionId;
+        sint64 deadline;
+    };
+
+public:
+    /**
+     * Construct idle wheel.
+     * @param[in] tickInterval - the tick interval, in milli-seconds.
+     * @param[in] slotCount    - the slots count.
+     */
+    explicit LLBC_IdleWheel(int tickInterval = LLBC_CFG_COMM_POLLER_IDLE_WHEEL_TICK,
+                            size_t slotCount = LLBC_CFG_COMM_POLLER_IDLE_WHEEL_SLOTS);
+
+public:
+    /**
+     * Get entries count.
+     * @return size_t - the entries count.
+     */
+    size_t GetSize() const;
+
+    /**
+     * Add session entry.
+     * @param[in] sessionId - the session Id.
+     * @param[in] deadline  - the check deadline, in milli-seconds.
+     */
+    void Add(int sessionId, sint64 deadline);
+
+    /**
+     * Advance wheel to given time, collect expired entries.
+     * @param[in] now      - the now time, in milli-seconds.
+     * @param[out] expired - the expired entries(appended).
+     */
+    void Tick(sint64 now, std::vector<Entry> &expired);
+
+    /**
+     * Clear all entries.
+     */
+    void Clear();
+
+private:
+    int _tickInterval;
+    sint64 _curTick;
+    size_t _size;
+    std::vector<std::vector<Entry> > _slots;
+    std::vector<Entry> _tickingSlot;
+};
+
+__LLBC_NS_END
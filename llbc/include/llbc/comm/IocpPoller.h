@@ -83,6 +83,11 @@ protected:
      */
     virtual void RemoveSession(LLBC_Session *session);
 
+    /**
+     * Iocp session bound to completion port, could not migrate.
+     */
+    virtual bool IsMigratable(LLBC_Session *session) const;
+
 private:
     /**
      * Startup monitor.
@@ -0,0 +1,66 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/comm/PollPoller.h"
+
+#if LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The kqueue poller class encapsulation.
+ *        Kqueue poller reuse poll poller's session/connecting/wakeup logic, only replace the fd demultiplexer,
+ *        fd interests are registered to kqueue persistently(level-triggered), no per-wait fd array scan.
+ */
+class LLBC_HIDDEN LLBC_KqueuePoller : public LLBC_PollPoller
+{
+public:
+    LLBC_KqueuePoller();
+    virtual ~LLBC_KqueuePoller();
+
+protected:
+    /**
+     * Fd demultiplex methods.
+     */
+    virtual int InitDemux();
+    virtual void DestroyDemux();
+    virtual void AddFd(LLBC_SocketHandle handle, int interest);
+    virtual void RemoveFd(LLBC_SocketHandle handle);
+    virtual void ModifyFd(LLBC_SocketHandle handle, int interest);
+    virtual void WaitFds(int timeout, _FdEvents &fdEvents);
+
+private:
+    /**
+     * Apply read/write filters change to kqueue.
+     */
+    void ApplyFilters(LLBC_SocketHandle handle, int interest, bool add);
+
+private:
+    int _kqueue;
+    std::vector<struct kevent> _kevents;
+};
+
+__LLBC_NS_END
+
+#endif // LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
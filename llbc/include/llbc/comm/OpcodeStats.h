@@ -0,0 +1,139 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The latency histogram class encapsulation.
+ *        HDR-styled log-linear buckets, relative error not greater than 1/8, value unit is nano-second.
+ */
+class LLBC_EXPORT LLBC_LatencyHistogram
+{
+public:
+    LLBC_LatencyHistogram();
+
+public:
+    /**
+     * Record value.
+     * @param[in] value - the value, in nano-seconds, negative value will be treated as 0.
+     */
+    void Record(sint64 value);
+
+    /**
+     * Reset histogram.
+     */
+    void Reset();
+
+public:
+    /**
+     * Get recorded value count.
+     * @return uint64 - the value count.
+     */
+    uint64 GetCount() const;
+
+    /**
+     * Get min/max/mean value.
+     * @return sint64/double - the min/max/mean value, if no value recorded, return 0.
+     */
+    sint64 GetMin() const;
+    sint64 GetMax() const;
+    double GetMean() const;
+
+    /**
+     * Get value at given percentile.
+     * @param[in] percentile - the percentile, in range [0.0, 100.0].
+     * @return sint64 - the value(bucket highest equivalent value), if no value recorded, return 0.
+     */
+    sint64 GetValueAtPercentile(double percentile) const;
+
+    /**
+     * Get histogram string representation(time value in micro-seconds).
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+private:
+    /**
+     * Get bucket index of given value.
+     */
+    static int GetBucketIdx(uint64 value);
+
+    /**
+     * Get bucket highest equivalent value.
+     */
+    static uint64 GetBucketHighValue(int bucketIdx);
+
+private:
+    /**
+     * Bucket layout: values less than 16 have exact buckets, others split to
+     * power-of-2 magnitudes, every magnitude has 8 linear sub-buckets.
+     */
+    enum
+    {
+        SubBucketBits = 3,
+        SubBucketCount = 1 << SubBucketBits,
+        ExactBucketCount = SubBucketCount * 2,
+        MaxValueBits = 40, // Max trackable value is 2^40 ns(about 18 minutes), greater value clamped.
+        BucketCount = ExactBucketCount + (MaxValueBits - SubBucketBits - 1) * SubBucketCount
+    };
+
+    uint64 _count;
+    sint64 _min;
+    sint64 _max;
+    double _sum;
+    uint64 _buckets[BucketCount];
+};
+
+/**
+ * \brief The opcode statistics class encapsulation.
+ */
+class LLBC_EXPORT LLBC_OpcodeStat
+{
+public:
+    LLBC_OpcodeStat();
+
+public:
+    /**
+     * Reset statistics.
+     */
+    void Reset();
+
+    /**
+     * Get opcode statistics string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+public:
+    uint64 recvCount; // received packets count.
+    uint64 recvBytes; // received payload bytes.
+    uint64 sendCount; // sent packets count.
+    uint64 sendBytes; // sent payload bytes(encoded).
+
+    LLBC_LatencyHistogram decodeTime; // packet decode time in service(non full-stack service only).
+    LLBC_LatencyHistogram handleTime; // packet pre-handle & handle time.
+};
+
+__LLBC_NS_END
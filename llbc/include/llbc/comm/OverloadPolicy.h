@@ -0,0 +1,97 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The service overload policy flags, determine what service does while it is overloaded.
+ * Note:
+ *      - Service enter overload state when queued events count or queueing delay reach threshold,
+ *        and leave overload state when queue drained, see LLBC_Service::SetOverloadProtection().
+ *      - PauseRead/RejectAccept policies not supported by Iocp poller.
+ */
+class LLBC_EXPORT LLBC_OverloadPolicy
+{
+public:
+    enum
+    {
+        None = 0x00,
+
+        PauseRead = 0x01,       // Pause reading sessions on pollers, tcp flow control push back to peers.
+        ShedLowPriority = 0x02, // Discard low priority packets(see LLBC_PacketPriority::Low).
+        RejectAccept = 0x04,    // Close new accepted sessions immediately.
+
+        All = PauseRead | ShedLowPriority | RejectAccept
+    };
+
+public:
+    /**
+     * Check given overload policy flags is validate or not.
+     * @param[in] policy - the overload policy flags.
+     * @return bool - return true if validate, otherwise return false.
+     */
+    static bool IsValid(int policy);
+
+    /**
+     * Get overload policy flags string representation, eg: "PauseRead|RejectAccept".
+     * @param[in] policy - the overload policy flags.
+     * @return LLBC_String - the overload policy flags string representation.
+     */
+    static LLBC_String Policy2Str(int policy);
+
+    /**
+     * Get overload policy flags from string representation(flags separated by '|', case insensitive).
+     * @param[in] policyStr - the overload policy flags string representation.
+     * @return int - the overload policy flags, if error occurred, return -1.
+     */
+    static int Str2Policy(const LLBC_String &policyStr);
+};
+
+/**
+ * \brief The service overload state transition info class encapsulation.
+ */
+class LLBC_EXPORT LLBC_OverloadInfo
+{
+public:
+    LLBC_OverloadInfo();
+
+public:
+    /**
+     * Get overload info string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+public:
+    bool overloaded; // enter overload state or not(leave overload state).
+    int policy; // the overload policy flags.
+    size_t queueDepth; // the queued events count when state transition.
+    sint64 queueDelay; // the events queueing delay when state transition, in milli-seconds.
+    sint64 overloadTime; // overload duration, in milli-seconds, only available when leave overload state.
+    uint64 shedPacketCount; // shed packets count while overloaded, only available when leave overload state.
+};
+
+__LLBC_NS_END
@@ -29,6 +29,8 @@
 __LLBC_NS_BEGIN
 class LLBC_Coder;
 class LLBC_Session;
+class LLBC_SessionInfo;
+class LLBC_ServiceImpl;
 __LLBC_NS_END
 
 __LLBC_NS_BEGIN
@@ -101,6 +103,8 @@ public:
 
     /**
      * Get local address.
+     * Note: The received packet's address resolve from session info lazily,
+     *       only available before packet handled.
      * @return const LLBC_SockAddr_IN & - the local address.
      */
     const LLBC_SockAddr_IN &GetLocalAddr() const;
@@ -166,6 +170,8 @@ public:
     int GetFlags() const;
     /**
      * Set packet flags.
+     * Note: The highest two bits is reserved by rpc layer, see LLBC_RpcFlags,
+     *       and LLBC_CFG_COMM_HEARTBEAT_PACKET_FLAG is reserved by session heartbeat.
      * @param[in] flags - the packet falgs.
      */
     void SetFlags(int flags);
@@ -253,6 +259,18 @@ public:
      */
     size_t GetPayloadLength() const;
 
+    /**
+     * Get raw payload data(ignore payload read position, eg: packet already decoded).
+     * @return const void * - raw payload data pointer.
+     */
+    const void *GetRawPayload() const;
+
+    /**
+     * Get raw payload length(ignore payload read position).
+     * @return size_t - raw payload length.
+     */
+    size_t GetRawPayloadLength() const;
+
     /**
      * Get mutable payload(message block object pointer).
      * @return LLBC_MessageBlock * - the mutable payload.
@@ -553,6 +571,25 @@ private:
      */
     LLBC_MessageBlock *&CheckAndCreatePayload(size_t initSize);
 
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+    /**
+     * Spill inline payload to standalone message block, and use it as payload.
+     * @param[in] reserveSize - the reserve writable size.
+     */
+    void SpillInlinePayload(size_t reserveSize);
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+
+    /**
+     * Set the session info which packet address resolve from, call by Service.
+     * @param[in] sessionInfo - the session info, if set to nullptr, will copy addresses from old session info.
+     */
+    void SetSessionInfo(const LLBC_SessionInfo *sessionInfo);
+
+    /**
+     * Friend classes.
+     */
+    friend class LLBC_ServiceImpl;
+
 private:
     /**
      * Cleanup the pre-handle result data.
@@ -573,6 +610,7 @@ private:
     int _recverSvcId;
     LLBC_SockAddr_IN _localAddr;
     LLBC_SockAddr_IN _peerAddr;
+    const LLBC_SessionInfo *_sessionInfo;
 
     int _opcode;
     int _status;
@@ -593,6 +631,10 @@ private:
 
     LLBC_MessageBlock *_payload;
     LLBC_Delegate<void(LLBC_MessageBlock *)> _payloadDeleteDeleg;
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+    char _inlinePayloadBuf[LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE];
+    LLBC_MessageBlock _inlinePayload;
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
 
     LLBC_IObjectPoolInst *_selfPoolInst;
     LLBC_IObjectPoolInst *_msgBlockPoolInst;
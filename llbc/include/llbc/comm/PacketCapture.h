@@ -0,0 +1,183 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous declare some classes.
+ */
+class LLBC_Packet;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The packet capture record encapsulation.
+ *  Note: payload pointer only available before capture reader next read/close.
+ */
+struct LLBC_EXPORT LLBC_PacketCaptureRecord
+{
+    sint64 timestamp; // Monotonic timestamp since capture begin, in nano-seconds.
+    int sessionId;
+    int opcode;
+    int status;
+    const void *payload;
+    size_t payloadLen;
+};
+
+/**
+ * \brief The packet capture writer, append packets to capture file.
+ *  Capture file layout: [file header][record 1][record 2]...
+ *  - file header  : magic(8 bytes) + version(uint32) + reserved(uint32).
+ *  - record header: payloadLen(uint32) + sessionId(sint32) + opcode(sint32) + status(sint32) + timestamp(sint64).
+ *  - record payload follow record header, all integer fields use host byte order.
+ *  In Non-WIN32 platforms, capture file will be memory-mapped and grow by LLBC_CFG_COMM_PACKET_CAPTURE_MAP_SIZE,
+ *  and truncated to real size when close.
+ *  Note: not thread safe.
+ */
+class LLBC_EXPORT LLBC_PacketCaptureWriter
+{
+public:
+    LLBC_PacketCaptureWriter();
+    ~LLBC_PacketCaptureWriter();
+
+public:
+    /**
+     * Open capture file, if file exist, will truncate it.
+     * @param[in] filePath - the capture file path.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Open(const LLBC_String &filePath);
+
+    /**
+     * Close capture file.
+     */
+    void Close();
+
+    /**
+     * Check capture file opened or not.
+     * @return bool - return true if opened, otherwise return false.
+     */
+    bool IsOpened() const;
+
+    /**
+     * Get capture file path.
+     * @return const LLBC_String & - the capture file path.
+     */
+    const LLBC_String &GetFilePath() const;
+
+    /**
+     * Get written records count.
+     * @return uint64 - the records count.
+     */
+    uint64 GetRecordCount() const;
+
+public:
+    /**
+     * Append packet to capture file(whole payload will be captured, ignore payload read position).
+     * @param[in] packet - the packet.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Write(const LLBC_Packet &packet);
+
+private:
+    /**
+     * Write data to capture file.
+     */
+    int WriteData(const void *data, size_t len);
+
+    #if LLBC_TARGET_PLATFORM_NON_WIN32
+    /**
+     * Reserve mapped space.
+     */
+    int Reserve(size_t len);
+    #endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+private:
+    LLBC_String _filePath;
+    LLBC_CPUTime _beginTime;
+    uint64 _recordCount;
+
+    #if LLBC_TARGET_PLATFORM_NON_WIN32
+    int _fd;
+    char *_mapped;
+    size_t _mappedSize;
+    size_t _writePos;
+    #else // Win32
+    LLBC_File _file;
+    #endif // LLBC_TARGET_PLATFORM_NON_WIN32
+};
+
+/**
+ * \brief The packet capture reader, read records from capture file.
+ *  Note: not thread safe.
+ */
+class LLBC_EXPORT LLBC_PacketCaptureReader
+{
+public:
+    LLBC_PacketCaptureReader();
+
+public:
+    /**
+     * Open capture file, whole file will be loaded and header will be validated.
+     * @param[in] filePath - the capture file path.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Open(const LLBC_String &filePath);
+
+    /**
+     * Close capture file.
+     */
+    void Close();
+
+    /**
+     * Check capture file opened or not.
+     * @return bool - return true if opened, otherwise return false.
+     */
+    bool IsOpened() const;
+
+    /**
+     * Read next record.
+     * @param[out] record - the record.
+     * @return int - return 0 if success, otherwise return -1,
+     *               if reach capture end, last error is LLBC_ERROR_END,
+     *               if record corrupted, last error is LLBC_ERROR_FORMAT.
+     */
+    int Read(LLBC_PacketCaptureRecord &record);
+
+    /**
+     * Rewind to first record.
+     */
+    void Rewind();
+
+private:
+    bool _opened;
+    LLBC_String _content;
+    size_t _readPos;
+};
+
+__LLBC_NS_END
@@ -73,23 +73,19 @@ LLBC_FORCE_INLINE void LLBC_Packet::SetSessionId(int sessionId)
     _sessionId = sessionId;
 }
 
-LLBC_FORCE_INLINE const LLBC_SockAddr_IN &LLBC_Packet::GetLocalAddr() const
-{
-    return _localAddr;
-}
-
 LLBC_FORCE_INLINE void LLBC_Packet::SetLocalAddr(const LLBC_SockAddr_IN &addr)
 {
-    _localAddr = addr;
-}
+    if (UNLIKELY(_sessionInfo))
+        SetSessionInfo(nullptr);
 
-LLBC_FORCE_INLINE const LLBC_SockAddr_IN &LLBC_Packet::GetPeerAddr() const
-{
-    return _peerAddr;
+    _localAddr = addr;
 }
 
 LLBC_FORCE_INLINE void LLBC_Packet::SetPeerAddr(const LLBC_SockAddr_IN &addr)
 {
+    if (UNLIKELY(_sessionInfo))
+        SetSessionInfo(nullptr);
+
     _peerAddr = addr;
 }
 
@@ -208,16 +204,41 @@ LLBC_FORCE_INLINE size_t LLBC_Packet::GetPayloadLength() const
     return _payload->GetReadableSize();
 }
 
+LLBC_FORCE_INLINE const void *LLBC_Packet::GetRawPayload() const
+{
+    if (!_payload)
+        return nullptr;
+
+    return _payload->GetData();
+}
+
+LLBC_FORCE_INLINE size_t LLBC_Packet::GetRawPayloadLength() const
+{
+    if (!_payload)
+        return 0;
+
+    return _payload->GetWritePos();
+}
+
 LLBC_FORCE_INLINE LLBC_MessageBlock *LLBC_Packet::GetMutablePayload()
 {
     if (!_payload && _msgBlockPoolInst)
         _payload = reinterpret_cast<LLBC_MessageBlock *>(_msgBlockPoolInst->Get());
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+    else if (_payload == &_inlinePayload)
+        SpillInlinePayload(0);
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
 
     return _payload;
 }
 
 LLBC_FORCE_INLINE LLBC_MessageBlock * LLBC_Packet::DetachPayload()
 {
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+    if (_payload == &_inlinePayload)
+        SpillInlinePayload(0);
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+
     LLBC_MessageBlock *payload = _payload;
     _payload = nullptr;
 
@@ -670,11 +691,23 @@ LLBC_FORCE_INLINE LLBC_MessageBlock *&LLBC_Packet::CheckAndCreatePayload(size_t
 {
     if (!_payload)
     {
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+        if (initSize <= LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE)
+            _payload = &_inlinePayload;
+        else
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
         if (_msgBlockPoolInst)
             _payload = reinterpret_cast<LLBC_MessageBlock *>(_msgBlockPoolInst->Get());
         else
             _payload = new LLBC_MessageBlock(initSize);
     }
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+    else if (_payload == &_inlinePayload &&
+             _inlinePayload.GetWritableSize() < initSize)
+    {
+        SpillInlinePayload(initSize);
+    }
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
 
     return _payload;
 }
@@ -0,0 +1,71 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The packet priority enumeration, determine received packet placed to which service priority lane.
+ * Note:
+ *      - The higher priority lane always be drained before lower priority lanes in every service frame.
+ *      - Every priority lane can set per-frame handle budget, exceed packets will be handled in next frame.
+ */
+class LLBC_EXPORT LLBC_PacketPriority
+{
+public:
+    enum
+    {
+        Begin,
+
+        High = Begin, // High priority, eg: admin/heartbeat packets.
+        Normal,       // Normal priority, default priority.
+        Low,          // Low priority, eg: bulk replication packets.
+
+        End
+    };
+
+public:
+    /**
+     * Check given packet priority is validate or not.
+     * @param[in] priority - the packet priority, see above priority enumeration.
+     * @return bool - return true if validate, otherwise return false.
+     */
+    static bool IsValid(int priority);
+
+    /**
+     * Get packet priority string representation.
+     * @param[in] priority - the packet priority, see above priority enumeration.
+     * return const LLBC_String & - the packet priority string representation.
+     */
+    static const LLBC_String &Priority2Str(int priority);
+
+    /**
+     * Get packet priority enumeration from string representation.
+     * @param[in] priorityStr - the packet priority string representation.
+     * @return int - the packet priority, if error occurred, return End value.
+     */
+    static int Str2Priority(const LLBC_String &priorityStr);
+};
+
+__LLBC_NS_END
@@ -0,0 +1,183 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/comm/BasePoller.h"
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The poll poller class encapsulation.
+ *        Poll poller keep a persistent pollfd array(swap-remove when fd removed), not limited by FD_SETSIZE,
+ *        only watch writable event when session has pending send data, and use a wakeup pipe to wake up
+ *        poll() immediately when poller events queued.
+ * Note: The fd demultiplex methods can be overrided to use other level-triggered demultiplexer(eg: kqueue).
+ */
+class LLBC_HIDDEN LLBC_PollPoller : public LLBC_BasePoller
+{
+public:
+    LLBC_PollPoller();
+    virtual ~LLBC_PollPoller();
+
+public:
+    /**
+     * Startup poller.
+     * @return int - return 0 if start success, otherwise return -1.
+     */
+    virtual int Start();
+
+    /**
+     * Task startup method.
+     */
+    virtual void Svc();
+
+    /**
+     * Task Cleanup handler.
+     */
+    virtual void Cleanup();
+
+    /**
+     * Push message block to poller, wake up poller if poller waiting fd events.
+     * @param[in] block - the poller event block.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Push(LLBC_MessageBlock *block);
+
+protected:
+    /**
+     * Queued event handlers.
+     */
+    virtual void HandleEv_AsyncConn(LLBC_PollerEvent &ev);
+    virtual void HandleEv_Send(LLBC_PollerEvent &ev);
+    virtual void HandleEv_Monitor(LLBC_PollerEvent &ev);
+
+    /**
+     * Add session to poller.
+     */
+    virtual void AddSession(LLBC_Session *session);
+
+    /**
+     * Remove session from poller.
+     */
+    virtual void RemoveSession(LLBC_Session *session);
+
+    /**
+     * Detach session from poller.
+     */
+    virtual void DetachSession(LLBC_Session *session);
+
+    /**
+     * Flush session pending send data, and watch/unwatch writable event according to send result.
+     * @param[in] session - the session, maybe removed in this method.
+     */
+    virtual void FlushSend(LLBC_Session *session);
+
+protected:
+    /**
+     * The fd interest flags.
+     */
+    enum
+    {
+        Interest_Read = 0x01,
+        Interest_Write = 0x02,
+        // Listen socket read interest, will not be masked when read paused.
+        Interest_Accept = 0x04
+    };
+
+    /**
+     * The fd ready event.
+     */
+    struct _FdEvent
+    {
+        LLBC_SocketHandle handle;
+        bool readable;
+        bool writable;
+        bool error;
+    };
+    typedef std::vector<_FdEvent> _FdEvents;
+
+    /**
+     * Fd demultiplex methods, the interest only contains Interest_Read/Interest_Write flags.
+     */
+    virtual int InitDemux();
+    virtual void DestroyDemux();
+    virtual void AddFd(LLBC_SocketHandle handle, int interest);
+    virtual void RemoveFd(LLBC_SocketHandle handle);
+    virtual void ModifyFd(LLBC_SocketHandle handle, int interest);
+    virtual void WaitFds(int timeout, _FdEvents &fdEvents);
+
+private:
+    /**
+     * Watch/Unwatch fd, read interest will be masked when read paused(except Interest_Accept).
+     */
+    void WatchFd(LLBC_SocketHandle handle, int interest);
+    void UnwatchFd(LLBC_SocketHandle handle);
+    void SetWriteInterest(LLBC_SocketHandle handle, bool write);
+    int ToDemuxInterest(int interest) const;
+
+    /**
+     * Update read interest of all sessions, if service overload protection read paused state changed.
+     */
+    void UpdateReadPaused();
+
+    /**
+     * Wake up poller/Drain wakeup pipe.
+     */
+    void Wakeup();
+    void DrainWakeup();
+
+    /**
+     * Handle fd ready event.
+     */
+    void HandleFdEvent(const _FdEvent &fdEv);
+
+    /**
+     * Accept new connection.
+     */
+    void Accept(LLBC_Session *session);
+
+    /**
+     * Handle connecting socket.
+     */
+    void HandleConnecting(_Connecting::iterator it, const _FdEvent &fdEv);
+
+protected:
+    int _pollerType;
+
+private:
+    int _wakeupFds[2];
+    volatile bool _waiting;
+
+    bool _readPaused;
+    std::unordered_map<LLBC_SocketHandle, int> _interests;
+    _FdEvents _fdEvents;
+
+    std::vector<struct pollfd> _pollFds;
+    std::unordered_map<LLBC_SocketHandle, size_t> _pollFdIndexes;
+};
+
+__LLBC_NS_END
+
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
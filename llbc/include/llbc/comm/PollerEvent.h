@@ -22,6 +22,7 @@
 #pragma once
 
 #include "llbc/comm/SessionOpts.h"
+#include "llbc/comm/FileRegion.h"
 
 __LLBC_NS_BEGIN
 
@@ -58,6 +59,10 @@ struct LLBC_HIDDEN LLBC_PollerEvent
         TakeOverSession,
         // Control protocol stack, generate by Service layer.
         CtrlProtocolStack,
+        // Migrate session to other poller, generate by Service layer or poller self(auto balance).
+        MigrateSession,
+        // Send file region request, generate by Service layer.
+        SendFile,
 
         // Sentinel.
         End
@@ -65,6 +70,9 @@ struct LLBC_HIDDEN LLBC_PollerEvent
 
     Type type;
     int sessionId;
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    sint64 enqueueTime; // Enqueue time(in micro-seconds), stamped by poller when push, 0 if queue statistics disabled.
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
     LLBC_SockAddr_IN peerAddr;
     LLBC_SessionOpts *sessionOpts;
     union
@@ -74,6 +82,8 @@ struct LLBC_HIDDEN LLBC_PollerEvent
         LLBC_Session *session;
         char *monitorEv;
         char *closeReason;
+        int toPollerId;
+        LLBC_FileRegion *fileRegion;
         struct
         {
             int ctrlCmd;
@@ -138,6 +148,16 @@ public:
                                                        int ctrlCmd,
                                                        const LLBC_Variant &ctrlData);
 
+    /**
+     * Build migrate session event.
+     */
+    static LLBC_MessageBlock *BuildMigrateSessionEv(int sessionId, int toPollerId);
+
+    /**
+     * Build send file event.
+     */
+    static LLBC_MessageBlock *BuildSendFileEv(LLBC_FileRegion *fileRegion);
+
 public:
     /**
      * Destroy poller event.
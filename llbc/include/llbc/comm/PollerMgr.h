@@ -32,7 +32,9 @@ class LLBC_Packet;
 class LLBC_Socket;
 class LLBC_Service;
 class LLBC_BasePoller;
+class LLBC_QueueStat;
 class LLBC_IProtocolFactory;
+struct LLBC_FileRegion;
 
 __LLBC_NS_END
 
@@ -49,9 +51,10 @@ public:
 
 public:
     /**
-     * Set poller type.
+     * Get/Set poller type.
      * @param[in] type - the poller type.
      */
+    int GetPollerType() const;
     void SetPollerType(int type);
 
     /**
@@ -60,6 +63,25 @@ public:
      */
     void SetService(LLBC_Service *svc);
 
+    /**
+     * Get poller place policy.
+     * @return int - the poller place policy, see LLBC_PollerPlacePolicy.
+     */
+    int GetPlacePolicy() const;
+
+    /**
+     * Set poller place policy.
+     * @param[in] policy - the poller place policy, see LLBC_PollerPlacePolicy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetPlacePolicy(int policy);
+
+    /**
+     * Get alive poller count.
+     * @return int - the poller count.
+     */
+    int GetPollerCount() const;
+
 public:
     /**
      * Startup poller manager.
@@ -73,6 +95,60 @@ public:
      */
     void Stop();
 
+    /**
+     * Change poller count at runtime.
+     * When grow, new pollers will be started, the new sessions will be placed to them.
+     * When shrink, all sessions of the removed pollers will be migrated to alive pollers,
+     * this method will block until the removed pollers drained and stopped.
+     * @param[in] count - the new poller count.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetPollerCount(int count);
+
+    /**
+     * Set poller threads name prefix, only affect the pollers created later.
+     * @param[in] namePrefix - the poller thread name prefix, poller thread name = prefix + poller index.
+     */
+    void SetPollerThreadName(const LLBC_String &namePrefix);
+
+    /**
+     * Set poller threads cpu affinity, only affect the pollers created later.
+     * @param[in] cpuMask - the cpu mask, 0 means not set.
+     * @param[in] spread  - if true, each poller pin to one cpu of cpuMask(round robin by poller index),
+     *                      otherwise all pollers share the cpuMask.
+     */
+    void SetPollerCPUAffinity(uint64 cpuMask, bool spread);
+
+    /**
+     * Get/Set all pollers busy poll window(include the pollers created later).
+     * @param[in] busyPollWindow - the busy poll window, in micro-seconds, 0 means disable busy poll mode.
+     */
+    int GetBusyPollWindow() const;
+    void SetBusyPollWindow(int busyPollWindow);
+
+    /**
+     * Get/Set all pollers applied overload policy flags(see LLBC_OverloadPolicy), set by service when overload
+     * state changed, pollers check it in every loop.
+     * @param[in] overloadFlags - the overload policy flags, None means not overloaded.
+     */
+    int GetOverloadFlags() const;
+    void SetOverloadFlags(int overloadFlags);
+
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    /**
+     * Enable/Disable all pollers queue statistics(include the pollers created later).
+     * @param[in] enabled - the enable flag.
+     */
+    void SetQueueStatsEnabled(bool enabled);
+
+    /**
+     * Get/Reset alive pollers queue statistics.
+     * @param[out] stats - the queue statistics, index is poller index.
+     */
+    void GetQueueStats(std::vector<LLBC_QueueStat> &stats) const;
+    void ResetQueueStats();
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 public:
     /**
      * Listen in specified local address(call by service).
@@ -113,6 +189,26 @@ public:
                   LLBC_IProtocolFactory *protoFactory,
                   const LLBC_SessionOpts &sessionOpts);
 
+    /**
+     * Listen datagram(UDP) in specified local address(call by service), EpollPoller specific.
+     * @param[in] ip           - the ip address.
+     * @param[in] port         - the port number. 
+     * @param[in] protoFactory - the protocol factory.
+     * @param[in] sessionOpts  - the session options.
+     * @return int - the new session Id, if return 0, means listen failed.
+     */
+    int ListenUdp(const char *ip, uint16 port, LLBC_IProtocolFactory *protoFactory, const LLBC_SessionOpts &sessionOpts);
+
+    /**
+     * Connect datagram(UDP) to peer address(call by service), EpollPoller specific.
+     * @param[in] ip           - the ip address.
+     * @param[in] port         - the port number. 
+     * @param[in] protoFactory - the protocol factory.
+     * @param[in] sessionOpts  - the session options.
+     * @return int - the new session Id, if return 0, means connect failed.
+     */
+    int ConnectUdp(const char *ip, uint16 port, LLBC_IProtocolFactory *protoFactory, const LLBC_SessionOpts &sessionOpts);
+
     /**
      * Send packet.
      * @param[in] packet - the packet.
@@ -120,6 +216,13 @@ public:
      */
     int Send(LLBC_Packet *packet);
 
+    /**
+     * Send file region, file region will be managed by poller manager.
+     * @param[in] fileRegion - the file region.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SendFile(LLBC_FileRegion *fileRegion);
+
     /**
      * Close session.
      * @param[in] sessionId - the session Id.
@@ -138,13 +241,89 @@ public:
                            int ctrlCmd,
                            const LLBC_Variant &ctrlData);
 
+    /**
+     * Migrate session to specific poller(call by service).
+     * Note: Listen session, datagram peer session and pinned session could not migrate.
+     * @param[in] sessionId - the session Id.
+     * @param[in] pollerIdx - the target poller index.
+     * @return int - return 0 if success, otherwise return -1.
+     *               Note: return 0 is not means the session was migrated,
+     *                     it only means post migrate request to poller success.
+     */
+    int MigrateSession(int sessionId, int pollerIdx);
+
 private:
     /**
-     * Allocate new session Id, call by self or Poller.
+     * Allocate new session Id, call by self, Poller or Service(local session).
      * @return int - the new session Id.
      */
     int AllocSessionId();
 
+    /**
+     * Allocate session Id and add the socket to poller(or pending add sockets).
+     * @param[in] sock         - the socket.
+     * @param[in] protoFactory - the protocol factory(if exist).
+     * @param[in] sessionOpts  - the session options.
+     * @return int - the new session Id.
+     */
+    int AddSocket(LLBC_Socket *sock, LLBC_IProtocolFactory *protoFactory, const LLBC_SessionOpts &sessionOpts);
+
+    /**
+     * Place new session to poller, according to session pinned poller option and place policy.
+     * @param[in] sessionId   - the session Id.
+     * @param[in] sessionOpts - the session options.
+     * @return int - the placed poller index.
+     */
+    int PlaceSession(int sessionId, const LLBC_SessionOpts &sessionOpts);
+
+    /**
+     * Get the poller index which session placed.
+     * @param[in] sessionId - the session Id.
+     * @return int - the poller index.
+     */
+    int GetPollerIdx(int sessionId);
+
+    /**
+     * Push event block to the poller which session placed.
+     * @param[in] sessionId - the session Id.
+     * @param[in] block     - the event block, if push failed, block will be destroyed.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int PushToSessionPoller(int sessionId, LLBC_MessageBlock *block);
+
+    /**
+     * Get the poller index which draining session will migrate to, call by Poller.
+     * @param[in] sessionId - the session Id.
+     * @return int - the poller index.
+     */
+    int GetDrainTarget(int sessionId);
+
+    /**
+     * Set(only update exist route)/Remove session route, call by Poller or Service.
+     * @param[in] sessionId - the session Id.
+     * @param[in] pollerIdx - the poller index.
+     */
+    void SetRoute(int sessionId, int pollerIdx);
+    void RemoveRoute(int sessionId);
+
+    /**
+     * Get the auto balance migrate target poller of specific poller, call by Poller.
+     * @param[in] pollerIdx     - the poller index.
+     * @param[out] migrateCount - the suggested migrate session count.
+     * @return int - the target poller index, if no need to migrate, return -1.
+     */
+    int GetBalanceTarget(int pollerIdx, int &migrateCount);
+
+    /**
+     * Get the least loaded poller index, according to given place policy(route lock must be held).
+     */
+    int GetLeastLoadedPoller(int policy) const;
+
+    /**
+     * Apply poller thread name & cpu affinity to new created poller(before poller start).
+     */
+    void ApplyPollerThreadCfg(LLBC_BasePoller *poller, int pollerIdx) const;
+
     /**
      * Push specific message to poller, call by Poller.
      * @param[in] id    - the poller Id.
@@ -170,17 +349,33 @@ private:
      * Friend classes.
      */
     friend class LLBC_BasePoller;
+    friend class LLBC_ServiceImpl;
 
 private:
     int _type;
     LLBC_Service *_svc;
 
-    int _pollerCount;
+    volatile int _pollerCount;
     LLBC_BasePoller **_pollers;
-    LLBC_SpinLock _pollerLock;
+    mutable LLBC_SpinLock _pollerLock;
+    std::vector<LLBC_BasePoller *> _retiredPollers;
+    LLBC_String _pollerThreadName;
+    uint64 _pollerCPUMask;
+    bool _pollerCPUSpread;
+    volatile int _busyPollWindow;
+    volatile int _overloadFlags;
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    volatile bool _queueStatsEnabled;
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
 
     int _maxSessionId;
 
+    volatile int _placePolicy;
+    typedef std::map<int, int> _Routes;
+    _Routes _routes;
+    std::vector<int> _routeCounts;
+    LLBC_SpinLock _routeLock;
+
     typedef std::map<int, std::pair<LLBC_Socket *, LLBC_SessionOpts> > _PendingAddSocks;
     _PendingAddSocks _pendingAddSocks;
     typedef std::map<int, std::pair<LLBC_SockAddr_IN, LLBC_SessionOpts> > _PendingAsyncConns;
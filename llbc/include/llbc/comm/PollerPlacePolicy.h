@@ -0,0 +1,71 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The poller place policy enumeration, determine new session placed to which poller.
+ * Note:
+ *      - Pinned session(see LLBC_SessionOpts::SetPinnedPoller()) always placed to pinned poller.
+ *      - Non Modulo policy will auto migrate idle sessions from busy poller to idle poller.
+ */
+class LLBC_EXPORT LLBC_PollerPlacePolicy
+{
+public:
+    enum
+    {
+        Begin,
+
+        Modulo = Begin, // Place by sessionId % pollerCount, default policy.
+        LeastSessions,  // Place to the poller which has least sessions.
+        LeastBytes,     // Place to the poller which has least bytes/s.
+
+        End
+    };
+
+public:
+    /**
+     * Check given place policy is validate or not.
+     * @param[in] policy - the place policy, see above policy enumeration.
+     * @return bool - return true if validate, otherwise return false.
+     */
+    static bool IsValid(int policy);
+
+    /**
+     * Get place policy string representation.
+     * @param[in] policy - the place policy, see above policy enumeration.
+     * return const LLBC_String & - the place policy string representation.
+     */
+    static const LLBC_String &Policy2Str(int policy);
+
+    /**
+     * Get place policy enumeration from string representation.
+     * @param[in] policyStr - the place policy string representation.
+     * @return int - the place policy, if error occurred, return End value.
+     */
+    static int Str2Policy(const LLBC_String &policyStr);
+};
+
+__LLBC_NS_END
@@ -38,8 +38,13 @@ public:
         SelectPoller = Begin,
 #if LLBC_TARGET_PLATFORM_WIN32
         IocpPoller,     // Iocp poller only availables in WIN32 platform.
-#elif LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+#else // Non-WIN32
+        PollPoller,     // Poll poller availables on all Non-WIN32 platforms.
+ #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
         EpollPoller,    // Epoll poller availables on LINUX & ANDROID platforms.
+ #elif LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+        KqueuePoller,   // Kqueue poller availables on MAC & IPHONE platforms.
+ #endif
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
         End
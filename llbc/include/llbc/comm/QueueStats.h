@@ -0,0 +1,93 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/comm/OpcodeStats.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The event queue(service/poller) statistics class encapsulation.
+ *        Note: This class is not thread safe, the owner must serialize the Record*() calls.
+ */
+class LLBC_EXPORT LLBC_QueueStat
+{
+public:
+    LLBC_QueueStat();
+
+public:
+    /**
+     * Record event enqueue.
+     * @param[in] depth - the queue depth after enqueue.
+     */
+    void RecordEnqueue(size_t depth);
+
+    /**
+     * Record event dequeue.
+     * @param[in] queueTime - the time spent queued, in nano-seconds.
+     */
+    void RecordDequeue(sint64 queueTime);
+
+    /**
+     * Record queue consumer wakeup(found queued events).
+     * @param[in] depth - the queue depth when wakeup.
+     */
+    void RecordWakeup(size_t depth);
+
+    /**
+     * Reset statistics.
+     */
+    void Reset();
+
+public:
+    /**
+     * Get enqueue/dequeue rate, from statistics begin time to now.
+     * @return double - the events count per second.
+     */
+    double GetEnqueueRate() const;
+    double GetDequeueRate() const;
+
+    /**
+     * Get mean queue depth at wakeup.
+     * @return double - the mean depth.
+     */
+    double GetMeanWakeupDepth() const;
+
+    /**
+     * Get queue statistics string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+public:
+    sint64 beginTime; // statistics begin time, in milli-seconds.
+    uint64 enqueueCount; // enqueued events count.
+    uint64 dequeueCount; // dequeued events count.
+    uint64 wakeupCount; // consumer wakeup count.
+    uint64 wakeupDepthSum; // the sum of queue depth at every wakeup.
+    size_t maxDepth; // max queue depth.
+
+    LLBC_LatencyHistogram queueTime; // events time spent queued.
+};
+
+__LLBC_NS_END
@@ -0,0 +1,114 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/core/Core.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Previous declare some classes.
+ */
+class LLBC_Packet;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The rpc packet flags, rpc layer reserved the highest two bits of packet flags.
+ * Note:
+ *      - The rpc request/response packet's extData1 is the call Id, allocated by caller service.
+ *      - The response packet will be delivered to call callback, not dispatch to packet handlers.
+ */
+class LLBC_EXPORT LLBC_RpcFlags
+{
+public:
+    enum
+    {
+        Request = 0x4000,  // Rpc request packet.
+        Response = 0x8000, // Rpc response packet.
+
+        All = Request | Response
+    };
+};
+
+/**
+ * \brief The rpc call status enumeration.
+ */
+class LLBC_EXPORT LLBC_RpcStatus
+{
+public:
+    enum
+    {
+        Begin,
+
+        Ok = Begin,       // Response received.
+        Timeout,          // Call timeout.
+        SessionDestroyed, // Call session destroyed before response received.
+        ServiceStopped,   // Caller service stopped before response received.
+
+        End
+    };
+
+public:
+    /**
+     * Get rpc call status string representation.
+     * @param[in] status - the rpc call status.
+     * @return const LLBC_String & - the rpc call status string representation.
+     */
+    static const LLBC_String &Status2Str(int status);
+};
+
+/**
+ * \brief The rpc call result class encapsulation, delivered to call callback in caller service thread.
+ */
+class LLBC_EXPORT LLBC_RpcResult
+{
+public:
+    LLBC_RpcResult();
+
+public:
+    /**
+     * Check rpc call is success or not(response received).
+     * Note: Response packet's status is business status, is not the rpc call status.
+     * @return bool - return true if success, otherwise return false.
+     */
+    bool IsOk() const;
+
+    /**
+     * Get rpc call result string representation.
+     * @return LLBC_String - the string representation.
+     */
+    LLBC_String ToString() const;
+
+public:
+    sint64 callId; // the call Id.
+    int sessionId; // the call session Id.
+    int opcode; // the request opcode.
+    int status; // the rpc call status, see LLBC_RpcStatus.
+    sint64 elapsed; // elapsed time from call to finish, in micro-seconds.
+    LLBC_Packet *response; // the response packet, only available in callback when status is Ok, otherwise is nullptr.
+};
+
+__LLBC_NS_END
@@ -73,6 +73,11 @@ protected:
      */
     virtual void RemoveSession(LLBC_Session *session);
 
+    /**
+     * Detach session from poller.
+     */
+    virtual void DetachSession(LLBC_Session *session);
+
 private:
     /**
      * Update the max fd.
@@ -24,6 +24,12 @@
 #include "llbc/comm/SessionOpts.h"
 #include "llbc/comm/Coder.h"
 #include "llbc/comm/Component.h"
+#include "llbc/comm/OpcodeStats.h"
+#include "llbc/comm/FrameProfile.h"
+#include "llbc/comm/QueueStats.h"
+#include "llbc/comm/PacketPriority.h"
+#include "llbc/comm/OverloadPolicy.h"
+#include "llbc/comm/Rpc.h"
 
 __LLBC_NS_BEGIN
  /**
@@ -115,6 +121,18 @@ public:
      */
     virtual bool IsFullStack() const = 0;
 
+    /**
+     * Get/Set decode offload option, only available in non full-stack service.
+     * If enabled, packets will be decoded(codec layer) in poller threads, per-session packets order is kept,
+     * and service thread receive decoded packets, packets encoding still be done in service.
+     * Note: - Must be set before service started.
+     *       - Local session packets always be decoded in service.
+     * @param[in] decodeOffload - the decode offload option.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual bool IsDecodeOffload() const = 0;
+    virtual int SetDecodeOffload(bool decodeOffload) = 0;
+
     /**
      * Get the service drive mode.
      * @return DriveMode - the service drive mode.
@@ -223,6 +241,52 @@ public:
                           LLBC_IProtocolFactory *protoFactory = nullptr,
                           const LLBC_SessionOpts &sessionOpts = LLBC_DftSessionOpts) = 0;
 
+    /**
+     * Establishes an in-process loopback session to another service, no socket will be created.
+     * Note:
+     *      Both services must be started, the packets sent to loopback session will be pushed to
+     *      peer service's message queue directly, only codec layer will be applied(no pack/compress),
+     *      session create/destroy events still fire in both services.
+     * @param[in] otherSvc - the peer service, must not be self.
+     * @return int - the new session Id(in this service), if return 0 means failed, see LLBC_GetLastError().
+     */
+    virtual int ConnectLocal(LLBC_Service *otherSvc) = 0;
+
+    /**
+     * Create a datagram(UDP) session and listening, every datagram peer will be identified
+     * as a pseudo-session(accept session Id is the listen session Id).
+     * Note:
+     *      - Only available in EpollPoller poller model.
+     *      - One datagram is exactly one packet, malformed datagram will be dropped.
+     * @param[in] ip           - the ip address.
+     * @param[in] port         - the port number.
+     * @param[in] protoFactory - the protocol factory, default use LLBC_DatagramProtocolFactory.
+     *                           if use custom protocol factory, when ListenUdp failed, the factory will delete by framework.
+     * @param[in] sessionOpts  - the session options.
+     * @return int - the new session Id, if return 0, means failed, see LLBC_GetLastError().
+     */
+    virtual int ListenUdp(const char *ip,
+                          uint16 port,
+                          LLBC_IProtocolFactory *protoFactory = nullptr,
+                          const LLBC_SessionOpts &sessionOpts = LLBC_DftSessionOpts) = 0;
+
+    /**
+     * Create a connected datagram(UDP) session to a specified address.
+     * Note:
+     *      - Only available in EpollPoller poller model.
+     *      - One datagram is exactly one packet, malformed datagram will be dropped.
+     * @param[in] ip           - the ip address.
+     * @param[in] port         - the port number.
+     * @param[in] protoFactory - the protocol factory, default use LLBC_DatagramProtocolFactory.
+     *                           if use custom protocol factory, when ConnectUdp failed, the factory will delete by framework.
+     * @param[in] sessionOpts  - the session options.
+     * @return int - the new session Id, if return 0, means failed, see LLBC_GetLastError().
+     */
+    virtual int ConnectUdp(const char *ip,
+                           uint16 port,
+                           LLBC_IProtocolFactory *protoFactory = nullptr,
+                           const LLBC_SessionOpts &sessionOpts = LLBC_DftSessionOpts) = 0;
+
     /**
      * Check given sessionId is validate or not.
      * @param[in] sessionId - the given session Id.
@@ -277,6 +341,23 @@ public:
     virtual int Send(int sessionId, int opcode, const void *bytes, size_t len, int status);
     virtual int Send(int svcId, int sessionId, int opcode, const void *bytes, size_t len, int status);
 
+    /**
+     * Send file region(bulk transfer), the region will be delivered to peer as one packet payload.
+     * If session protocol stack has no transforming layer(eg: compress), the region will be sent
+     * by sendfile() directly after packet header, otherwise will fallback to chunked read and send.
+     * Note:
+     *      - the fd will be dup() internal, caller still own the fd and can close it after call.
+     *      - not support in WIN32 platform and local session.
+     * @param[in] sessionId - the session Id.
+     * @param[in] opcode    - the opcode.
+     * @param[in] fd        - the file descriptor.
+     * @param[in] offset    - the file region offset.
+     * @param[in] length    - the file region length, in bytes.
+     * @param[in] status    - the status, default is 0.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SendFile(int sessionId, int opcode, int fd, sint64 offset, size_t length, int status = 0) = 0;
+
 public:
     /** 
      * Multicast data(these methods will automatics create packet to send).
@@ -353,6 +434,134 @@ public:
     virtual int Broadcast(int opcode, const void *bytes, size_t len, int status);
     virtual int Broadcast(int svcId, int opcode, const void *bytes, size_t len, int status) = 0;
 
+public:
+    /**
+     * Asynchronous rpc call, many in-flight calls per session are allowed(pipelined).
+     * Note:
+     *      - Must be called in service thread, and service must be started.
+     *      - Request packet will be marked LLBC_RpcFlags::Request, packet's extData1 will be set to call Id.
+     *      - Callback will be called exactly once in service thread(response received/timeout/
+     *        session destroyed/service stopped), unless call cancelled by CancelCall().
+     *      - Like Send(), no matter this call success or not, packet/coder will be managed by llbc framework,
+     *        if call failed, the callback will not be called.
+     * @param[in] packet    - the request packet.
+     * @param[in] sessionId - the session Id.
+     * @param[in] opcode    - the request opcode.
+     * @param[in] coder     - the request coder.
+     * @param[in] bytes     - the request bytes.
+     * @param[in] len       - the request bytes len, in bytes.
+     * @param[in] callback  - the call callback.
+     * @param[in] timeout   - the call timeout, in milli-seconds, <= 0 means use LLBC_CFG_COMM_DFT_RPC_TIMEOUT.
+     * @return sint64 - the call Id, if return 0 means failed, see LLBC_GetLastError().
+     */
+    sint64 Call(int sessionId,
+                int opcode,
+                LLBC_Coder *coder,
+                const LLBC_Delegate<void(const LLBC_RpcResult &)> &callback,
+                int timeout = 0);
+    sint64 Call(int sessionId,
+                int opcode,
+                const void *bytes,
+                size_t len,
+                const LLBC_Delegate<void(const LLBC_RpcResult &)> &callback,
+                int timeout = 0);
+    virtual sint64 Call(LLBC_Packet *packet,
+                        const LLBC_Delegate<void(const LLBC_RpcResult &)> &callback,
+                        int timeout = 0) = 0;
+
+    /**
+     * Reply rpc request, response packet will be marked LLBC_RpcFlags::Response and carry request's call Id.
+     * Note: Like Send(), no matter this call success or not, coder will be managed by llbc framework.
+     * @param[in] request - the rpc request packet.
+     * @param[in] opcode  - the response opcode, could be different from request opcode.
+     * @param[in] coder   - the response coder.
+     * @param[in] bytes   - the response bytes.
+     * @param[in] len     - the response bytes len, in bytes.
+     * @param[in] status  - the response status, default is 0.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Reply(const LLBC_Packet &request, int opcode, LLBC_Coder *coder, int status = 0);
+    int Reply(const LLBC_Packet &request, int opcode, const void *bytes, size_t len, int status = 0);
+
+    /**
+     * Cancel rpc call, the call callback will not be called.
+     * Note: Must be called in service thread, late response of cancelled call will be discarded.
+     * @param[in] callId - the call Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int CancelCall(sint64 callId) = 0;
+
+    /**
+     * Get in-flight rpc calls count.
+     * @return size_t - the in-flight rpc calls count.
+     */
+    virtual size_t GetPendingCallCount() const = 0;
+
+public:
+    /**
+     * Create stackful coroutine and run it immediately until it yield or finished.
+     * Note:
+     *      - Must be called in service thread, and service must be started.
+     *      - Coroutine always run in service thread, suspended coroutine will be resumed in service thread too.
+     *      - When service stopping, all suspended coroutines will be resumed and all awaits will return failed
+     *        (LLBC_ERROR_CANCELLED), coroutine must return as soon as possible.
+     * @param[in] entry - the coroutine entry.
+     * @return sint64 - the coroutine Id, if return 0 means failed, see LLBC_GetLastError().
+     */
+    virtual sint64 Go(const LLBC_Delegate<void()> &entry) = 0;
+
+    /**
+     * Get current running coroutine Id.
+     * @return sint64 - the coroutine Id, return 0 if not running in coroutine.
+     */
+    virtual sint64 GetCurrentCoroId() const = 0;
+
+    /**
+     * Get alive(running or suspended) coroutines count.
+     * @return size_t - the alive coroutines count.
+     */
+    virtual size_t GetCoroCount() const = 0;
+
+    /**
+     * Suspend current coroutine until ResumeCoro() called, must be called in coroutine.
+     * @return int - return 0 if success, otherwise return -1(service stopping, error: LLBC_ERROR_CANCELLED).
+     */
+    virtual int YieldCoro() = 0;
+
+    /**
+     * Resume suspended coroutine, must be called in service thread.
+     * Note: If called out of coroutine, coroutine will be resumed immediately, otherwise
+     *       coroutine will be resumed in service next OnSvc() loop.
+     * @param[in] coroId - the coroutine Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int ResumeCoro(sint64 coroId) = 0;
+
+    /**
+     * Suspend current coroutine specific milli-seconds, must be called in coroutine.
+     * @param[in] milliseconds - the sleep time, in milli-seconds, <= 0 means yield to service next OnSvc() loop.
+     * @return int - return 0 if success, otherwise return -1(service stopping, error: LLBC_ERROR_CANCELLED).
+     */
+    virtual int CoroSleep(int milliseconds) = 0;
+
+    /**
+     * Rpc call and suspend current coroutine until call finished, must be called in coroutine.
+     * Note: result.response only available until coroutine yield again or finished.
+     * @param[in] packet    - the request packet.
+     * @param[in] sessionId - the session Id.
+     * @param[in] opcode    - the request opcode.
+     * @param[in] coder     - the request coder.
+     * @param[in] bytes     - the request bytes.
+     * @param[in] len       - the request bytes len, in bytes.
+     * @param[out] result   - the call result, check result.status to determine call success or not.
+     * @param[in] timeout   - the call timeout, in milli-seconds, <= 0 means use LLBC_CFG_COMM_DFT_RPC_TIMEOUT.
+     * @return int - return 0 if call finished, otherwise return -1.
+     */
+    int CoroCall(int sessionId, int opcode, LLBC_Coder *coder, LLBC_RpcResult &result, int timeout = 0);
+    int CoroCall(int sessionId, int opcode, const void *bytes, size_t len, LLBC_RpcResult &result, int timeout = 0);
+    int CoroCall(LLBC_Packet *packet, LLBC_RpcResult &result, int timeout = 0);
+
+public:
     /**
      * Remove session, always success.
      * @param[in] sessionId - the will close session Id.
@@ -372,6 +581,295 @@ public:
                                   int ctrlCmd,
                                   const LLBC_Variant &ctrlData) = 0;
 
+    /**
+     * Set poller place policy, determine new session placed to which poller, default is Modulo.
+     * Note: Non Modulo policy will auto migrate idle sessions from busy poller to idle poller.
+     * @param[in] policy - the place policy, see LLBC_PollerPlacePolicy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPollerPlacePolicy(int policy) = 0;
+
+    /**
+     * Migrate session to specific poller(asynchronous).
+     * Note: Listen session, local session, datagram peer session and pinned session could not migrate,
+     *       the packets sending while migrating maybe reordered, so migrate idle session is recommended.
+     * @param[in] sessionId - the session Id.
+     * @param[in] pollerIdx - the target poller index.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int MigrateSession(int sessionId, int pollerIdx) = 0;
+
+    /**
+     * Get service poller count.
+     * @return int - the poller count.
+     */
+    virtual int GetPollerCount() const = 0;
+
+    /**
+     * Change service poller count at runtime, the connections will not be dropped.
+     * Note: When shrink, the sessions of removed pollers will be migrated to alive pollers,
+     *       this method will block until removed pollers drained(at least LLBC_CFG_COMM_POLLER_BALANCE_INTERVAL),
+     *       and the datagram peer sessions of removed pollers will be closed.
+     * @param[in] pollerCount - the new poller count, must in range [1, LLBC_CFG_COMM_MAX_POLLER_COUNT].
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPollerCount(int pollerCount) = 0;
+
+    /**
+     * Get/Set service poller model, must be called before service start, default is LLBC_CFG_COMM_POLLER_MODEL.
+     * Note: - Also can be configured in service config(key: pollerModel), api setting has higher priority.
+     *       - Datagram sessions only supported in EpollPoller.
+     * @param[in] pollerModel - the poller model(case insensitive), see LLBC_PollerType.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual const LLBC_String &GetPollerModel() const = 0;
+    virtual int SetPollerModel(const LLBC_String &pollerModel) = 0;
+
+    /**
+     * Set service thread name/cpu affinity, must be called before service start.
+     * Note: - Only available in SelfDrive mode.
+     *       - Also can be configured in service config(key: threadName/cpuAffinity), api setting has higher priority.
+     *       - Cpu affinity config format: cpu list(eg: "0-3,6") or hex mask(eg: "0x4f").
+     * @param[in] threadName - the thread name, empty means not set.
+     * @param[in] cpuMask    - the cpu mask, bit N set means service thread can run on cpu N, 0 means not set.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetThreadName(const LLBC_String &threadName) = 0;
+    virtual int SetCPUAffinity(uint64 cpuMask) = 0;
+
+    /**
+     * Set service poller threads name prefix/cpu affinity, must be called before service start,
+     * the pollers created by SetPollerCount() also use these settings.
+     * Note: - Poller thread name = name prefix + poller index, eg: "netpoller0".
+     *       - Also can be configured in service config(key: pollerThreadName/pollerCpuAffinity/pollerCpuSpread),
+     *         api setting has higher priority.
+     * @param[in] namePrefix - the poller thread name prefix, empty means not set.
+     * @param[in] cpuMask    - the cpu mask, 0 means not set.
+     * @param[in] spread     - if true, each poller pin to one cpu of cpuMask(round robin by poller index),
+     *                         otherwise all pollers share the cpuMask.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPollerThreadName(const LLBC_String &namePrefix) = 0;
+    virtual int SetPollerCPUAffinity(uint64 cpuMask, bool spread = false) = 0;
+
+    /**
+     * Get/Set service pollers busy poll window(low-latency mode), can be set at any time.
+     * In busy poll mode, pollers spin on queued events(and non-blocking epoll) for busy poll window
+     * before fall back to blocking wait, and sessions will set SO_BUSY_POLL socket option(Linux only).
+     * Note: - Busy poll mode trade cpu for latency, only suggest use in dedicated-core deployment,
+     *         see SetPollerCPUAffinity().
+     *       - Also can be configured in service config(key: pollerBusyPoll), api setting has higher priority.
+     * @param[in] busyPollWindow - the busy poll window, in micro-seconds, 0 means disable busy poll mode.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetPollerBusyPoll() const = 0;
+    virtual int SetPollerBusyPoll(int busyPollWindow) = 0;
+
+    /**
+     * Set opcode/session packet priority, the higher priority packets will be handled before lower priority packets.
+     * Note: - Packet priority = the higher one of opcode priority and session priority,
+     *         if both not set, use Normal priority.
+     *       - Same priority packets always be handled in arrival order, but different priorities packets
+     *         may be handled out of arrival order(even in the same session).
+     *       - Session destroy event always be handled after all pending packets of the session handled,
+     *         but if session removed by service(RemoveSession()), the pending packets will be discarded.
+     *       - Can be called at any time, thread safe.
+     * @param[in] opcode    - the opcode.
+     * @param[in] sessionId - the session Id.
+     * @param[in] priority  - the packet priority, see LLBC_PacketPriority, End means remove priority setting.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodePriority(int opcode, int priority) = 0;
+    virtual int SetSessionPriority(int sessionId, int priority) = 0;
+
+    /**
+     * Set per-frame packet handle budget of given priority, the packets exceed budget will be handled in next frame,
+     * so low priority packets flood can't stall the service frame.
+     * @param[in] priority - the packet priority, see LLBC_PacketPriority.
+     * @param[in] budget   - max handle packets count per frame, 0 means unlimited(default).
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPriorityBudget(int priority, int budget) = 0;
+
+    /**
+     * Get pending(exceed budget, not handled) packets count of given priority.
+     * @param[in] priority - the packet priority, see LLBC_PacketPriority.
+     * @return size_t - the pending packets count.
+     */
+    virtual size_t GetPendingPacketCount(int priority) const = 0;
+
+    /**
+     * Set service overload protection, when service falls behind(queued events count or queueing delay reach
+     * threshold), service enter overload state and apply overload policy, until queue drained.
+     * Note: - Overload state transitions will be reported to components(OnOverloadChanged event).
+     *       - ShedLowPriority policy discard the packets which priority is Low, see SetOpcodePriority().
+     *       - Service keep overloaded at least LLBC_CFG_COMM_MIN_OVERLOAD_DURATION milli-seconds.
+     *       - Can be called at any time, thread safe.
+     * @param[in] policy        - the overload policy flags, see LLBC_OverloadPolicy, None means disable protection.
+     * @param[in] highWatermark - enter overload when queued events count reach high watermark, 0 means not check.
+     * @param[in] lowWatermark  - leave overload when queued events count fall to low watermark.
+     * @param[in] maxDelay      - enter overload when events queueing delay reach max delay(in milli-seconds),
+     *                            0 means not check, leave overload when queueing delay fall to half of max delay.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOverloadProtection(int policy,
+                                      size_t highWatermark,
+                                      size_t lowWatermark = 0,
+                                      int maxDelay = 0) = 0;
+
+    /**
+     * Check service is overloaded or not.
+     * @return bool - return true if overloaded, otherwise return false.
+     */
+    virtual bool IsOverloaded() const = 0;
+
+    /**
+     * Get shed packets count(ShedLowPriority overload policy), since service created.
+     * @return uint64 - the shed packets count.
+     */
+    virtual uint64 GetShedPacketCount() const = 0;
+
+    /**
+     * Start inbound packets capture, every received packet(session Id, opcode, status, payload and
+     * monotonic timestamp) will be appended to memory-mapped capture file in service thread.
+     * @param[in] filePath - the capture file path, if file exist, will truncate it.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int StartPacketCapture(const LLBC_String &filePath) = 0;
+
+    /**
+     * Stop inbound packets capture, capture file will be closed(service stop will auto stop capture).
+     */
+    virtual void StopPacketCapture() = 0;
+
+    /**
+     * Check inbound packets capturing or not.
+     * @return bool - return true if capturing, otherwise return false.
+     */
+    virtual bool IsPacketCapturing() const = 0;
+
+    /**
+     * Replay packet capture file, the captured packets will be decoded and delivered to handlers through
+     * the normal data arrival path in service thread, keep captured time intervals(scaled by speed).
+     * Note: replayed packets target session must be ready session(eg: local session), otherwise will be discarded.
+     * @param[in] filePath  - the capture file path.
+     * @param[in] speed     - the replay speed, 1.0 means original speed, 2.0 means 2x accelerated,
+     *                        <= 0.0 means as fast as possible(limited by LLBC_CFG_COMM_PACKET_REPLAY_BATCH_SIZE per frame).
+     * @param[in] sessionId - the replay target session Id, 0 means use captured session Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int ReplayPacketCapture(const LLBC_String &filePath, double speed = 1.0, int sessionId = 0) = 0;
+
+    /**
+     * Stop packet capture replay.
+     */
+    virtual void StopPacketReplay() = 0;
+
+    /**
+     * Check packet capture replaying or not.
+     * @return bool - return true if replaying, otherwise return false.
+     */
+    virtual bool IsPacketReplaying() const = 0;
+
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    /**
+     * Enable/Disable per-opcode statistics, default is disabled.
+     * Statistics include received/sent packets count & bytes, decode time and handle time histograms.
+     * @param[in] enabled - the enable flag.
+     */
+    virtual void SetOpcodeStatsEnabled(bool enabled) = 0;
+
+    /**
+     * Check per-opcode statistics enabled or not.
+     * @return bool - return true if enabled, otherwise return false.
+     */
+    virtual bool IsOpcodeStatsEnabled() const = 0;
+
+    /**
+     * Get per-opcode statistics snapshot(thread safe).
+     * @param[out] stats - the opcode statistics, key is opcode.
+     */
+    virtual void GetOpcodeStats(std::map<int, LLBC_OpcodeStat> &stats) const = 0;
+
+    /**
+     * Reset all opcode statistics.
+     */
+    virtual void ResetOpcodeStats() = 0;
+
+    /**
+     * Set opcode statistics periodic dump, statistics will be dumped to logger in service thread.
+     * @param[in] interval       - the dump interval, in milli-seconds, 0 means disable periodic dump.
+     * @param[in] loggerName     - the logger name, nullptr means root logger.
+     * @param[in] resetAfterDump - reset statistics after dump or not, default is false.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodeStatsDump(int interval, const char *loggerName = nullptr, bool resetAfterDump = false) = 0;
+
+    /**
+     * Enable/Disable service frame profile, default is disabled.
+     * Profile include frame/phases/components OnUpdate() cost time histograms and budget overrun frames count,
+     * rolled every LLBC_CFG_COMM_FRAME_PROFILE_WINDOW milli-seconds.
+     * @param[in] enabled - the enable flag.
+     */
+    virtual void SetFrameProfileEnabled(bool enabled) = 0;
+
+    /**
+     * Check frame profile enabled or not.
+     * @return bool - return true if enabled, otherwise return false.
+     */
+    virtual bool IsFrameProfileEnabled() const = 0;
+
+    /**
+     * Get frame profile snapshot(thread safe).
+     * @param[out] profile - the frame profile.
+     * @param[in]  current - get current(in progress) window profile or not, default get last completed window profile.
+     */
+    virtual void GetFrameProfile(LLBC_FrameProfile &profile, bool current = false) const = 0;
+
+    /**
+     * Set slow frame handler, handler will be called in service thread when frame profile enabled and
+     * frame cost time overrun budget, slow frame info report which component/timer/opcode is the slowest.
+     * @param[in] handler - the slow frame handler, nullptr means no handler.
+     * @param[in] budget  - the frame budget, in milli-seconds, 0 means use frame interval.
+     */
+    virtual void SetSlowFrameHandler(const LLBC_Delegate<void(const LLBC_SlowFrameInfo &)> &handler, int budget = 0) = 0;
+
+    /**
+     * Enable/Disable service & pollers event queue statistics, default is disabled.
+     * If enabled, every queued event will be timestamped, statistics include enqueue/dequeue/wakeup counts & rates,
+     * max queue depth and queue time histogram.
+     * @param[in] enabled - the enable flag.
+     */
+    virtual void SetQueueStatsEnabled(bool enabled) = 0;
+
+    /**
+     * Check event queue statistics enabled or not.
+     * @return bool - return true if enabled, otherwise return false.
+     */
+    virtual bool IsQueueStatsEnabled() const = 0;
+
+    /**
+     * Get event queue statistics snapshot(thread safe).
+     * @param[out] svcStat     - the service queue statistics.
+     * @param[out] pollerStats - the pollers queue statistics, index is poller index.
+     */
+    virtual void GetQueueStats(LLBC_QueueStat &svcStat, std::vector<LLBC_QueueStat> &pollerStats) const = 0;
+
+    /**
+     * Reset service & pollers event queue statistics.
+     */
+    virtual void ResetQueueStats() = 0;
+
+    /**
+     * Set event queue statistics periodic dump, statistics will be dumped to logger in service thread.
+     * @param[in] interval       - the dump interval, in milli-seconds, 0 means disable periodic dump.
+     * @param[in] loggerName     - the logger name, nullptr means root logger.
+     * @param[in] resetAfterDump - reset statistics after dump or not, default is false.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetQueueStatsDump(int interval, const char *loggerName = nullptr, bool resetAfterDump = false) = 0;
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 public:
     /**
      * Add component by component class or pointer.
@@ -444,6 +942,18 @@ public:
      */
     virtual int Subscribe(int opcode, const LLBC_Delegate<void(LLBC_Packet &)> &deleg) = 0;
 
+    /**
+     * Subscribe message to specified handler method, handler will run in coroutine.
+     */
+    template <typename ObjType>
+    int SubscribeCoro(int opcode, ObjType *obj, void (ObjType::*method)(LLBC_Packet &));
+
+    /**
+     * Subscribe message to specified delegate, handler will run in coroutine(could yield by CoroSleep()/
+     * CoroCall()/YieldCoro()), packet will be kept until handler returned.
+     */
+    virtual int SubscribeCoro(int opcode, const LLBC_Delegate<void(LLBC_Packet &)> &deleg) = 0;
+
     /**
      * Previous subscribe message to specified handler method, if method return false, will stop packet process flow.
      */
@@ -67,6 +67,8 @@ public:
 struct LLBC_HIDDEN LLBC_ServiceEvent
 {
     int type;
+    sint64 enqueueTime; // Enqueue time(in micro-seconds), only available when service queue statistics
+                        // or overload queueing delay checking enabled.
 
     LLBC_ServiceEvent(int evType);
     virtual ~LLBC_ServiceEvent() = default;
@@ -29,6 +29,7 @@ __LLBC_NS_BEGIN
 
 inline LLBC_ServiceEvent::LLBC_ServiceEvent(int type)
 : type(type)
+, enqueueTime(0)
 {
 }
 
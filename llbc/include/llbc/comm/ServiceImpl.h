@@ -26,6 +26,7 @@
 #include "llbc/comm/ServiceEvent.h"
 #include "llbc/comm/ServiceEventFirer.h"
 #include "llbc/comm/PollerMgr.h"
+#include "llbc/comm/PacketCapture.h"
 #include "llbc/comm/protocol/ProtocolStack.h"
 
 __LLBC_NS_BEGIN
@@ -97,6 +98,12 @@ public:
      */
     virtual bool IsFullStack() const;
 
+    /**
+     * Get/Set decode offload option, see LLBC_Service.
+     */
+    virtual bool IsDecodeOffload() const;
+    virtual int SetDecodeOffload(bool decodeOffload);
+
     /**
      * Get the service drive mode.
      * @return DriveMode - the service drive mode.
@@ -212,6 +219,39 @@ public:
                           LLBC_IProtocolFactory *protoFactory = nullptr,
                           const LLBC_SessionOpts &sessionOpts = LLBC_DftSessionOpts);
 
+    /**
+     * Establishes an in-process loopback session to another service, no socket will be created.
+     * @param[in] otherSvc - the peer service, must not be self.
+     * @return int - the new session Id(in this service), if return 0 means failed, see LLBC_GetLastError().
+     */
+    virtual int ConnectLocal(LLBC_Service *otherSvc);
+
+    /**
+     * Create a datagram(UDP) session and listening.
+     * @param[in] ip           - the ip address.
+     * @param[in] port         - the port number.
+     * @param[in] protoFactory - the protocol factory, default use LLBC_DatagramProtocolFactory.
+     * @param[in] sessionOpts  - the session options.
+     * @return int - the new session Id, if return 0, means failed, see LLBC_GetLastError().
+     */
+    virtual int ListenUdp(const char *ip,
+                          uint16 port,
+                          LLBC_IProtocolFactory *protoFactory = nullptr,
+                          const LLBC_SessionOpts &sessionOpts = LLBC_DftSessionOpts);
+
+    /**
+     * Create a connected datagram(UDP) session to a specified address.
+     * @param[in] ip           - the ip address.
+     * @param[in] port         - the port number.
+     * @param[in] protoFactory - the protocol factory, default use LLBC_DatagramProtocolFactory.
+     * @param[in] sessionOpts  - the session options.
+     * @return int - the new session Id, if return 0, means failed, see LLBC_GetLastError().
+     */
+    virtual int ConnectUdp(const char *ip,
+                           uint16 port,
+                           LLBC_IProtocolFactory *protoFactory = nullptr,
+                           const LLBC_SessionOpts &sessionOpts = LLBC_DftSessionOpts);
+
     /**
      * Check given sessionId is legal or not.
      * @param[in] sessionId - the given session Id.
@@ -230,6 +270,18 @@ public:
      */
     virtual int Send(LLBC_Packet *packet);
 
+    /**
+     * Send file region(bulk transfer), see LLBC_Service::SendFile().
+     * @param[in] sessionId - the session Id.
+     * @param[in] opcode    - the opcode.
+     * @param[in] fd        - the file descriptor.
+     * @param[in] offset    - the file region offset.
+     * @param[in] length    - the file region length, in bytes.
+     * @param[in] status    - the status.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SendFile(int sessionId, int opcode, int fd, sint64 offset, size_t length, int status);
+
     /** 
      * Multicast data(these methods will automatics create packet to send).
      * Note: 
@@ -282,6 +334,69 @@ public:
      */
     virtual int Broadcast(int svcId, int opcode, const void *bytes, size_t len, int status);
 
+    /**
+     * Asynchronous rpc call, many in-flight calls per session are allowed(pipelined).
+     * @param[in] packet   - the request packet.
+     * @param[in] callback - the call callback.
+     * @param[in] timeout  - the call timeout, in milli-seconds, <= 0 means use LLBC_CFG_COMM_DFT_RPC_TIMEOUT.
+     * @return sint64 - the call Id, if return 0 means failed, see LLBC_GetLastError().
+     */
+    virtual sint64 Call(LLBC_Packet *packet,
+                        const LLBC_Delegate<void(const LLBC_RpcResult &)> &callback,
+                        int timeout = 0);
+
+    /**
+     * Cancel rpc call, the call callback will not be called.
+     * @param[in] callId - the call Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int CancelCall(sint64 callId);
+
+    /**
+     * Get in-flight rpc calls count.
+     * @return size_t - the in-flight rpc calls count.
+     */
+    virtual size_t GetPendingCallCount() const;
+
+    /**
+     * Create stackful coroutine and run it immediately until it yield or finished.
+     * @param[in] entry - the coroutine entry.
+     * @return sint64 - the coroutine Id, if return 0 means failed, see LLBC_GetLastError().
+     */
+    virtual sint64 Go(const LLBC_Delegate<void()> &entry);
+
+    /**
+     * Get current running coroutine Id.
+     * @return sint64 - the coroutine Id, return 0 if not running in coroutine.
+     */
+    virtual sint64 GetCurrentCoroId() const;
+
+    /**
+     * Get alive(running or suspended) coroutines count.
+     * @return size_t - the alive coroutines count.
+     */
+    virtual size_t GetCoroCount() const;
+
+    /**
+     * Suspend current coroutine until ResumeCoro() called.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int YieldCoro();
+
+    /**
+     * Resume suspended coroutine.
+     * @param[in] coroId - the coroutine Id.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int ResumeCoro(sint64 coroId);
+
+    /**
+     * Suspend current coroutine specific milli-seconds.
+     * @param[in] milliseconds - the sleep time, in milli-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int CoroSleep(int milliseconds);
+
     /**
      * Remove session, always success.
      * @param[in] sessionId - the will close session Id.
@@ -301,6 +416,148 @@ public:
                                   int ctrlCmd,
                                   const LLBC_Variant &ctrlData);
 
+    /**
+     * Set poller place policy.
+     * @param[in] policy - the place policy, see LLBC_PollerPlacePolicy.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPollerPlacePolicy(int policy);
+
+    /**
+     * Migrate session to specific poller(asynchronous).
+     * @param[in] sessionId - the session Id.
+     * @param[in] pollerIdx - the target poller index.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int MigrateSession(int sessionId, int pollerIdx);
+
+    /**
+     * Get service poller count.
+     * @return int - the poller count.
+     */
+    virtual int GetPollerCount() const;
+
+    /**
+     * Change service poller count at runtime.
+     * @param[in] pollerCount - the new poller count.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPollerCount(int pollerCount);
+
+    /**
+     * Get/Set service poller model, must be called before service start.
+     * @param[in] pollerModel - the poller model.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual const LLBC_String &GetPollerModel() const;
+    virtual int SetPollerModel(const LLBC_String &pollerModel);
+
+    /**
+     * Set service thread name/cpu affinity, must be called before service start.
+     * @param[in] threadName - the thread name.
+     * @param[in] cpuMask    - the cpu mask.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetThreadName(const LLBC_String &threadName);
+    virtual int SetCPUAffinity(uint64 cpuMask);
+
+    /**
+     * Set service poller threads name prefix/cpu affinity, must be called before service start.
+     * @param[in] namePrefix - the poller thread name prefix.
+     * @param[in] cpuMask    - the cpu mask.
+     * @param[in] spread     - the cpu spread flag.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPollerThreadName(const LLBC_String &namePrefix);
+    virtual int SetPollerCPUAffinity(uint64 cpuMask, bool spread = false);
+
+    /**
+     * Get/Set service pollers busy poll window.
+     * @param[in] busyPollWindow - the busy poll window, in micro-seconds, 0 means disable busy poll mode.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int GetPollerBusyPoll() const;
+    virtual int SetPollerBusyPoll(int busyPollWindow);
+
+    /**
+     * Set opcode/session packet priority.
+     * @param[in] opcode    - the opcode.
+     * @param[in] sessionId - the session Id.
+     * @param[in] priority  - the packet priority, End means remove priority setting.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetOpcodePriority(int opcode, int priority);
+    virtual int SetSessionPriority(int sessionId, int priority);
+
+    /**
+     * Set per-frame packet handle budget of given priority.
+     * @param[in] priority - the packet priority.
+     * @param[in] budget   - max handle packets count per frame, 0 means unlimited.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SetPriorityBudget(int priority, int budget);
+
+    /**
+     * Get pending packets count of given priority.
+     * @param[in] priority - the packet priority.
+     * @return size_t - the pending packets count.
+     */
+    virtual size_t GetPendingPacketCount(int priority) const;
+
+    /**
+     * Overload protection about methods, see LLBC_Service.
+     */
+    virtual int SetOverloadProtection(int policy, size_t highWatermark, size_t lowWatermark = 0, int maxDelay = 0);
+    virtual bool IsOverloaded() const;
+    virtual uint64 GetShedPacketCount() const;
+
+    /**
+     * Packet capture & replay about methods, see LLBC_Service.
+     */
+    virtual int StartPacketCapture(const LLBC_String &filePath);
+    virtual void StopPacketCapture();
+    virtual bool IsPacketCapturing() const;
+    virtual int ReplayPacketCapture(const LLBC_String &filePath, double speed = 1.0, int sessionId = 0);
+    virtual void StopPacketReplay();
+    virtual bool IsPacketReplaying() const;
+
+    /**
+     * Push service event block.
+     * Note: - Stamp event enqueue time if queue statistics enabled or overload queueing delay checking enabled.
+     *       - Shed low priority packets if overloaded, and check overload queue depth.
+     * @param[in] block - the service event block.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Push(LLBC_MessageBlock *block);
+
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    /**
+     * Per-opcode statistics about methods, see LLBC_Service.
+     */
+    virtual void SetOpcodeStatsEnabled(bool enabled);
+    virtual bool IsOpcodeStatsEnabled() const;
+    virtual void GetOpcodeStats(std::map<int, LLBC_OpcodeStat> &stats) const;
+    virtual void ResetOpcodeStats();
+    virtual int SetOpcodeStatsDump(int interval, const char *loggerName = nullptr, bool resetAfterDump = false);
+
+    /**
+     * Frame profile about methods, see LLBC_Service.
+     */
+    virtual void SetFrameProfileEnabled(bool enabled);
+    virtual bool IsFrameProfileEnabled() const;
+    virtual void GetFrameProfile(LLBC_FrameProfile &profile, bool current = false) const;
+    virtual void SetSlowFrameHandler(const LLBC_Delegate<void(const LLBC_SlowFrameInfo &)> &handler, int budget = 0);
+
+    /**
+     * Event queue statistics about methods, see LLBC_Service.
+     */
+    virtual void SetQueueStatsEnabled(bool enabled);
+    virtual bool IsQueueStatsEnabled() const;
+    virtual void GetQueueStats(LLBC_QueueStat &svcStat, std::vector<LLBC_QueueStat> &pollerStats) const;
+    virtual void ResetQueueStats();
+    virtual int SetQueueStatsDump(int interval, const char *loggerName = nullptr, bool resetAfterDump = false);
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 public:
     /**
      * Register component.
@@ -336,6 +593,11 @@ public:
      */
     virtual int Subscribe(int opcode, const LLBC_Delegate<void(LLBC_Packet &)> &deleg);
 
+    /**
+     * Subscribe message to specified delegate, handler will run in coroutine.
+     */
+    virtual int SubscribeCoro(int opcode, const LLBC_Delegate<void(LLBC_Packet &)> &deleg);
+
     /**
      * Previous subscribe message to specified delegate, if method return nullptr, will stop packet process flow.
      */
@@ -498,8 +760,18 @@ protected:
      * Ready session operation methods.
      */
     void AddReadySession(int sessionId, int acceptSessionId, bool isListenSession, bool repeatCheck = false);
-    void RemoveReadySession(int sessionId);
+    bool RemoveReadySession(int sessionId);
     void RemoveAllReadySessions();
+    void DeleteRetiredReadySessions();
+
+    /**
+     * Local(in-process loopback) session operation methods.
+     */
+    void AddLocalReadySession(int sessionId, This *peerSvc, int peerSessionId);
+    int SendToLocalPeer(This *peerSvc, int peerSessionId, LLBC_Packet *packet);
+    void PushLocalSessionCreateEv(int sessionId);
+    void PushLocalSessionDestroyEv(int sessionId, LLBC_SessionCloseInfo *closeInfo);
+    void CloseAllLocalSessions();
 
 protected:
     /**
@@ -517,6 +789,12 @@ private:
      * Service config operation methods.
      */
     void UpdateServiceCfg(LLBC_SvcEv_AppCfgReloadedEv *ev = nullptr);
+    LLBC_String GetServiceCfgValue(const char *key) const;
+
+    /**
+     * Apply service/poller threads name, cpu affinity and poller busy poll window(api settings first, then service config).
+     */
+    void ApplyThreadCfg();
 
     /**
      * Service TLS operation methods.
@@ -536,6 +814,7 @@ private:
      * Queued event operation methods.
      */
     void HandleQueuedEvents();
+    void HandleQueuedEvent(LLBC_MessageBlock *block);
     void HandleEv_SessionCreate(LLBC_ServiceEvent &ev);
     void HandleEv_SessionDestroy(LLBC_ServiceEvent &ev);
     void HandleEv_AsyncConnResult(LLBC_ServiceEvent &ev);
@@ -547,6 +826,48 @@ private:
     void HandleEv_AppPhaseEv(LLBC_ServiceEvent &ev);
     void HandleEv_AppCfgReload(LLBC_ServiceEvent &ev);
 
+    /**
+     * Priority lanes operation methods.
+     */
+    void DispatchQueuedEvent(LLBC_MessageBlock *block);
+    int GetPacketPriority(const LLBC_Packet *packet);
+    void HandlePriorityLanes(bool ignoreBudget);
+    void FlushSessionPendingPackets(int sessionId);
+    void ClearPriorityLanes();
+
+    /**
+     * Overload protection operation methods.
+     * Note: Enter/LeaveOverload() must be called with overload lock held.
+     */
+    bool ShedOverloadPacket(LLBC_MessageBlock *block);
+    void CheckOverload(LLBC_MessageBlock *blocks);
+    void EnterOverload(size_t queueDepth, sint64 queueDelay);
+    void LeaveOverload(size_t queueDepth, sint64 queueDelay);
+    void NotifyOverloadChanged();
+    void ResetOverload();
+
+    /**
+     * Rpc call operation methods.
+     */
+    void OnRpcCallTimeout(LLBC_Timer *timer);
+    bool FinishRpcCall(sint64 callId, int rpcStatus, LLBC_Packet *response);
+    void FinishSessionRpcCalls(int sessionId, int rpcStatus);
+    void FinishAllRpcCalls(int rpcStatus);
+
+    /**
+     * Coroutine operation methods.
+     */
+    int RunCoro(sint64 coroId, LLBC_Coro *coro);
+    void ResumeReadyCoros();
+    void StopAllCoros();
+
+    /**
+     * Packet capture & replay operation methods.
+     */
+    void CapturePacket(const LLBC_Packet &packet);
+    void UpdatePacketReplay();
+    void ReplayPacket(const LLBC_PacketCaptureRecord &record);
+
     /**
      * Component operation methods.
      */
@@ -577,6 +898,31 @@ private:
     void UpdateObjectPools();
     void ClearHoldedObjectPools();
 
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    /**
+     * Opcode statistics operation methods.
+     * Note: decodeTime < 0 means packet not decode in service.
+     */
+    void StatRecvPacket(int opcode, size_t bytes, sint64 decodeTime, sint64 handleTime);
+    void StatSendPacket(LLBC_Packet *packet);
+    void UpdateOpcodeStatsDump();
+
+    /**
+     * Frame profile about methods.
+     * Note: EndFramePhase() accumulate the time elapsed since last phase end to given phase.
+     */
+    void BeginFrameProfile();
+    void EndFramePhase(int phase);
+    void ProfileHandledPacket(int opcode, sint64 handleTime);
+    void EndFrameProfile();
+
+    /**
+     * Event queue statistics about methods.
+     */
+    void StatDequeuedEvents(LLBC_MessageBlock *blocks);
+    void UpdateQueueStatsDump();
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
     /**
      * Timer-Scheduler operation methods.
      */
@@ -625,6 +971,7 @@ private:
     LLBC_Variant _nonPropCfg;
 
     bool _fullStack;
+    bool _decodeOffload;
     LLBC_IProtocolFactory *_dftProtocolFactory;
     std::map<int, LLBC_IProtocolFactory *> _sessionProtoFactory;
     DriveMode _driveMode;
@@ -647,6 +994,13 @@ private:
 
 private:
     LLBC_PollerMgr _pollerMgr;
+    bool _pollerModelSet;
+
+    LLBC_String _svcThreadName;
+    uint64 _svcCPUMask;
+    LLBC_String _pollerThreadName;
+    uint64 _pollerCPUMask;
+    bool _pollerCPUSpread;
 
     class _ReadySessionInfo
     {
@@ -656,6 +1010,11 @@ private:
         bool isListenSession;
         LLBC_ProtocolStack *codecStack;
 
+        This *localPeerSvc; // Only available in local session.
+        int localPeerSessionId;
+
+        LLBC_SessionInfo sessionInfo; // Received packets resolve addresses from it.
+
     public:
         _ReadySessionInfo(int sessionId,
                           int acceptSessionId,
@@ -664,7 +1023,60 @@ private:
         ~_ReadySessionInfo();
     };
     std::map<int, _ReadySessionInfo *> _readySessionInfos;
+    std::vector<_ReadySessionInfo *> _retiredReadySessionInfos; // Delay delete, packet may still reference it.
     LLBC_SpinLock _readySessionInfosLock;
+    volatile int _localSessionCount;
+
+    volatile bool _priorityLanesEnabled;
+    std::map<int, int> _opcodePriorities;
+    std::map<int, int> _sessionPriorities;
+    LLBC_SpinLock _priorityLock;
+    volatile int _priorityBudgets[LLBC_PacketPriority::End];
+    std::deque<LLBC_MessageBlock *> _priorityLanes[LLBC_PacketPriority::End];
+    volatile size_t _priorityLaneSizes[LLBC_PacketPriority::End];
+
+    volatile int _overloadPolicy;
+    volatile size_t _overloadHighWatermark;
+    size_t _overloadLowWatermark;
+    volatile int _overloadMaxDelay;
+    volatile bool _overloaded;
+    sint64 _overloadBeginTime;
+    volatile uint64 _shedPacketCount;
+    uint64 _overloadBeginShedCount;
+    volatile bool _overloadChanged;
+    std::vector<LLBC_OverloadInfo> _pendingOverloadInfos;
+    mutable LLBC_SpinLock _overloadLock;
+
+    volatile bool _packetCapturing;
+    LLBC_PacketCaptureWriter *_captureWriter;
+    LLBC_SpinLock _captureLock;
+
+    volatile bool _packetReplaying;
+    LLBC_PacketCaptureReader *_replayReader;
+    double _replaySpeed;
+    int _replaySessionId;
+    LLBC_CPUTime _replayBeginTime;
+    LLBC_PacketCaptureRecord _replayRecord;
+    bool _replayRecordPending;
+    LLBC_SpinLock _replayLock;
+
+    struct _RpcCall
+    {
+        int sessionId;
+        int opcode;
+        sint64 beginTime;
+        LLBC_Timer *timer;
+        LLBC_Delegate<void(const LLBC_RpcResult &)> callback;
+    };
+    sint64 _maxRpcCallId;
+    std::map<sint64, _RpcCall> _rpcCalls;
+
+    sint64 _maxCoroId;
+    sint64 _curCoroId;
+    bool _corosStopping;
+    LLBC_CoroStackPool _coroStackPool;
+    std::map<sint64, LLBC_Coro *> _coros;
+    std::vector<sint64> _readyCoros;
 
     std::list<LLBC_Component *> _willRegComps;
     volatile bool _compsInitFinished;
@@ -678,6 +1090,7 @@ private:
     std::map<LLBC_String, LLBC_Library *> _compLibraries;
     std::map<int, LLBC_CoderFactory *> _coders;
     std::map<int, LLBC_Delegate<void(LLBC_Packet &)> > _handlers;
+    std::map<int, LLBC_Delegate<void(LLBC_Packet &)> > _coroHandlers;
     std::map<int, LLBC_Delegate<bool(LLBC_Packet &)> > _preHandlers;
     #if LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
     LLBC_Delegate<bool(LLBC_Packet &)> _unifyPreHandler;
@@ -716,6 +1129,37 @@ private:
 private:
     std::vector<LLBC_Packet *> _multicastOtherPackets;
 
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+private:
+    volatile bool _opcodeStatsEnabled;
+    std::map<int, LLBC_OpcodeStat> _opcodeStats;
+    mutable LLBC_SpinLock _opcodeStatsLock;
+    int _opcodeStatsDumpInterval;
+    LLBC_String _opcodeStatsDumpLogger;
+    bool _resetOpcodeStatsAfterDump;
+    sint64 _lastOpcodeStatsDumpTime;
+
+    volatile bool _frameProfileEnabled;
+    bool _profilingFrame;
+    LLBC_CPUTime _framePhaseBegTime;
+    LLBC_SlowFrameInfo _curFrameInfo;
+    std::vector<sint64> _curFrameCompTimes;
+    std::vector<LLBC_String> _updateCompNames;
+    LLBC_FrameProfile _frameProfile;
+    LLBC_FrameProfile _lastFrameProfile;
+    mutable LLBC_SpinLock _frameProfileLock;
+    LLBC_Delegate<void(const LLBC_SlowFrameInfo &)> _slowFrameHandler;
+    int _slowFrameBudget;
+
+    volatile bool _queueStatsEnabled;
+    LLBC_QueueStat _queueStat;
+    mutable LLBC_SpinLock _queueStatLock;
+    int _queueStatsDumpInterval;
+    LLBC_String _queueStatsDumpLogger;
+    bool _resetQueueStatsAfterDump;
+    sint64 _lastQueueStatsDumpTime;
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 private:
     typedef void (LLBC_ServiceImpl::*_EvHandler)(LLBC_ServiceEvent &);
     static _EvHandler _evHandlers[LLBC_ServiceEventType::End];
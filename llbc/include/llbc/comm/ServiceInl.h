@@ -269,12 +269,148 @@ inline int LLBC_Service::Broadcast(int opcode, const void *bytes, size_t len, in
     return Broadcast(0, opcode, bytes, len, status);
 }
 
+inline sint64 LLBC_Service::Call(int sessionId,
+                                 int opcode,
+                                 LLBC_Coder *coder,
+                                 const LLBC_Delegate<void(const LLBC_RpcResult &)> &callback,
+                                 int timeout)
+{
+    LLBC_Packet *packet = GetPacketObjectPool().GetObject();
+    packet->SetEncoder(coder);
+    packet->SetHeader(sessionId, opcode, 0);
+
+    return Call(packet, callback, timeout);
+}
+
+inline sint64 LLBC_Service::Call(int sessionId,
+                                 int opcode,
+                                 const void *bytes,
+                                 size_t len,
+                                 const LLBC_Delegate<void(const LLBC_RpcResult &)> &callback,
+                                 int timeout)
+{
+    LLBC_Packet *packet = GetPacketObjectPool().GetObject();
+    packet->SetHeader(sessionId, opcode, 0);
+    if (UNLIKELY(packet->Write(bytes, len) != LLBC_OK))
+    {
+        LLBC_Recycle(packet);
+        return 0;
+    }
+
+    return Call(packet, callback, timeout);
+}
+
+inline int LLBC_Service::Reply(const LLBC_Packet &request, int opcode, LLBC_Coder *coder, int status)
+{
+    LLBC_Packet *packet = GetPacketObjectPool().GetObject();
+    packet->SetEncoder(coder);
+    if (UNLIKELY(!request.HasFlags(LLBC_RpcFlags::Request)))
+    {
+        LLBC_Recycle(packet);
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+
+        return LLBC_FAILED;
+    }
+
+    packet->SetHeader(request.GetSenderServiceId(), request.GetSessionId(), opcode, status);
+    packet->SetFlags(LLBC_RpcFlags::Response);
+    packet->SetExtData1(request.GetExtData1());
+
+    return Send(packet);
+}
+
+inline int LLBC_Service::Reply(const LLBC_Packet &request, int opcode, const void *bytes, size_t len, int status)
+{
+    LLBC_SetErrAndReturnIf(!request.HasFlags(LLBC_RpcFlags::Request), LLBC_ERROR_ARG, LLBC_FAILED);
+
+    LLBC_Packet *packet = GetPacketObjectPool().GetObject();
+    packet->SetHeader(request.GetSenderServiceId(), request.GetSessionId(), opcode, status);
+    packet->SetFlags(LLBC_RpcFlags::Response);
+    packet->SetExtData1(request.GetExtData1());
+    if (UNLIKELY(packet->Write(bytes, len) != LLBC_OK))
+    {
+        LLBC_Recycle(packet);
+        return LLBC_FAILED;
+    }
+
+    return Send(packet);
+}
+
+inline int LLBC_Service::CoroCall(int sessionId, int opcode, LLBC_Coder *coder, LLBC_RpcResult &result, int timeout)
+{
+    LLBC_Packet *packet = GetPacketObjectPool().GetObject();
+    packet->SetEncoder(coder);
+    packet->SetHeader(sessionId, opcode, 0);
+
+    return CoroCall(packet, result, timeout);
+}
+
+inline int LLBC_Service::CoroCall(int sessionId,
+                                  int opcode,
+                                  const void *bytes,
+                                  size_t len,
+                                  LLBC_RpcResult &result,
+                                  int timeout)
+{
+    LLBC_Packet *packet = GetPacketObjectPool().GetObject();
+    packet->SetHeader(sessionId, opcode, 0);
+    if (UNLIKELY(packet->Write(bytes, len) != LLBC_OK))
+    {
+        LLBC_Recycle(packet);
+        return LLBC_FAILED;
+    }
+
+    return CoroCall(packet, result, timeout);
+}
+
+inline int LLBC_Service::CoroCall(LLBC_Packet *packet, LLBC_RpcResult &result, int timeout)
+{
+    const sint64 coroId = GetCurrentCoroId();
+    if (UNLIKELY(coroId == 0))
+    {
+        LLBC_Recycle(packet);
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+
+        return LLBC_FAILED;
+    }
+
+    // Call callback always called out of coroutine, resume immediately, response still available.
+    bool finished = false;
+    const sint64 callId = Call(packet,
+                               [this, coroId, &result, &finished](const LLBC_RpcResult &callResult) {
+                                   result = callResult;
+                                   finished = true;
+                                   ResumeCoro(coroId);
+                               },
+                               timeout);
+    if (callId == 0)
+        return LLBC_FAILED;
+
+    // Ignore unrelated resumes, until call finished.
+    while (!finished)
+    {
+        if (YieldCoro() != LLBC_OK && !finished)
+        {
+            CancelCall(callId);
+            return LLBC_FAILED;
+        }
+    }
+
+    return LLBC_OK;
+}
+
 template <typename ObjType>
 inline int LLBC_Service::Subscribe(int opcode, ObjType *obj, void (ObjType::*method)(LLBC_Packet &))
 {
     return Subscribe(opcode, LLBC_Delegate<void(LLBC_Packet &)>(obj, method));
 }
 
+template <typename ObjType>
+inline int LLBC_Service::SubscribeCoro(int opcode, ObjType *obj, void (ObjType::*method)(LLBC_Packet &))
+{
+    return SubscribeCoro(opcode, LLBC_Delegate<void(LLBC_Packet &)>(obj, method));
+}
+
 inline int LLBC_Service::PreSubscribe(int opcode, bool (*func)(LLBC_Packet &))
 {
     return PreSubscribe(opcode, LLBC_Delegate<bool(LLBC_Packet &)>(func));
@@ -33,6 +33,7 @@ class LLBC_Socket;
 class LLBC_Service;
 class LLBC_BasePoller;
 class LLBC_ProtocolStack;
+struct LLBC_FileRegion;
 
 __LLBC_NS_END
 
@@ -199,6 +200,31 @@ public:
      */
     void SetPoller(LLBC_BasePoller *poller);
 
+    /**
+     * Get the last active(data sent or received) time.
+     * @return sint64 - the last active time, in milli-seconds.
+     */
+    sint64 GetLastActiveTime() const;
+
+    /**
+     * Get the last data received time.
+     * @return sint64 - the last recv time, in milli-seconds.
+     */
+    sint64 GetLastRecvTime() const;
+
+    /**
+     * Get the last data sent time.
+     * @return sint64 - the last send time, in milli-seconds.
+     */
+    sint64 GetLastSendTime() const;
+
+    /**
+     * Get/Set the idle check deadline, use by poller idle wheel to identify stale wheel entries.
+     * @param[in] idleDeadline - the idle check deadline, in milli-seconds, 0 means not in idle wheel.
+     */
+    sint64 GetIdleDeadline() const;
+    void SetIdleDeadline(sint64 idleDeadline);
+
 public:
     /**
      * @Send packet.
@@ -216,6 +242,24 @@ public:
      */
     int Send(LLBC_MessageBlock *block);
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    /**
+     * Send file region, if protocol stack has no transforming layers, send header packet first and then
+     * send file region by sendfile(), otherwise read file region to header packet payload and send it.
+     * Note: 
+     *       No matter method call success or not, method will steal <fileRegion> the parameter.
+     * @param[in] fileRegion - the file region.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SendFile(LLBC_FileRegion *fileRegion);
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+    /**
+     * Send heartbeat packet(marked LLBC_CFG_COMM_HEARTBEAT_PACKET_FLAG), call by poller.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SendHeartbeat();
+
 public:
     /**
      * Send event handler method, call by poller.
@@ -263,6 +307,11 @@ public:
      */
     bool OnRecved(LLBC_MessageBlock *block, bool &sessionRemoved);
 
+    /**
+     * Recv budget exhausted event handler method, call by socket, socket maybe still has data to read.
+     */
+    void OnRecvBudgetExhausted();
+
 public:
     /**
      * Control session protocol stack.
@@ -283,6 +332,7 @@ private:
     LLBC_SocketHandle _sockHandle;
 
     bool _fullStack;
+    bool _decodeOffload;
     LLBC_Service *_svc;
     LLBC_BasePoller *_poller;
 
@@ -290,6 +340,9 @@ private:
     std::vector<LLBC_Packet *> _recvedPackets;
 
     int _pollerType;
+    sint64 _lastRecvTime;
+    sint64 _lastSendTime;
+    sint64 _idleDeadline;
 };
 
 __LLBC_NS_END
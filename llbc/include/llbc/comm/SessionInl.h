@@ -103,4 +103,29 @@ inline void LLBC_Session::SetPoller(LLBC_BasePoller *poller)
     _poller = poller;
 }
 
+inline sint64 LLBC_Session::GetLastActiveTime() const
+{
+    return MAX(_lastRecvTime, _lastSendTime);
+}
+
+inline sint64 LLBC_Session::GetLastRecvTime() const
+{
+    return _lastRecvTime;
+}
+
+inline sint64 LLBC_Session::GetLastSendTime() const
+{
+    return _lastSendTime;
+}
+
+inline sint64 LLBC_Session::GetIdleDeadline() const
+{
+    return _idleDeadline;
+}
+
+inline void LLBC_Session::SetIdleDeadline(sint64 idleDeadline)
+{
+    _idleDeadline = idleDeadline;
+}
+
 __LLBC_NS_END
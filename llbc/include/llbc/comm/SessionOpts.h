@@ -122,6 +122,88 @@ public:
      */
     void SetMaxPacketSize(size_t size);
 
+public:
+    /**
+     * Get session recv budget.
+     * @return size_t - the recv budget, in bytes.
+     */
+    size_t GetRecvBudget() const;
+
+    /**
+     * Set session recv budget, max bytes read from session in one poller wakeup.
+     * @param[in] recvBudget - the recv budget, in bytes, 0 means unlimited.
+     */
+    void SetRecvBudget(size_t recvBudget);
+
+public:
+    /**
+     * Get socket busy poll option(SO_BUSY_POLL).
+     * @return int - the socket busy poll time, in micro-seconds.
+     */
+    int GetSockBusyPoll() const;
+
+    /**
+     * Set socket busy poll option(SO_BUSY_POLL), Linux specific.
+     * Note:
+     *      If not set, the session will use service poller busy poll window(if enabled).
+     * @param[in] sockBusyPoll - the socket busy poll time, in micro-seconds, 0 means not set.
+     */
+    void SetSockBusyPoll(int sockBusyPoll);
+
+public:
+    /**
+     * Get pinned poller index.
+     * @return int - the pinned poller index, -1 means not pinned.
+     */
+    int GetPinnedPoller() const;
+
+    /**
+     * Set pinned poller index, pinned session always placed to pinned poller and never be migrated.
+     * Note:
+     *      If the index out of poller count range, will be ignored(use service place policy).
+     * @param[in] pollerIdx - the poller index, -1 means not pinned.
+     */
+    void SetPinnedPoller(int pollerIdx);
+
+public:
+    /**
+     * Get read idle timeout.
+     * @return int - the read idle timeout, in milli-seconds.
+     */
+    int GetReadIdleTimeout() const;
+
+    /**
+     * Set read idle timeout, if no data received in this time, session will be closed by poller.
+     * @param[in] readIdleTimeout - the read idle timeout, in milli-seconds, 0 means disabled.
+     */
+    void SetReadIdleTimeout(int readIdleTimeout);
+
+    /**
+     * Get write idle timeout.
+     * @return int - the write idle timeout, in milli-seconds.
+     */
+    int GetWriteIdleTimeout() const;
+
+    /**
+     * Set write idle timeout, if no data sent in this time and auto heartbeat enabled,
+     * poller will send heartbeat packet to peer.
+     * @param[in] writeIdleTimeout - the write idle timeout, in milli-seconds, 0 means disabled.
+     */
+    void SetWriteIdleTimeout(int writeIdleTimeout);
+
+    /**
+     * Get auto heartbeat option.
+     * @return bool - the auto heartbeat option.
+     */
+    bool IsAutoHeartbeat() const;
+
+    /**
+     * Set auto heartbeat option, heartbeat packet marked LLBC_CFG_COMM_HEARTBEAT_PACKET_FLAG,
+     * will be consumed by peer poller(refresh peer read idle time), not dispatch to service.
+     * @param[in] autoHeartbeat - the auto heartbeat option.
+     */
+    void SetAutoHeartbeat(bool autoHeartbeat);
+
 public:
     /**
      * operator ==
@@ -135,6 +217,12 @@ private:
     size_t _sessionSendBufSize; // session send buffer size, in bytes, default is LLBC_CFG_COMM_DFT_SESSION_SEND_BUF_SIZE
     size_t _sessionRecvBufSize; // session recv buffer size(init size), in bytes, default is LLBC_CFG_COMM_DFT_SESSION_RECV_BUF_SIZE.
     size_t _maxPacketSize; // max packet seize in packet protocol
+    size_t _recvBudget; // recv budget per poller wakeup, in bytes, default is LLBC_CFG_COMM_DFT_SESSION_RECV_BUDGET.
+    int _pinnedPoller; // pinned poller index, default is -1, it means not pinned.
+    int _sockBusyPoll; // socket busy poll time, in micro-seconds, default is 0, it means not set.
+    int _readIdleTimeout; // read idle timeout, in milli-seconds, default is 0, it means disabled.
+    int _writeIdleTimeout; // write idle timeout, in milli-seconds, default is 0, it means disabled.
+    bool _autoHeartbeat; // auto heartbeat when write idle, default is false.
 };
 
 __LLBC_NS_END
@@ -35,6 +35,12 @@ inline LLBC_SessionOpts::LLBC_SessionOpts(bool noDelay,
 , _sessionSendBufSize(sessionSendBufSize)
 , _sessionRecvBufSize(sessionRecvBufSize)
 , _maxPacketSize(maxPacketSize)
+, _recvBudget(LLBC_CFG_COMM_DFT_SESSION_RECV_BUDGET)
+, _pinnedPoller(-1)
+, _sockBusyPoll(0)
+, _readIdleTimeout(0)
+, _writeIdleTimeout(0)
+, _autoHeartbeat(false)
 {
 }
 
@@ -107,4 +113,64 @@ inline void LLBC_SessionOpts::SetMaxPacketSize(size_t size)
     _maxPacketSize = size;
 }
 
+inline size_t LLBC_SessionOpts::GetRecvBudget() const
+{
+    return _recvBudget;
+}
+
+inline void LLBC_SessionOpts::SetRecvBudget(size_t recvBudget)
+{
+    _recvBudget = recvBudget;
+}
+
+inline int LLBC_SessionOpts::GetPinnedPoller() const
+{
+    return _pinnedPoller;
+}
+
+inline void LLBC_SessionOpts::SetPinnedPoller(int pollerIdx)
+{
+    _pinnedPoller = pollerIdx;
+}
+
+inline int LLBC_SessionOpts::GetSockBusyPoll() const
+{
+    return _sockBusyPoll;
+}
+
+inline void LLBC_SessionOpts::SetSockBusyPoll(int sockBusyPoll)
+{
+    _sockBusyPoll = MAX(0, sockBusyPoll);
+}
+
+inline int LLBC_SessionOpts::GetReadIdleTimeout() const
+{
+    return _readIdleTimeout;
+}
+
+inline void LLBC_SessionOpts::SetReadIdleTimeout(int readIdleTimeout)
+{
+    _readIdleTimeout = MAX(0, readIdleTimeout);
+}
+
+inline int LLBC_SessionOpts::GetWriteIdleTimeout() const
+{
+    return _writeIdleTimeout;
+}
+
+inline void LLBC_SessionOpts::SetWriteIdleTimeout(int writeIdleTimeout)
+{
+    _writeIdleTimeout = MAX(0, writeIdleTimeout);
+}
+
+inline bool LLBC_SessionOpts::IsAutoHeartbeat() const
+{
+    return _autoHeartbeat;
+}
+
+inline void LLBC_SessionOpts::SetAutoHeartbeat(bool autoHeartbeat)
+{
+    _autoHeartbeat = autoHeartbeat;
+}
+
 __LLBC_NS_END
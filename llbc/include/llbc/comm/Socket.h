@@ -42,9 +42,10 @@ class LLBC_EXPORT LLBC_Socket
 public:
     /**
      * Parameter constructor, construct socket object.
-     * @param[in] handle - socket handle, if not specific, auto create new socket handler in internal.
+     * @param[in] handle   - socket handle, if not specific, auto create new socket handler in internal.
+     * @param[in] datagram - the datagram(UDP) socket flag, only used when auto create socket handle, default is false.
      */
-    explicit LLBC_Socket(LLBC_SocketHandle handle = LLBC_INVALID_SOCKET_HANDLE);
+    explicit LLBC_Socket(LLBC_SocketHandle handle = LLBC_INVALID_SOCKET_HANDLE, bool datagram = false);
 
     /**
      * Destructor.
@@ -113,6 +114,20 @@ public:
      */
     bool IsClosed() const;
 
+    /**
+     * Determine this socket is datagram(UDP) socket or not.
+     * @return bool - return true if is datagram socket, otherwise return false.
+     */
+    bool IsDatagram() const;
+
+    /**
+     * Determine this socket is shared other socket's handle or not.
+     * Shared handle socket is the datagram peer socket, created by AcceptDatagramPeer() method,
+     * it never close the socket handle.
+     * @return bool - return true if is shared handle socket, otherwise return false.
+     */
+    bool IsSharedHandle() const;
+
     /**
      * Implement bool operator.
      */
@@ -157,6 +172,13 @@ public:
      */
     int SetNoDelay(bool noDelay);
 
+    /**
+     * Set socket busy poll option(SO_BUSY_POLL), Linux specific.
+     * @param[in] busyPoll - the busy poll time, in micro-seconds.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetBusyPoll(int busyPoll);
+
     /**
      * Set socket to non-blocking.
      * @return int - return 0 if success, otherwise return -1.
@@ -252,6 +274,14 @@ public:
      */
     LLBC_Socket *Accept();
 
+    /**
+     * Create a datagram peer socket, the peer socket shared this datagram listen socket's handle,
+     * and all datagrams sent from peer socket will send to the given peer address.
+     * @param[in] peerAddr - the peer address.
+     * @return LLBC_Socket * - the new peer socket, if error occurred, return nullptr.
+     */
+    LLBC_Socket *AcceptDatagramPeer(const LLBC_SockAddr_IN &peerAddr);
+
 #if LLBC_TARGET_PLATFORM_WIN32
     /**
      * WIN32 specific socket method, accept a new connection(asynchronous).
@@ -314,6 +344,25 @@ public:
      */
     int AsyncSend(LLBC_MessageBlock *block);
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    /**
+     * Asynchronous send file region, file region will be sent(by sendfile()) after current will send data.
+     * Note: 
+     *       No matter method call success or not, method will steal <fd> the parameter(closed after sent).
+     * @param[in] fd     - the file descriptor.
+     * @param[in] offset - the file region offset.
+     * @param[in] length - the file region length.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int AsyncSendFile(int fd, sint64 offset, size_t length);
+
+    /**
+     * Get will send file regions total size(not sent bytes).
+     * @return size_t - the will send file regions size.
+     */
+    size_t GetWillSendFilesSize() const;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
     /**
      * Check the socket exist no send data or not.
      * @return bool - return true it means exist data not send.
@@ -334,6 +383,26 @@ public:
      */
     int Recv(char *buf, int len);
 
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    /**
+     * Receive datagrams in batch(use recvmmsg()), datagram socket specific.
+     * Note:
+     *      If the datagram truncated(greater than LLBC_CFG_COMM_UDP_MAX_DATAGRAM_SIZE) or empty,
+     *      the block will set to nullptr.
+     * @param[out] blocks    - the datagram blocks array, caller take the blocks ownership.
+     * @param[out] peerAddrs - the datagram peer address array, can be nullptr.
+     * @param[in]  count     - the arrays size, max is LLBC_CFG_COMM_UDP_BATCH_SIZE.
+     * @return int - return the number of datagrams received, if error occurred, return -1.
+     */
+    int RecvDatagrams(LLBC_MessageBlock **blocks, LLBC_SockAddr_IN *peerAddrs, int count);
+#endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+
+    /**
+     * Get will send datagrams total size, datagram socket specific.
+     * @return size_t - the will send datagrams size.
+     */
+    size_t GetWillSendDatagramsSize() const;
+
 public:
     /**
      * Update the socket's local address.
@@ -469,6 +538,23 @@ private:
     int PostZeroWSARecv();
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    /**
+     * Datagram socket specific send/recv methods.
+     */
+    void OnSendDatagrams();
+    void OnRecvDatagrams();
+#endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    /**
+     * Send the first will send file region until done or would block.
+     * @param[out] totalLen - the total sent bytes, will be increased by the number bytes sent.
+     * @return int - return 0 if file region sent done, otherwise return -1(would block or error occurred).
+     */
+    int SendWillSendFile(size_t &totalLen);
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
 private:
     LLBC_SocketHandle _handle;
 
@@ -482,6 +568,28 @@ private:
     LLBC_MessageBuffer _willSend;
     size_t _maxPacketSize;
 
+    bool _datagram;
+    bool _sharedHandle;
+    std::deque<LLBC_MessageBlock *> _willSendDatagrams;
+    size_t _willSendDatagramsSize;
+    char *_datagramRecvArena;
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Will send file region, pos is the will send stream position(appended bytes) when file region queued.
+    struct _WillSendFile
+    {
+        uint64 pos;
+        int fd;
+        sint64 offset;
+        size_t remain;
+    };
+
+    uint64 _willSendAppended;
+    uint64 _willSendRemoved;
+    std::deque<_WillSendFile> _willSendFiles;
+    size_t _willSendFilesSize;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
 #if LLBC_TARGET_PLATFORM_WIN32
     bool _nonBlocking;
     LLBC_OverlappedGroup _olGroup;
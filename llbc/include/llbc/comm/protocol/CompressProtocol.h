@@ -60,6 +60,16 @@ public:
      */
     virtual int Recv(void *in, void *&out, bool &removeSession);
 
+    /**
+     * When file region send, will call this method(not compress, direct pass through).
+     * @param[in] in             - the in data.
+     * @param[in] fileLen        - the file region length.
+     * @param[out] out           - the out data.
+     * @param[out] removeSession - when error occurred, this out param determine remove session or not.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SendFileHeader(void *in, size_t fileLen, void *&out, bool &removeSession);
+
     /**
      * Add coder factory to protocol, only available in Codec-Layer.
      * @param[in] opcode - the opcode.
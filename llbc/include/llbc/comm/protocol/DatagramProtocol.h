@@ -0,0 +1,61 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+#pragma once
+
+#include "llbc/comm/protocol/PacketProtocol.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The datagram variant Pack-Layer protocol implement.
+ *        Use library default header format(see LLBC_PacketProtocol), but every
+ *        received datagram must be exactly one complete packet, it's header length
+ *        field must equal to the datagram size.
+ *        The malformed datagram will be reported and dropped, never remove session.
+ */
+class LLBC_EXPORT LLBC_DatagramProtocol : public LLBC_PacketProtocol
+{
+public:
+    /**
+     * Constructor & Destructor.
+     */
+    LLBC_DatagramProtocol();
+    virtual ~LLBC_DatagramProtocol();
+
+public:
+    /**
+     * When datagram received, will call this method.
+     * @param[in]  in            - the in data.
+     *                             in this protocol, in data type: LLBC_MessageBlock, one block is one datagram.
+     * @param[out] out           - the out data.
+     *                             in this protocol, out data type: LLBC_MessageBlock *, nullptr if not packet constructed.
+     *                             in LLBC_MessageBlock, store the LLBC_Packet * list.
+     * @param[out] removeSession - when error occurred, this out param determine remove session or not.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int Recv(void *in, void *&out, bool &removeSession);
+
+private:
+    LLBC_PacketHeaderAssembler _headerAssembler;
+};
+
+__LLBC_NS_END
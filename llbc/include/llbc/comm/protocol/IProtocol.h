@@ -85,6 +85,19 @@ public:
      */
     virtual int Recv(void *in, void *&out, bool &removeSession) = 0;
 
+    /**
+     * When file region send, will call this method to build file region header, the file region data
+     * will be sent directly(by sendfile()) after the header, so only non-transforming protocol can support it.
+     * Note: Default return -1 and set last error to LLBC_ERROR_NOT_SUPPORT(the in data will not be consumed),
+     *       then the file region will be read to packet payload and sent by Send() method.
+     * @param[in] in             - the in data(header packet).
+     * @param[in] fileLen        - the file region length.
+     * @param[out] out           - the out data.
+     * @param[out] removeSession - when error occurred, this out param determine remove session or not.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SendFileHeader(void *in, size_t fileLen, void *&out, bool &removeSession);
+
 public:
     /**
      * Control protocol layer.
@@ -83,6 +83,27 @@ public:
      */
     virtual int Recv(void *in, void *&out, bool &removeSession);
 
+    /**
+     * When file region send, will call this method.
+     * @param[in] in             - the in data.
+     *                             in this protocol, in data type: LLBC_Packet *(no payload).
+     * @param[in] fileLen        - the file region length, header length field = header length + fileLen.
+     * @param[out] out           - the out data.
+     *                             in this protocol, out data type: LLBC_MessageBlock *(only contains header).
+     * @param[out] removeSession - when error occurred, this out param determine remove session or not.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    virtual int SendFileHeader(void *in, size_t fileLen, void *&out, bool &removeSession);
+
+private:
+    /**
+     * Write packet header to block.
+     * @param[in] packet     - the packet.
+     * @param[in] payloadLen - the payload length.
+     * @param[in] block      - the block.
+     */
+    void WriteHeader(const LLBC_Packet &packet, size_t payloadLen, LLBC_MessageBlock &block);
+
 private:
     LLBC_PacketHeaderAssembler _headerAssembler;
 
@@ -163,6 +163,17 @@ public:
      */
     int Send(LLBC_Packet *packet, LLBC_MessageBlock *&block, bool &removeSession);
 
+    /**
+     * Build file region header block(Pack-Layer & Compress-Layer), see LLBC_IProtocol::SendFileHeader().
+     * Note: If failed and last error is LLBC_ERROR_NOT_SUPPORT, the packet will not be consumed.
+     * @param[in] packet         - the header packet.
+     * @param[in] fileLen        - the file region length.
+     * @param[out] block         - the header block, maybe nullptr if stack has no header.
+     * @param[out] removeSession - when error occurred, this out param determine remove session or not.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SendFileHeader(LLBC_Packet *packet, size_t fileLen, LLBC_MessageBlock *&block, bool &removeSession);
+
     /**
      * When message receive, will use this protocol stack method to convert message-block to undecoded.
      * @param[in] block          - the message block.
@@ -174,6 +174,14 @@
 // Long timeout time, in milli-seconds, when a timer timeout time >= <this value>, when call Cancel(), will force remove from binary heap.
 #define LLBC_CFG_CORE_TIMER_LONG_TIMEOUT_TIME               864000000 // 10 days
 
+/**
+ * \brief core/coro about configs.
+ */
+// Coroutine stack size, in bytes(guard page not included).
+#define LLBC_CFG_CORE_CORO_STACK_SIZE                       (128 * 1024)
+// Coroutine stack pool max idle stacks count.
+#define LLBC_CFG_CORE_CORO_MAX_IDLE_STACKS                  128
+
 /**
 * \brief core/objectpool about configs.
 */
@@ -238,6 +246,11 @@
 // Note:
 // - this packet size is PacketProcol limit, the size is only used for PacketProcol
 #define LLBC_CFG_COMM_DFT_MAX_PACKET_SIZE                   LLBC_INFINITE
+// Default session recv budget, max bytes read from one session in one poller wakeup, 0 means unlimited.
+// Note:
+// - the session which exhausted recv budget will be read again in next poller loop(EpollPoller specific),
+//   so one flooding session can not monopolize the poller.
+#define LLBC_CFG_COMM_DFT_SESSION_RECV_BUDGET               (256 * 1024)
 // Session recv buffer use object pool option, this option is performance option.
 // Note: 
 // - if enabled, can improvement read data from socket performance,
@@ -246,14 +259,52 @@
 #define LLBC_CFG_COMM_SESSION_RECV_BUF_USE_OBJ_POOL         0
 // Message buffer element(block) allow resize limit.
 #define LLBC_CFG_COMM_MSG_BUFFER_ELEM_RESIZE_LIMIT          (8 * 1024)
+// Packet inline payload size, the payload which less than or equal to this size will store in packet object,
+// no extra message block allocate, 0 means disable inline payload.
+// Note:
+// - if payload grown greater than this size, will auto spill to message block.
+#define LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE            128
+// UDP datagram batch size, max datagrams read/write in one recvmmsg()/sendmmsg() call(EpollPoller specific).
+#define LLBC_CFG_COMM_UDP_BATCH_SIZE                        32
+// UDP datagram max size, the datagram which greater than this size will be truncated and dropped.
+#define LLBC_CFG_COMM_UDP_MAX_DATAGRAM_SIZE                 (8 * 1024)
+// Max poller count per service, poller count could be changed at runtime but can't exceed this value.
+#define LLBC_CFG_COMM_MAX_POLLER_COUNT                      64
+// Poller load statistic & auto balance interval, in milli-seconds(non Modulo place policy only).
+#define LLBC_CFG_COMM_POLLER_BALANCE_INTERVAL               1000
+// Poller auto balance only migrate the session which idle time greater than or equal to this value, in milli-seconds.
+#define LLBC_CFG_COMM_POLLER_MIGRATE_IDLE_TIME              5000
+// Max migrate sessions count in one poller auto balance.
+#define LLBC_CFG_COMM_POLLER_MAX_MIGRATE_PER_BALANCE        64
+// Poller idle session timing wheel tick interval, in milli-seconds, the idle timeout precision.
+#define LLBC_CFG_COMM_POLLER_IDLE_WHEEL_TICK                100
+// Poller idle session timing wheel slots count, the deadline out of wheel range will be re-checked when slot expired.
+#define LLBC_CFG_COMM_POLLER_IDLE_WHEEL_SLOTS               512
+// Session heartbeat packet flag, heartbeat packets will be consumed by poller, not dispatch to service.
+#define LLBC_CFG_COMM_HEARTBEAT_PACKET_FLAG                 0x2000
 // Default service FPS value.
 #define LLBC_CFG_COMM_DFT_SERVICE_FPS                       200
 // Min service FPS value.
 #define LLBC_CFG_COMM_MIN_SERVICE_FPS                       1
 // Max service FPS value.
 #define LLBC_CFG_COMM_MAX_SERVICE_FPS                       1000
+// Service overload state min duration, avoid overload state flapping, in milli-seconds.
+#define LLBC_CFG_COMM_MIN_OVERLOAD_DURATION                 100
+// Default rpc call timeout, in milli-seconds.
+#define LLBC_CFG_COMM_DFT_RPC_TIMEOUT                       5000
+// Packet capture file memory-mapped grow size, in bytes.
+#define LLBC_CFG_COMM_PACKET_CAPTURE_MAP_SIZE               (4 * 1024 * 1024)
+// Packet capture replay max replayed packets per service frame.
+#define LLBC_CFG_COMM_PACKET_REPLAY_BATCH_SIZE              1024
 // Sampler support option, default is true.
+// Note:
+// - if enabled, service support per-opcode statistics(packets count/bytes, decode/handle time histogram),
+//   statistics is disabled by default, use LLBC_Service::SetOpcodeStatsEnabled() to enable it.
+// - if enabled, service support frame profile(frame phases/components cost time, budget overrun frames),
+//   profile is disabled by default, use LLBC_Service::SetFrameProfileEnabled() to enable it.
 #define LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT                1
+// Service frame profile rolling window, in milli-seconds.
+#define LLBC_CFG_COMM_FRAME_PROFILE_WINDOW                  60000
 // Per thread drive max services count.
 #define LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT        16
 // Determine enable the service has status handler support or not.
@@ -266,19 +317,22 @@
 #define LLBC_CFG_COMM_CREATE_COMP_FROM_LIB_FUNC_PREFIX      "llbc_create_comp_"
 // The poller model config(Platform specific).
 //  Alloc set one of the follow configs(string format, case insensitive).
-//   "SelectPoller" : Use select poller(All platform available).
+//   "SelectPoller" : Use select poller(All platform available, limited by FD_SETSIZE).
+//   "PollPoller"   : Poll poller(Available in all Non-WIN32 platforms).
 //   "EpollPoller"  : Epoll poller(Avaliable in LINUX/Android platform).
+//   "KqueuePoller" : Kqueue poller(Available in MAC/IPHONE platform).
 //   "IocpPoller"   : Iocp poller(Available in WIN32 platform).
+//  Service can override it by LLBC_Service::SetPollerModel() or service config(key: pollerModel).
 #if LLBC_TARGET_PLATFORM_LINUX
  #define LLBC_CFG_COMM_POLLER_MODEL                 "EpollPoller"
 #elif LLBC_TARGET_PLATFORM_WIN32
  #define LLBC_CFG_COMM_POLLER_MODEL                 "IocpPoller"
 #elif LLBC_TARGET_PLATFORM_IPHONE
- #define LLBC_CFG_COMM_POLLER_MODEL                 "SelectPoller"
+ #define LLBC_CFG_COMM_POLLER_MODEL                 "KqueuePoller"
 #elif LLBC_TARGET_PLATFORM_MAC
- #define LLBC_CFG_COMM_POLLER_MODEL                 "SelectPoller"
+ #define LLBC_CFG_COMM_POLLER_MODEL                 "KqueuePoller"
 #else
- #define LLBC_CFG_COMM_POLLER_MODEL                 "SelectPoller"
+ #define LLBC_CFG_COMM_POLLER_MODEL                 "PollPoller"
 #endif
 
 /**
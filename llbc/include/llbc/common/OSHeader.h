@@ -56,6 +56,7 @@
  #include <netdb.h>
  #include <semaphore.h>
  #include <arpa/inet.h>
+ #include <poll.h>
 
  #if LLBC_TARGET_PLATFORM_LINUX
   #include <sys/epoll.h>
@@ -63,6 +64,7 @@
 
  #if LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
   #include <sys/param.h>
+  #include <sys/event.h>
  #endif
 
  #if LLBC_TARGET_PLATFORM_MAC
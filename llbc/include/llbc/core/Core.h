@@ -89,6 +89,10 @@
 #include "llbc/core/timer/Timer.h"
 #include "llbc/core/timer/TimerScheduler.h"
 
+// core/coro
+#include "llbc/core/coro/CoroStackPool.h"
+#include "llbc/core/coro/Coro.h"
+
 // core/thread
 #include "llbc/core/thread/DummyLock.h"
 #include "llbc/core/thread/SimpleLock.h"
@@ -0,0 +1,132 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/common/Common.h"
+
+#include "llbc/core/utils/Util_Delegate.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * Pre-declare some classes.
+ */
+class LLBC_CoroStackPool;
+
+__LLBC_NS_END
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The stackful coroutine encapsulation(asymmetric).
+ *        Coroutine could only yield to the context which resumed it, resume & yield must in the same thread.
+ * Note: 
+ *      - Non-win32 platform use ucontext, stack acquired from stack pool.
+ *      - Win32 platform use fiber, stack managed by OS(stack pool only provide stack size).
+ */
+class LLBC_EXPORT LLBC_Coro
+{
+public:
+    /**
+     * The coroutine state enumeration.
+     */
+    class State
+    {
+    public:
+        enum ENUM
+        {
+            Begin,
+
+            Suspended = Begin,
+            Running,
+            Finished,
+
+            End
+        };
+    };
+
+public:
+    /**
+     * Construct coroutine, coroutine will not run until first Resume() called.
+     * @param[in] entry     - the coroutine entry.
+     * @param[in] stackPool - the stack pool, must outlive coroutine.
+     */
+    LLBC_Coro(const LLBC_Delegate<void()> &entry, LLBC_CoroStackPool &stackPool);
+    ~LLBC_Coro();
+
+public:
+    /**
+     * Get coroutine state, see State enumeration.
+     * @return int - the coroutine state.
+     */
+    int GetState() const;
+
+    /**
+     * Check coroutine is finished or not.
+     * @return bool - return true if finished, otherwise return false.
+     */
+    bool IsFinished() const;
+
+public:
+    /**
+     * Resume coroutine, return when coroutine yield or finished.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Resume();
+
+    /**
+     * Yield coroutine to the context which resumed it, must be called in this coroutine.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int Yield();
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_Coro);
+
+private:
+    /**
+     * Create coroutine context when first resume.
+     */
+    int CreateContext();
+
+    /**
+     * Coroutine entry trampoline.
+     */
+    void RunEntry();
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    static void Trampoline(uint32 coroHigh, uint32 coroLow);
+#else
+    static void WINAPI Trampoline(LPVOID coro);
+#endif
+
+private:
+    int _state;
+    LLBC_Delegate<void()> _entry;
+
+    LLBC_CoroStackPool &_stackPool;
+    void *_stack;
+
+    void *_context;
+    void *_callerContext;
+};
+
+__LLBC_NS_END
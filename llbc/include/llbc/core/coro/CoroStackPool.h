@@ -0,0 +1,86 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#pragma once
+
+#include "llbc/common/Common.h"
+
+__LLBC_NS_BEGIN
+
+/**
+ * \brief The coroutine stack pool, pooled fixed size stacks to avoid mmap/munmap per coroutine.
+ *        Each stack has a guard page below it(non-win32 platform), stack overflow will crash at once
+ *        instead of corrupting other memory.
+ * Note: Not thread safe, use one pool per thread(eg: service).
+ */
+class LLBC_EXPORT LLBC_CoroStackPool
+{
+public:
+    /**
+     * Construct coroutine stack pool.
+     * @param[in] stackSize     - the stack size, in bytes, will be rounded up to page size.
+     * @param[in] maxIdleStacks - the max idle stacks count, exceeded stacks will be freed when released.
+     */
+    explicit LLBC_CoroStackPool(size_t stackSize = LLBC_CFG_CORE_CORO_STACK_SIZE,
+                                size_t maxIdleStacks = LLBC_CFG_CORE_CORO_MAX_IDLE_STACKS);
+    ~LLBC_CoroStackPool();
+
+public:
+    /**
+     * Get stack size, in bytes(guard page not included).
+     * @return size_t - the stack size.
+     */
+    size_t GetStackSize() const;
+
+    /**
+     * Get idle stacks count.
+     * @return size_t - the idle stacks count.
+     */
+    size_t GetIdleStackCount() const;
+
+public:
+    /**
+     * Acquire a stack, reuse idle stack if has.
+     * @return void * - the stack lowest address, return nullptr if failed.
+     */
+    void *Acquire();
+
+    /**
+     * Release stack to pool.
+     * @param[in] stack - the stack, must acquired from this pool.
+     */
+    void Release(void *stack);
+
+    LLBC_DISABLE_ASSIGNMENT(LLBC_CoroStackPool);
+
+private:
+    void *AllocStack();
+    void FreeStack(void *stack);
+
+private:
+    size_t _pageSize;
+    size_t _stackSize;
+    size_t _maxIdleStacks;
+    std::vector<void *> _idleStacks;
+};
+
+__LLBC_NS_END
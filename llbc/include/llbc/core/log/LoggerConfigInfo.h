@@ -87,6 +87,15 @@ public:
      */
     bool IsIndependentThread() const;
 
+    /**
+     * Get log thread name/cpu affinity mask, only available in Async-Mode.
+     * If logger use shared log thread, the first configured shared logger's thread name/cpu affinity will be used.
+     * @return const LLBC_String & - the log thread name, empty means not set.
+     * @return uint64              - the log thread cpu affinity mask, 0 means not set.
+     */
+    const LLBC_String &GetThreadName() const;
+    uint64 GetCPUAffinity() const;
+
     /**
      * Get file refresh interval.
      * @return int - the file refresh interval.
@@ -223,6 +232,8 @@ private:
     int _logLevel;
     bool _asyncMode;
     bool _independentThread;
+    LLBC_String _threadName;
+    uint64 _cpuAffinity;
     int _flushInterval;
 
     bool _logToConsole;
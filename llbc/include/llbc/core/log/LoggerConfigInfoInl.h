@@ -48,6 +48,16 @@ inline bool LLBC_LoggerConfigInfo::IsIndependentThread() const
     return _independentThread;
 }
 
+inline const LLBC_String &LLBC_LoggerConfigInfo::GetThreadName() const
+{
+    return _threadName;
+}
+
+inline uint64 LLBC_LoggerConfigInfo::GetCPUAffinity() const
+{
+    return _cpuAffinity;
+}
+
 inline int LLBC_LoggerConfigInfo::GetFlushInterval() const
 {
     return _flushInterval;
@@ -49,6 +49,12 @@ LLBC_EXPORT LLBC_SocketHandle LLBC_CreateTcpSocket();
  */
 LLBC_EXPORT LLBC_SocketHandle LLBC_CreateTcpSocketEx();
 
+/**
+ * Create UDP socket.
+ * @return LLBC_SocketHandle - socket handle, if failed, return LLBC_INVALID_SOCKET_HANDLE.
+ */
+LLBC_EXPORT LLBC_SocketHandle LLBC_CreateUdpSocket();
+
 /**
  * Shutdown socket input.
  * @param[in] handle - socket handle.
@@ -80,6 +86,20 @@ LLBC_EXPORT int LLBC_ShutdownSocketInputOutput(LLBC_SocketHandle handle);
  */
 LLBC_EXPORT int LLBC_Send(LLBC_SocketHandle handle, const void *buf, int len, int flags);
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+/**
+ * Sends file region data on a connected socket(Non-WIN32 specific).
+ * Use sendfile() if platform and file support, otherwise read file region in chunks and send.
+ * @param[in]     handle - socket handle.
+ * @param[in]     fd     - the file descriptor.
+ * @param[in/out] offset - the file region offset, will be advanced by the number bytes sent.
+ * @param[in]     count  - the file region bytes count.
+ * @return int - if no error occurs, return the number bytes sent, otherwise return -1
+ *               (if file region exceed the end of file, the last error is LLBC_ERROR_END).
+ */
+LLBC_EXPORT int LLBC_SendFile(LLBC_SocketHandle handle, int fd, sint64 &offset, size_t count);
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
 /**
  * Send data on a connected socket(WIN32 specific).
  * @param[in]  handle         - socket handle.
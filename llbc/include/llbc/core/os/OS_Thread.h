@@ -118,6 +118,34 @@ LLBC_EXPORT int LLBC_GetThreadPriority(LLBC_NativeThreadHandle handle);
  */
 LLBC_EXPORT int LLBC_SetThreadPriority(LLBC_NativeThreadHandle handle, int priority);
 
+/**
+ * Set thread name.
+ * Note: Linux thread name max length is 15, exceed part will be truncated,
+ *       Mac/iPhone only support set current thread name.
+ * @param[in] handle - native thread handle.
+ * @param[in] name   - the thread name.
+ * @return int - return 0 if success, otherwise return -1.
+ */
+LLBC_EXPORT int LLBC_SetThreadName(LLBC_NativeThreadHandle handle, const char *name);
+
+/**
+ * Set thread cpu affinity.
+ * Note: Only support Linux/Windows platform, cpu index must less than 64.
+ * @param[in] handle  - native thread handle.
+ * @param[in] cpuMask - the cpu mask, bit N set means thread can run on cpu N, must not be 0.
+ * @return int - return 0 if success, otherwise return -1.
+ */
+LLBC_EXPORT int LLBC_SetThreadAffinity(LLBC_NativeThreadHandle handle, uint64 cpuMask);
+
+/**
+ * Parse cpu list string to cpu mask.
+ * Support cpu list format, eg: "0-3,6", or hex mask format, eg: "0x4f".
+ * @param[in] cpuList  - the cpu list string.
+ * @param[out] cpuMask - the parsed cpu mask.
+ * @return int - return 0 if success, otherwise return -1.
+ */
+LLBC_EXPORT int LLBC_ParseCPUMask(const char *cpuList, uint64 &cpuMask);
+
 /**
  * Suspend thread.
  * @param[in] handle - native thread handle.
@@ -93,6 +93,24 @@ public:
      */
     int GetTaskState() const;
 
+    /**
+     * Get/Set task threads name, will be applied when task threads startup.
+     * Note: Set method must be called before Activate().
+     * @param[in] threadName - the thread name, empty means not set.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    const LLBC_String &GetThreadName() const;
+    int SetThreadName(const LLBC_String &threadName);
+
+    /**
+     * Get/Set task threads cpu affinity mask, will be applied when task threads startup.
+     * Note: Set method must be called before Activate().
+     * @param[in] cpuMask - the cpu mask, bit N set means task threads can run on cpu N, 0 means not set.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    uint64 GetCPUAffinity() const;
+    int SetCPUAffinity(uint64 cpuMask);
+
 public:
     /**
      * Wait current task.
@@ -182,6 +200,9 @@ private:
     volatile int _threadNum;
     volatile int _activatingThreadNum;
 
+    LLBC_String _threadName;
+    uint64 _cpuMask;
+
     LLBC_MessageQueue _msgQueue;
 };
 
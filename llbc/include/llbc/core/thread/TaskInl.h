@@ -45,6 +45,16 @@ inline int LLBC_Task::GetTaskState() const
     return _taskState;
 }
 
+inline const LLBC_String &LLBC_Task::GetThreadName() const
+{
+    return _threadName;
+}
+
+inline uint64 LLBC_Task::GetCPUAffinity() const
+{
+    return _cpuMask;
+}
+
 inline int LLBC_Task::Push(LLBC_MessageBlock *block)
 {
     _msgQueue.PushBack(block);
@@ -132,6 +132,22 @@ public:
      */
     int SetPriority(LLBC_Handle handle, int priority);
 
+    /**
+     * Set thread name.
+     * @param[in] handle - thread handle.
+     * @param[in] name   - the thread name.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetThreadName(LLBC_Handle handle, const LLBC_String &name);
+
+    /**
+     * Set thread cpu affinity.
+     * @param[in] handle  - thread handle.
+     * @param[in] cpuMask - the cpu mask, bit N set means thread can run on cpu N.
+     * @return int - return 0 if success, otherwise return -1.
+     */
+    int SetThreadAffinity(LLBC_Handle handle, uint64 cpuMask);
+
     /**
      * Get running group thread handles.
      * @param[in] groupHandle - thread group handle.
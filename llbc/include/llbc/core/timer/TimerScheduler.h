@@ -76,6 +76,19 @@ public:
      */
     size_t GetTimerCount() const;
 
+    /**
+     * Set timeout profile enabled flag, if enabled, will record the slowest timeout timer in every Update() call.
+     * @param[in] enabled - the enabled flag.
+     */
+    void SetTimeoutProfileEnabled(bool enabled);
+
+    /**
+     * Get the slowest timeout timer info in last Update() call(only available when timeout profile enabled).
+     * @param[out] timerId     - the timer Id, 0 if no timer timeout.
+     * @param[out] timeoutTime - the timeout handler cost time, in nano-seconds.
+     */
+    void GetSlowestTimeout(LLBC_TimerId &timerId, sint64 &timeoutTime) const;
+
 public:
     /**
      * Cancel all timers.
@@ -119,6 +132,10 @@ private:
     bool _destroyed;
 
     _Heap _heap;
+
+    bool _timeoutProfileEnabled;
+    LLBC_TimerId _slowestTimerId;
+    sint64 _slowestTimeoutTime;
 };
 
 __LLBC_NS_END
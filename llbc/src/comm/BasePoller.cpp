@@ -32,9 +32,15 @@
 #if LLBC_TARGET_PLATFORM_WIN32
  #include "llbc/comm/IocpPoller.h"
 #endif // Win32
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+ #include "llbc/comm/PollPoller.h"
+#endif // Non-Win32
 #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
  #include "llbc/comm/EpollPoller.h"
 #endif // Linux or Android
+#if LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+ #include "llbc/comm/KqueuePoller.h"
+#endif // Mac or iPhone
 #include "llbc/comm/PollerMgr.h"
 #include "llbc/comm/Service.h"
 
@@ -53,7 +59,9 @@ This::_Handler This::_handlers[LLBC_PollerEvent::End] =
     &This::HandleEv_Close,
     &This::HandleEv_Monitor,
     &This::HandleEv_TakeOverSession,
-    &This::HandleEv_CtrlProtocolStack
+    &This::HandleEv_CtrlProtocolStack,
+    &This::HandleEv_MigrateSession,
+    &This::HandleEv_SendFile
 };
 
 LLBC_BasePoller::LLBC_BasePoller()
@@ -69,6 +77,24 @@ LLBC_BasePoller::LLBC_BasePoller()
 , _sessions()
 
 , _connecting()
+
+, _draining(false)
+, _drained(false)
+
+, _bytesPerSec(0)
+, _statBytes(0)
+, _statBeginTime(0)
+
+, _migratedSessions()
+
+, _busyPollWindow(0)
+
+, _idleWheel()
+, _expiredIdles()
+
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+, _queueStatsEnabled(false)
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
 {
 }
 
@@ -91,12 +117,24 @@ This *LLBC_BasePoller::Create(int type)
         break;
 #endif
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    case LLBC_PollerType::PollPoller:
+        poller = new LLBC_PollPoller;
+        break;
+#endif
+
 #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
     case LLBC_PollerType::EpollPoller:
         poller = new LLBC_EpollPoller;
         break;
 #endif
 
+#if LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+    case LLBC_PollerType::KqueuePoller:
+        poller = new LLBC_KqueuePoller;
+        break;
+#endif
+
     default:
         break;
     }
@@ -127,6 +165,68 @@ void LLBC_BasePoller::SetPollerMgr(LLBC_PollerMgr *mgr)
     _pollerMgr = mgr;
 }
 
+sint64 LLBC_BasePoller::GetBytesPerSec() const
+{
+    return _bytesPerSec;
+}
+
+void LLBC_BasePoller::Drain()
+{
+    _draining = true;
+}
+
+bool LLBC_BasePoller::IsDrained() const
+{
+    return _drained;
+}
+
+int LLBC_BasePoller::GetBusyPollWindow() const
+{
+    return _busyPollWindow;
+}
+
+void LLBC_BasePoller::SetBusyPollWindow(int busyPollWindow)
+{
+    _busyPollWindow = MAX(0, busyPollWindow);
+}
+
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+int LLBC_BasePoller::Push(LLBC_MessageBlock *block)
+{
+    LLBC_PollerEvent &ev = *reinterpret_cast<LLBC_PollerEvent *>(block->GetData());
+    if (LIKELY(!_queueStatsEnabled))
+    {
+        ev.enqueueTime = 0;
+        return LLBC_Task::Push(block);
+    }
+
+    ev.enqueueTime = LLBC_GetMicroSeconds();
+    LLBC_Task::Push(block);
+
+    LLBC_LockGuard guard(_queueStatLock);
+    _queueStat.RecordEnqueue(GetMessageSize());
+
+    return LLBC_OK;
+}
+
+void LLBC_BasePoller::SetQueueStatsEnabled(bool enabled)
+{
+    _queueStatsEnabled = enabled;
+}
+
+void LLBC_BasePoller::GetQueueStat(LLBC_QueueStat &stat) const
+{
+    LLBC_LockGuard guard(_queueStatLock);
+    stat = _queueStat;
+}
+
+void LLBC_BasePoller::ResetQueueStat()
+{
+    LLBC_LockGuard guard(_queueStatLock);
+    _queueStat.Reset();
+}
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 int LLBC_BasePoller::Start()
 {
     ASSERT(false && "Please implement LLBC_BasePoller::Start() method!");
@@ -179,21 +279,51 @@ void LLBC_BasePoller::Cleanup()
         delete it->second.socket;
     _connecting.clear();
 
+    _migratedSessions.clear();
+    _idleWheel.Clear();
+
     _started = false;
 }
 
 void LLBC_BasePoller::HandleQueuedEvents(int waitTime)
 {
+    // Busy poll mode, spin on queued events before blocking wait.
+    if (_busyPollWindow > 0 && waitTime > 0 && BusyWaitQueuedEvents())
+        waitTime = 0;
+
     LLBC_MessageBlock *block;
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    bool wakeup = true;
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
     while (TimedPop(block, waitTime) == LLBC_OK)
     {
         LLBC_PollerEvent &ev = 
             *reinterpret_cast< LLBC_PollerEvent *>(block->GetData());
 
+        #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+        if (UNLIKELY(_queueStatsEnabled))
+        {
+            StatDequeuedEv(ev, wakeup);
+            wakeup = GetMessageSize() == 0; // Queue drained, next popped event means new wakeup.
+        }
+        #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+        // The events routed to this poller before session migrated, forward to new poller.
+        if (UNLIKELY(!_migratedSessions.empty()) && ForwardMigratedEv(ev, block))
+            continue;
+
         (this->*_handlers[ev.type])(ev);
 
         delete block;
+
+        UpdateLoadStats();
     }
+
+    UpdateLoadStats();
+    UpdateIdleSessions();
+
+    if (UNLIKELY(_draining))
+        DrainSessions();
 }
 
 void LLBC_BasePoller::HandleEv_AddSock(LLBC_PollerEvent &ev)
@@ -289,6 +419,49 @@ void LLBC_BasePoller::HandleEv_CtrlProtocolStack(LLBC_PollerEvent &ev)
     }
 }
 
+void LLBC_BasePoller::HandleEv_MigrateSession(LLBC_PollerEvent &ev)
+{
+    _Sessions::iterator it = _sessions.find(ev.sessionId);
+    if (it == _sessions.end())
+        return;
+
+    const int toPollerId = ev.un.toPollerId;
+    if (toPollerId == _id || toPollerId < 0 || toPollerId >= _brotherCount)
+        return;
+
+    LLBC_Session *session = it->second;
+    if (!IsMigratable(session))
+    {
+        trace("LLBC_BasePoller::HandleEv_MigrateSession() session %d could not migrate\n", ev.sessionId);
+        return;
+    }
+
+    MigrateSession(session, toPollerId);
+}
+
+void LLBC_BasePoller::HandleEv_SendFile(LLBC_PollerEvent &ev)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    LLBC_FileRegion *fileRegion = ev.un.fileRegion;
+    _Sessions::iterator it = _sessions.find(fileRegion->header->GetSessionId());
+    if (it == _sessions.end() ||
+        UNLIKELY(it->second->IsListen() || it->second->GetSocket()->IsDatagram()))
+    {
+        LLBC_PollerEvUtil::DestroyEv(ev);
+        return;
+    }
+
+    // Force flush header & file region(like HandleEv_Send() in epoll poller), session maybe removed in it.
+    LLBC_Session *session = it->second;
+    if (UNLIKELY(session->SendFile(fileRegion) != LLBC_OK))
+        session->OnClose();
+    else
+        FlushSend(session);
+#else // Win32
+    LLBC_PollerEvUtil::DestroyEv(ev);
+#endif // Non-Win32
+}
+
 LLBC_Session *LLBC_BasePoller::CreateSession(LLBC_Socket *socket,
                                              int sessionId,
                                              const LLBC_SessionOpts &sessionOpts,
@@ -311,7 +484,7 @@ LLBC_Session *LLBC_BasePoller::CreateSession(LLBC_Socket *socket,
 
 void LLBC_BasePoller::AddToPoller(LLBC_Session *session)
 {
-    const int hash = session->GetId() % _brotherCount;
+    const int hash = _pollerMgr->PlaceSession(session->GetId(), session->GetSessionOpts());
 
     if (hash == _id)
     {
@@ -324,6 +497,7 @@ void LLBC_BasePoller::AddToPoller(LLBC_Session *session)
         if (_pollerMgr->PushMsgToPoller(hash, ev) != LLBC_OK)
         {
             trace("LLBC_BasePoller::AddToPoller() could not found poller, hash val: %d\n", hash);
+            _pollerMgr->RemoveRoute(session->GetId());
             LLBC_PollerEvUtil::DestroyEv(ev);
             return;
         }
@@ -336,10 +510,22 @@ void LLBC_BasePoller::AddSession(LLBC_Session *session)
 void LLBC_BasePoller::AddSession(LLBC_Session *session, bool needAddToIocp)
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 {
-    // Insert to socket & session map.
+    // Insert to socket & session map(shared handle session only insert to session map).
+    const bool migrated = session->GetPoller() != nullptr;
     session->SetPoller(this);
     _sessions.insert(std::make_pair(session->GetId(), session));
-    _sockets.insert(std::make_pair(session->GetSocketHandle(), session));
+    if (!session->GetSocket()->IsSharedHandle())
+        _sockets.insert(std::make_pair(session->GetSocketHandle(), session));
+
+    // Schedule idle check(the migrated session's stale entry in old poller will be ignored).
+    ScheduleIdleCheck(session, LLBC_GetMilliSeconds());
+
+    // Migrated session(from other poller) already notified service.
+    if (migrated)
+    {
+        _migratedSessions.erase(session->GetId());
+        return;
+    }
 
     // Build event and push to service.
     LLBC_Socket *sock = session->GetSocket();
@@ -355,11 +541,261 @@ void LLBC_BasePoller::AddSession(LLBC_Session *session, bool needAddToIocp)
 
 void LLBC_BasePoller::RemoveSession(LLBC_Session *session)
 {
+    _pollerMgr->RemoveRoute(session->GetId());
+
     _sessions.erase(session->GetId());
-    _sockets.erase(session->GetSocketHandle());
+    if (!session->GetSocket()->IsSharedHandle())
+        _sockets.erase(session->GetSocketHandle());
+
     delete session;
 }
 
+void LLBC_BasePoller::DetachSession(LLBC_Session *session)
+{
+    _sessions.erase(session->GetId());
+    if (!session->GetSocket()->IsSharedHandle())
+        _sockets.erase(session->GetSocketHandle());
+}
+
+bool LLBC_BasePoller::IsMigratable(LLBC_Session *session) const
+{
+    if (session->IsListen() || session->GetSocket()->IsSharedHandle())
+        return false;
+
+    const int pinnedPoller = session->GetSessionOpts().GetPinnedPoller();
+    return pinnedPoller < 0 || pinnedPoller >= _brotherCount;
+}
+
+void LLBC_BasePoller::MigrateSession(LLBC_Session *session, int toPollerId)
+{
+    const int sessionId = session->GetId();
+    DetachSession(session);
+
+    // Session owned by new poller once take over event pushed, don't touch it after push.
+    LLBC_MessageBlock *block = LLBC_PollerEvUtil::BuildTakeOverSessionEv(session);
+    if (UNLIKELY(_pollerMgr->PushMsgToPoller(toPollerId, block) != LLBC_OK))
+    {
+        delete block;
+        AddSession(session);
+
+        return;
+    }
+
+    // Update route after take over event pushed, the events already routed to this poller
+    // will be forwarded to new poller(see ForwardMigratedEv()).
+    _migratedSessions[sessionId] = std::make_pair(toPollerId, LLBC_GetMilliSeconds());
+    _pollerMgr->SetRoute(sessionId, toPollerId);
+}
+
+bool LLBC_BasePoller::ForwardMigratedEv(LLBC_PollerEvent &ev, LLBC_MessageBlock *block)
+{
+    int sessionId;
+    switch (ev.type)
+    {
+    case _Ev::Send:
+        sessionId = ev.un.packet->GetSessionId();
+        break;
+
+    case _Ev::SendFile:
+        sessionId = ev.un.fileRegion->header->GetSessionId();
+        break;
+
+    case _Ev::Close:
+    case _Ev::CtrlProtocolStack:
+    case _Ev::MigrateSession:
+        sessionId = ev.sessionId;
+        break;
+
+    default:
+        return false;
+    }
+
+    _MigratedSessions::iterator it = _migratedSessions.find(sessionId);
+    if (it == _migratedSessions.end())
+        return false;
+
+    return _pollerMgr->PushMsgToPoller(it->second.first, block) == LLBC_OK;
+}
+
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+void LLBC_BasePoller::StatDequeuedEv(const LLBC_PollerEvent &ev, bool wakeup)
+{
+    const sint64 now = LLBC_GetMicroSeconds();
+
+    LLBC_LockGuard guard(_queueStatLock);
+    if (wakeup)
+        _queueStat.RecordWakeup(GetMessageSize() + 1);
+    if (ev.enqueueTime > 0) // Events pushed before statistics enabled have no enqueue time.
+        _queueStat.RecordDequeue((now - ev.enqueueTime) * 1000);
+}
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+void LLBC_BasePoller::UpdateLoadStats()
+{
+    const sint64 now = LLBC_GetMilliSeconds();
+    const sint64 elapsed = now - _statBeginTime;
+    if (LIKELY(elapsed < LLBC_CFG_COMM_POLLER_BALANCE_INTERVAL))
+        return;
+
+    _bytesPerSec = _statBytes * 1000 / elapsed;
+    _statBytes = 0;
+    _statBeginTime = now;
+
+    // Migrated session info only need keep a while, all stale events already forwarded.
+    for (_MigratedSessions::iterator it = _migratedSessions.begin();
+         it != _migratedSessions.end();
+         )
+    {
+        if (now - it->second.second >= LLBC_CFG_COMM_POLLER_BALANCE_INTERVAL)
+            _migratedSessions.erase(it++);
+        else
+            ++it;
+    }
+
+    if (!_draining)
+        BalanceSessions(now);
+}
+
+void LLBC_BasePoller::BalanceSessions(sint64 now)
+{
+    int migrateCount;
+    const int toPollerId = _pollerMgr->GetBalanceTarget(_id, migrateCount);
+    if (toPollerId < 0)
+        return;
+
+    // Only migrate idle sessions, to avoid packets reorder while migrating.
+    std::vector<LLBC_Session *> idleSessions;
+    for (_Sessions::iterator it = _sessions.begin();
+         it != _sessions.end() && static_cast<int>(idleSessions.size()) < migrateCount;
+         ++it)
+    {
+        LLBC_Session *session = it->second;
+        if (now - session->GetLastActiveTime() >= LLBC_CFG_COMM_POLLER_MIGRATE_IDLE_TIME &&
+            IsMigratable(session))
+            idleSessions.push_back(session);
+    }
+
+    for (size_t i = 0; i < idleSessions.size(); ++i)
+        MigrateSession(idleSessions[i], toPollerId);
+}
+
+void LLBC_BasePoller::DrainSessions()
+{
+    // Datagram peer sessions(shared handle) will be closed when datagram listen session detached.
+    std::vector<LLBC_Session *> sessions;
+    for (_Sessions::iterator it = _sessions.begin();
+         it != _sessions.end();
+         ++it)
+    {
+        if (!it->second->GetSocket()->IsSharedHandle())
+            sessions.push_back(it->second);
+    }
+
+    for (size_t i = 0; i < sessions.size(); ++i)
+        MigrateSession(sessions[i], _pollerMgr->GetDrainTarget(sessions[i]->GetId()));
+
+    // Wait all stale events forwarded, then mark drained.
+    _drained = _sessions.empty() && _connecting.empty() && _migratedSessions.empty();
+}
+
+void LLBC_BasePoller::ScheduleIdleCheck(LLBC_Session *session, sint64 now)
+{
+    const LLBC_SessionOpts &sessionOpts = session->GetSessionOpts();
+    const int readIdleTimeout = sessionOpts.GetReadIdleTimeout();
+    const int writeIdleTimeout = sessionOpts.IsAutoHeartbeat() ? sessionOpts.GetWriteIdleTimeout() : 0;
+    if ((readIdleTimeout <= 0 && writeIdleTimeout <= 0) || session->IsListen())
+    {
+        session->SetIdleDeadline(0);
+        return;
+    }
+
+    // Check at the nearest idle deadline, not less than now(avoid re-check in the same tick).
+    sint64 deadline;
+    if (readIdleTimeout > 0 && writeIdleTimeout > 0)
+        deadline = MIN(session->GetLastRecvTime() + readIdleTimeout, session->GetLastSendTime() + writeIdleTimeout);
+    else if (readIdleTimeout > 0)
+        deadline = session->GetLastRecvTime() + readIdleTimeout;
+    else
+        deadline = session->GetLastSendTime() + writeIdleTimeout;
+    deadline = MAX(deadline, now + 1);
+
+    session->SetIdleDeadline(deadline);
+    _idleWheel.Add(session->GetId(), deadline);
+}
+
+void LLBC_BasePoller::UpdateIdleSessions()
+{
+    if (LIKELY(_idleWheel.GetSize() == 0))
+        return;
+
+    const sint64 now = LLBC_GetMilliSeconds();
+    _idleWheel.Tick(now, _expiredIdles);
+    if (_expiredIdles.empty())
+        return;
+
+    for (size_t i = 0; i < _expiredIdles.size(); ++i)
+    {
+        // Session removed/migrated or rescheduled, ignore stale entry.
+        const LLBC_IdleWheel::Entry &entry = _expiredIdles[i];
+        _Sessions::iterator it = _sessions.find(entry.sessionId);
+        if (it == _sessions.end() || it->second->GetIdleDeadline() != entry.deadline)
+            continue;
+
+        LLBC_Session *session = it->second;
+        const LLBC_SessionOpts &sessionOpts = session->GetSessionOpts();
+
+        // Read idle, close session.
+        const int readIdleTimeout = sessionOpts.GetReadIdleTimeout();
+        if (readIdleTimeout > 0 && now - session->GetLastRecvTime() >= readIdleTimeout)
+        {
+            LLBC_SessionCloseInfo *closeInfo = new LLBC_SessionCloseInfo(LLBC_ERROR_TIMEOUTED, LLBC_ERROR_SUCCESS);
+            #if LLBC_TARGET_PLATFORM_NON_WIN32
+            session->OnClose(closeInfo);
+            #else
+            session->OnClose(nullptr, closeInfo);
+            #endif
+
+            continue;
+        }
+
+        // Write idle, send heartbeat.
+        const int writeIdleTimeout = sessionOpts.GetWriteIdleTimeout();
+        const bool sendHeartbeat = sessionOpts.IsAutoHeartbeat() &&
+                                   writeIdleTimeout > 0 &&
+                                   now - session->GetLastSendTime() >= writeIdleTimeout;
+        if (sendHeartbeat && UNLIKELY(session->SendHeartbeat() != LLBC_OK))
+        {
+            session->OnClose();
+            continue;
+        }
+
+        ScheduleIdleCheck(session, now);
+
+        // Force flush heartbeat(like HandleEv_Send()), session maybe removed in it.
+        if (sendHeartbeat)
+            FlushSend(session);
+    }
+
+    _expiredIdles.clear();
+}
+
+void LLBC_BasePoller::AddTrafficBytes(size_t bytes)
+{
+    _statBytes += bytes;
+}
+
+void LLBC_BasePoller::OnRecvBudgetExhausted(LLBC_Session *session)
+{
+}
+
+void LLBC_BasePoller::FlushSend(LLBC_Session *session)
+{
+    // In epoll ET mode, must force call OnSend() one time.
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    session->OnSend();
+#endif // Non-Win32
+}
+
 void LLBC_BasePoller::SetConnectedSocketOpts(LLBC_Socket *sock, const LLBC_SessionOpts &sessionOpts)
 {
     sock->UpdateLocalAddress();
@@ -373,6 +809,36 @@ void LLBC_BasePoller::SetConnectedSocketOpts(LLBC_Socket *sock, const LLBC_Sessi
 
     if (!sock->IsListen())
         sock->SetNoDelay(sessionOpts.IsNoDelay());
+
+    // Socket busy poll option, session option first, otherwise use poller busy poll window(if enabled).
+    // Note: Increase SO_BUSY_POLL above system default(net.core.busy_read) need CAP_NET_ADMIN, failure is not fatal.
+    const int sockBusyPoll = sessionOpts.GetSockBusyPoll() > 0 ? sessionOpts.GetSockBusyPoll() : _busyPollWindow;
+    if (sockBusyPoll > 0)
+        sock->SetBusyPoll(sockBusyPoll);
+}
+
+bool LLBC_BasePoller::BusyWaitQueuedEvents()
+{
+    const sint64 spinEndTime = LLBC_GetMicroSeconds() + _busyPollWindow;
+    while (GetMessageSize() == 0)
+    {
+        if (LLBC_GetMicroSeconds() >= spinEndTime)
+            return false;
+
+        LLBC_CPURelax();
+    }
+
+    return true;
+}
+
+bool LLBC_BasePoller::IsReadPaused() const
+{
+    return (_pollerMgr->GetOverloadFlags() & LLBC_OverloadPolicy::PauseRead) != 0;
+}
+
+bool LLBC_BasePoller::IsAcceptRejected() const
+{
+    return (_pollerMgr->GetOverloadFlags() & LLBC_OverloadPolicy::RejectAccept) != 0;
 }
 
 __LLBC_NS_END
@@ -0,0 +1,243 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/Packet.h"
+#include "llbc/comm/CompactPacketHeaderAssembler.h"
+
+namespace
+{
+    typedef LLBC_NS LLBC_CompactPacketHeaderAssembler This;
+}
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static size_t __WriteVarint(char *buf, LLBC_NS uint64 val)
+{
+    size_t len = 0;
+    while (val >= 0x80)
+    {
+        buf[len++] = static_cast<char>((val & 0x7f) | 0x80);
+        val >>= 7;
+    }
+
+    buf[len++] = static_cast<char>(val);
+
+    return len;
+}
+
+static bool __ReadVarint(const char *buf, size_t len, size_t &pos, size_t maxBytes, LLBC_NS uint64 &val)
+{
+    val = 0;
+    for (size_t i = 0; i < maxBytes && pos < len; ++i)
+    {
+        const LLBC_NS uint8 byte = static_cast<LLBC_NS uint8>(buf[pos++]);
+        val |= static_cast<LLBC_NS uint64>(byte & 0x7f) << (7 * i);
+        if ((byte & 0x80) == 0)
+            return true;
+    }
+
+    return false;
+}
+
+static int __PopCount(LLBC_NS uint8 mask)
+{
+    int count = 0;
+    for (; mask != 0; mask &= mask - 1)
+        ++count;
+
+    return count;
+}
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+const size_t LLBC_CompactPacketHeaderAssembler::MaxHeaderLen;
+
+LLBC_CompactPacketHeaderAssembler::LLBC_CompactPacketHeaderAssembler()
+: _curRecved(0)
+
+, _needVarints(0)
+, _recvedVarints(0)
+, _assembled(false)
+{
+}
+
+LLBC_CompactPacketHeaderAssembler::~LLBC_CompactPacketHeaderAssembler()
+{
+}
+
+bool LLBC_CompactPacketHeaderAssembler::Assemble(const void *data, size_t len, size_t &used)
+{
+    used = 0;
+    if (_assembled)
+        return true;
+
+    const char *bytes = reinterpret_cast<const char *>(data);
+    while (used < len)
+    {
+        const uint8 byte = static_cast<uint8>(bytes[used++]);
+        _header[_curRecved++] = static_cast<char>(byte);
+
+        if (_curRecved == 1)
+        {
+            // Unknown field mask bits, header malformed.
+            if (byte & ~This::AllFields)
+            {
+                _assembled = true;
+                return true;
+            }
+
+            // Payload length + all present fields.
+            _needVarints = 1 + LLBC_INL_NS __PopCount(byte);
+        }
+        else if ((byte & 0x80) == 0 && ++_recvedVarints == _needVarints)
+        {
+            _assembled = true;
+            return true;
+        }
+
+        // Header too long, malformed.
+        if (_curRecved == MaxHeaderLen)
+        {
+            _assembled = true;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void LLBC_CompactPacketHeaderAssembler::Reset()
+{
+    _curRecved = 0;
+
+    _needVarints = 0;
+    _recvedVarints = 0;
+    _assembled = false;
+}
+
+size_t LLBC_CompactPacketHeaderAssembler::GetHeaderLen() const
+{
+    return _curRecved;
+}
+
+bool LLBC_CompactPacketHeaderAssembler::SetToPacket(LLBC_Packet &packet) const
+{
+    if (!_assembled || _curRecved == 0)
+        return false;
+
+    const uint8 mask = static_cast<uint8>(_header[0]);
+    if (mask & ~This::AllFields)
+        return false;
+
+    // Read all fields, the zero value fields not present.
+    size_t pos = 1;
+    uint64 payloadLen = 0, opcode = 0, status = 0,
+        senderServiceId = 0, recverServiceId = 0, flags = 0, extData1 = 0;
+    if (!LLBC_INL_NS __ReadVarint(_header, _curRecved, pos, 5, payloadLen) ||
+        ((mask & This::OpcodeField) && !LLBC_INL_NS __ReadVarint(_header, _curRecved, pos, 5, opcode)) ||
+        ((mask & This::StatusField) && !LLBC_INL_NS __ReadVarint(_header, _curRecved, pos, 3, status)) ||
+        ((mask & This::SenderServiceIdField) && !LLBC_INL_NS __ReadVarint(_header, _curRecved, pos, 5, senderServiceId)) ||
+        ((mask & This::RecverServiceIdField) && !LLBC_INL_NS __ReadVarint(_header, _curRecved, pos, 5, recverServiceId)) ||
+        ((mask & This::FlagsField) && !LLBC_INL_NS __ReadVarint(_header, _curRecved, pos, 3, flags)) ||
+        ((mask & This::ExtData1Field) && !LLBC_INL_NS __ReadVarint(_header, _curRecved, pos, 10, extData1)))
+        return false;
+
+    // All header bytes must be consumed, and fields must in range.
+    if (pos != _curRecved ||
+        payloadLen > UINT32_MAX - MaxHeaderLen ||
+        opcode > UINT32_MAX ||
+        status > UINT16_MAX ||
+        senderServiceId > UINT32_MAX ||
+        recverServiceId > UINT32_MAX ||
+        flags > UINT16_MAX)
+        return false;
+
+    packet.SetLength(static_cast<uint32>(_curRecved + payloadLen));
+    packet.SetOpcode(static_cast<sint32>(static_cast<uint32>(opcode)));
+    packet.SetStatus(static_cast<uint16>(status));
+    packet.SetSenderServiceId(static_cast<int>(static_cast<uint32>(senderServiceId)));
+    packet.SetRecverServiceId(static_cast<int>(static_cast<uint32>(recverServiceId)));
+    packet.SetFlags(static_cast<uint16>(flags));
+    packet.SetExtData1(static_cast<sint64>(extData1));
+
+    return true;
+}
+
+size_t LLBC_CompactPacketHeaderAssembler::BuildHeader(const LLBC_Packet &packet, char *header)
+{
+    uint8 mask = 0;
+    size_t pos = 1;
+    pos += LLBC_INL_NS __WriteVarint(header + pos, static_cast<uint32>(packet.GetPayloadLength()));
+
+    const uint32 opcode = static_cast<uint32>(packet.GetOpcode());
+    if (opcode != 0)
+    {
+        mask |= This::OpcodeField;
+        pos += LLBC_INL_NS __WriteVarint(header + pos, opcode);
+    }
+
+    const uint16 status = static_cast<uint16>(packet.GetStatus());
+    if (status != 0)
+    {
+        mask |= This::StatusField;
+        pos += LLBC_INL_NS __WriteVarint(header + pos, status);
+    }
+
+    const uint32 senderServiceId = static_cast<uint32>(packet.GetSenderServiceId());
+    if (senderServiceId != 0)
+    {
+        mask |= This::SenderServiceIdField;
+        pos += LLBC_INL_NS __WriteVarint(header + pos, senderServiceId);
+    }
+
+    const uint32 recverServiceId = static_cast<uint32>(packet.GetRecverServiceId());
+    if (recverServiceId != 0)
+    {
+        mask |= This::RecverServiceIdField;
+        pos += LLBC_INL_NS __WriteVarint(header + pos, recverServiceId);
+    }
+
+    const uint16 flags = static_cast<uint16>(packet.GetFlags());
+    if (flags != 0)
+    {
+        mask |= This::FlagsField;
+        pos += LLBC_INL_NS __WriteVarint(header + pos, flags);
+    }
+
+    const uint64 extData1 = static_cast<uint64>(packet.GetExtData1());
+    if (extData1 != 0)
+    {
+        mask |= This::ExtData1Field;
+        pos += LLBC_INL_NS __WriteVarint(header + pos, extData1);
+    }
+
+    header[0] = static_cast<char>(mask);
+
+    return pos;
+}
+
+__LLBC_NS_END
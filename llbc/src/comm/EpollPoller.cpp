@@ -37,6 +37,16 @@ namespace
     typedef LLBC_NS LLBC_BasePoller Base;
 }
 
+__LLBC_INTERNAL_NS_BEGIN
+
+static LLBC_NS uint64 __DatagramPeerKey(const LLBC_NS LLBC_SockAddr_IN &peerAddr)
+{
+    return (static_cast<LLBC_NS uint64>(static_cast<LLBC_NS uint32>(peerAddr.GetIpAsNumberN())) << 16) |
+        static_cast<LLBC_NS uint64>(peerAddr.GetPortN());
+}
+
+__LLBC_INTERNAL_NS_END
+
 __LLBC_NS_BEGIN
 
 LLBC_EpollPoller::LLBC_EpollPoller()
@@ -90,7 +100,9 @@ void LLBC_EpollPoller::Svc()
 
     while (!_stopping)
     {
-        HandleQueuedEvents(20);
+        // Don't wait queued events if has recv ready sessions.
+        HandleQueuedEvents(_recvReadySessions.empty() ? 20 : 0);
+        HandleRecvReadySessions();
     }
 }
 
@@ -101,6 +113,10 @@ void LLBC_EpollPoller::Cleanup()
     LLBC_EpollClose(_epoll);
     _epoll = LLBC_INVALID_HANDLE;
 
+    _datagramPeers.clear();
+    _recvReadySessions.clear();
+    _readPausedSessions.clear();
+
     Base::Cleanup();
 }
 
@@ -214,8 +230,17 @@ void LLBC_EpollPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
             {
                 if (session->IsListen())
                 {
-                    Accept(session);
-                    continue;
+                    if (!session->GetSocket()->IsDatagram())
+                    {
+                        Accept(session);
+                        continue;
+                    }
+
+                    RecvDatagrams(session);
+                }
+                else if (UNLIKELY(IsReadPaused()))
+                {
+                    _readPausedSessions.insert(sessionId);
                 }
                 else
                 {
@@ -229,7 +254,11 @@ void LLBC_EpollPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
                         UNLIKELY(_sessions.find(sessionId) == _sessions.end()))
                     continue;
 
-                session->OnSend();
+                // Only datagram listen session care EPOLLOUT event, all peers share its handle.
+                if (session->IsListen())
+                    FlushDatagramPeers(session);
+                else
+                    session->OnSend();
             }
        }
     }
@@ -264,13 +293,17 @@ void LLBC_EpollPoller::AddSession(LLBC_Session *session)
 {
     Base::AddSession(session);
 
+    // Shared handle session(datagram peer) driven by the handle owner session.
     LLBC_Socket *sock = session->GetSocket();
+    if (sock->IsSharedHandle())
+        return;
+
     const LLBC_SocketHandle handle = sock->Handle();
 
     LLBC_EpollEvent epev;
     epev.events = EPOLLIN | EPOLLET | EPOLLHUP | EPOLLERR;
     epev.data.u64 = (static_cast<uint64>(session->GetId()) << 32) | static_cast<uint64>(handle);
-    if (!sock->IsListen())
+    if (!sock->IsListen() || sock->IsDatagram())
         epev.events |= EPOLLOUT;
 
     LLBC_EpollCtl(_epoll, EPOLL_CTL_ADD, handle, &epev);
@@ -278,15 +311,50 @@ void LLBC_EpollPoller::AddSession(LLBC_Session *session)
 
 void LLBC_EpollPoller::RemoveSession(LLBC_Session *session)
 {
+    // Datagram peer session, only remove it from peers map.
+    LLBC_Socket *sock = session->GetSocket();
+    if (sock->IsSharedHandle())
+    {
+        std::map<int, _DatagramPeers>::iterator it = _datagramPeers.find(session->GetAcceptId());
+        if (it != _datagramPeers.end())
+            it->second.erase(LLBC_INL_NS __DatagramPeerKey(sock->GetPeerAddress()));
+
+        Base::RemoveSession(session);
+        return;
+    }
+
     // For compatible before 2.6.9 version kernel, we pass event point to LLBC_EpollCtl() API,
     // even through this argument is ignored.
     LLBC_EpollEvent epev;
     epev.events = EPOLLIN | EPOLLOUT | EPOLLET | EPOLLHUP | EPOLLERR;
     LLBC_EpollCtl(_epoll, EPOLL_CTL_DEL, session->GetSocketHandle(), &epev);
 
+    // Datagram listen session, close all peers.
+    if (sock->IsDatagram() && sock->IsListen())
+        CloseDatagramPeers(session);
+
     Base::RemoveSession(session);
 }
 
+void LLBC_EpollPoller::DetachSession(LLBC_Session *session)
+{
+    // Datagram peers bind to this poller, close them when datagram listen session detached(poller draining).
+    LLBC_Socket *sock = session->GetSocket();
+    if (sock->IsDatagram() && sock->IsListen())
+        CloseDatagramPeers(session);
+
+    LLBC_EpollEvent epev;
+    epev.events = EPOLLIN | EPOLLOUT | EPOLLET | EPOLLHUP | EPOLLERR;
+    LLBC_EpollCtl(_epoll, EPOLL_CTL_DEL, session->GetSocketHandle(), &epev);
+
+    Base::DetachSession(session);
+}
+
+void LLBC_EpollPoller::OnRecvBudgetExhausted(LLBC_Session *session)
+{
+    _recvReadySessions.push_back(session->GetId());
+}
+
 int LLBC_EpollPoller::StartupMonitor()
 {
     const LLBC_Delegate<void()> deleg(this, &LLBC_EpollPoller::MonitorSvc);
@@ -307,7 +375,19 @@ void LLBC_EpollPoller::StopMonitor()
 
 void LLBC_EpollPoller::MonitorSvc()
 {
-    int ret = LLBC_EpollWait(_epoll,
+    // Busy poll mode, spin on non-blocking epoll wait before blocking wait.
+    int ret = 0;
+    const int busyPollWindow = _busyPollWindow;
+    if (busyPollWindow > 0)
+    {
+        const sint64 spinEndTime = LLBC_GetMicroSeconds() + busyPollWindow;
+        while ((ret = LLBC_EpollWait(_epoll, _events, LLBC_CFG_COMM_MAX_EVENT_COUNT, 0)) == 0 &&
+               LLBC_GetMicroSeconds() < spinEndTime)
+            LLBC_CPURelax();
+    }
+
+    if (ret == 0)
+        ret = LLBC_EpollWait(_epoll,
                              _events,
                              LLBC_CFG_COMM_MAX_EVENT_COUNT,
                              50);
@@ -369,6 +449,13 @@ void LLBC_EpollPoller::Accept(LLBC_Session *session)
         if (!(newSock = sock->Accept()))
             break;
 
+        // Service overloaded, close new accepted socket immediately.
+        if (UNLIKELY(IsAcceptRejected()))
+        {
+            delete newSock;
+            continue;
+        }
+
         newSock->SetNonBlocking();
 
         SetConnectedSocketOpts(newSock, session->GetSessionOpts());
@@ -376,6 +463,126 @@ void LLBC_EpollPoller::Accept(LLBC_Session *session)
     }
 }
 
+void LLBC_EpollPoller::RecvDatagrams(LLBC_Session *session)
+{
+    LLBC_Socket *sock = session->GetSocket();
+
+    LLBC_MessageBlock *blocks[LLBC_CFG_COMM_UDP_BATCH_SIZE];
+    LLBC_SockAddr_IN peerAddrs[LLBC_CFG_COMM_UDP_BATCH_SIZE];
+    for (; ;)
+    {
+        // Unconnected datagram socket errors is transient, ignore it.
+        const int count = sock->RecvDatagrams(blocks, peerAddrs, LLBC_CFG_COMM_UDP_BATCH_SIZE);
+        if (count < 0)
+            return;
+
+        // Dispatch to peer session, every datagram is a complete packet.
+        for (int i = 0; i < count; ++i)
+        {
+            if (UNLIKELY(!blocks[i]))
+                continue;
+
+            bool sessionRemoved;
+            GetDatagramPeer(session, peerAddrs[i])->OnRecved(blocks[i], sessionRemoved);
+        }
+
+        if (count < LLBC_CFG_COMM_UDP_BATCH_SIZE)
+            return;
+    }
+}
+
+LLBC_Session *LLBC_EpollPoller::GetDatagramPeer(LLBC_Session *session, const LLBC_SockAddr_IN &peerAddr)
+{
+    _DatagramPeers &peers = _datagramPeers[session->GetId()];
+
+    const uint64 peerKey = LLBC_INL_NS __DatagramPeerKey(peerAddr);
+    _DatagramPeers::iterator it = peers.find(peerKey);
+    if (it != peers.end())
+        return it->second;
+
+    // Peer session must pinned to this poller, because peer shared the listen session's handle.
+    LLBC_SessionOpts peerOpts(session->GetSessionOpts());
+    peerOpts.SetPinnedPoller(_id);
+
+    LLBC_Socket *peerSock = session->GetSocket()->AcceptDatagramPeer(peerAddr);
+    LLBC_Session *peer = CreateSession(peerSock, 0, peerOpts, session);
+    peers.insert(std::make_pair(peerKey, peer));
+
+    AddToPoller(peer);
+
+    return peer;
+}
+
+void LLBC_EpollPoller::FlushDatagramPeers(LLBC_Session *session)
+{
+    std::map<int, _DatagramPeers>::iterator it = _datagramPeers.find(session->GetId());
+    if (it == _datagramPeers.end())
+        return;
+
+    // Peer maybe removed while sending, copy first.
+    std::vector<LLBC_Session *> sendingPeers;
+    for (_DatagramPeers::iterator peerIt = it->second.begin();
+         peerIt != it->second.end();
+         ++peerIt)
+    {
+        if (peerIt->second->GetSocket()->IsExistNoSendData())
+            sendingPeers.push_back(peerIt->second);
+    }
+
+    for (size_t i = 0; i < sendingPeers.size(); ++i)
+        sendingPeers[i]->OnSend();
+}
+
+void LLBC_EpollPoller::CloseDatagramPeers(LLBC_Session *session)
+{
+    std::map<int, _DatagramPeers>::iterator it = _datagramPeers.find(session->GetId());
+    if (it == _datagramPeers.end())
+        return;
+
+    _DatagramPeers peers;
+    peers.swap(it->second);
+    _datagramPeers.erase(it);
+
+    for (_DatagramPeers::iterator peerIt = peers.begin();
+         peerIt != peers.end();
+         ++peerIt)
+        peerIt->second->OnClose(new LLBC_SessionCloseInfo(LLBC_ERROR_END, 0));
+}
+
+void LLBC_EpollPoller::HandleRecvReadySessions()
+{
+    // Read paused, defer recv ready sessions until read resumed.
+    if (UNLIKELY(IsReadPaused()))
+    {
+        _readPausedSessions.insert(_recvReadySessions.begin(), _recvReadySessions.end());
+        _recvReadySessions.clear();
+
+        return;
+    }
+
+    // Read resumed, the read paused sessions will not be notified again(edge-triggered), read them by self.
+    if (UNLIKELY(!_readPausedSessions.empty()))
+    {
+        _recvReadySessions.insert(_recvReadySessions.end(), _readPausedSessions.begin(), _readPausedSessions.end());
+        _readPausedSessions.clear();
+    }
+
+    if (_recvReadySessions.empty())
+        return;
+
+    // Session maybe exhausted recv budget again while reading, swap to handling list first.
+    _handlingRecvReadySessions.swap(_recvReadySessions);
+    for (size_t i = 0; i < _handlingRecvReadySessions.size(); ++i)
+    {
+        // Session maybe removed or migrated.
+        _Sessions::iterator it = _sessions.find(_handlingRecvReadySessions[i]);
+        if (it != _sessions.end())
+            it->second->OnRecv();
+    }
+
+    _handlingRecvReadySessions.clear();
+}
+
 __LLBC_NS_END
 
 #endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
@@ -0,0 +1,121 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/FrameProfile.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const LLBC_NS LLBC_String __phaseDescs[LLBC_NS LLBC_FramePhase::End + 1] {
+    "FrameTasks",
+    "QueuedEvents",
+    "UpdateComps",
+    "UpdateTimers",
+    "UpdateReleasePool",
+    "Unknown"
+};
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+const LLBC_String &LLBC_FramePhase::Phase2Str(int phase)
+{
+    if (UNLIKELY(phase < Begin || phase >= End))
+        return LLBC_INL_NS __phaseDescs[End];
+
+    return LLBC_INL_NS __phaseDescs[phase];
+}
+
+LLBC_SlowFrameInfo::LLBC_SlowFrameInfo()
+{
+    Reset();
+}
+
+void LLBC_SlowFrameInfo::Reset()
+{
+    frameTime = 0;
+    budget = 0;
+    memset(phaseTimes, 0, sizeof(phaseTimes));
+
+    slowestComp.clear();
+    slowestCompTime = 0;
+
+    slowestTimerId = 0;
+    slowestTimerTime = 0;
+
+    slowestOpcode = -1;
+    slowestOpcodeTime = 0;
+}
+
+LLBC_String LLBC_SlowFrameInfo::ToString() const
+{
+    LLBC_String repr;
+    repr.format("frame:%.1fus(budget:%.1fus), phases:[", frameTime / 1000.0, budget / 1000.0);
+    for (int phase = LLBC_FramePhase::Begin; phase != LLBC_FramePhase::End; ++phase)
+        repr.append_format("%s%s:%.1fus",
+                           phase != LLBC_FramePhase::Begin ? ", " : "",
+                           LLBC_FramePhase::Phase2Str(phase).c_str(),
+                           phaseTimes[phase] / 1000.0);
+    repr.append("]");
+
+    if (!slowestComp.empty())
+        repr.append_format(", slowest comp:%s(%.1fus)", slowestComp.c_str(), slowestCompTime / 1000.0);
+    if (slowestTimerId != 0)
+        repr.append_format(", slowest timer:%llu(%.1fus)", slowestTimerId, slowestTimerTime / 1000.0);
+    if (slowestOpcode != -1)
+        repr.append_format(", slowest opcode:%d(%.1fus)", slowestOpcode, slowestOpcodeTime / 1000.0);
+
+    return repr;
+}
+
+LLBC_FrameProfile::LLBC_FrameProfile()
+{
+    Reset();
+}
+
+void LLBC_FrameProfile::Reset()
+{
+    beginTime = 0;
+    frameCount = 0;
+    overrunCount = 0;
+
+    frameTime.Reset();
+    for (auto &phaseTime : phaseTimes)
+        phaseTime.Reset();
+    compUpdateTimes.clear();
+}
+
+LLBC_String LLBC_FrameProfile::ToString() const
+{
+    LLBC_String repr;
+    repr.format("frames:%llu, overruns:%llu, frame:[%s]", frameCount, overrunCount, frameTime.ToString().c_str());
+    for (int phase = LLBC_FramePhase::Begin; phase != LLBC_FramePhase::End; ++phase)
+        repr.append_format("\n  %s:[%s]", LLBC_FramePhase::Phase2Str(phase).c_str(), phaseTimes[phase].ToString().c_str());
+    for (auto &compItem : compUpdateTimes)
+        repr.append_format("\n  comp %s:[%s]", compItem.first.c_str(), compItem.second.ToString().c_str());
+
+    return repr;
+}
+
+__LLBC_NS_END
@@ -0,0 +1,100 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/IdleWheel.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_IdleWheel::LLBC_IdleWheel(int tickInterval, size_t slotCount)
+: _tickInterval(MAX(1, tickInterval))
+, _curTick(LLBC_GetMilliSeconds() / _tickInterval)
+, _size(0)
+, _slots(MAX(static_cast<size_t>(2), slotCount))
+, _tickingSlot()
+{
+}
+
+size_t LLBC_IdleWheel::GetSize() const
+{
+    return _size;
+}
+
+void LLBC_IdleWheel::Add(int sessionId, sint64 deadline)
+{
+    // Deadline out of wheel range will be placed to the farthest slot, and re-added when expired.
+    const sint64 slotCount = static_cast<sint64>(_slots.size());
+    sint64 tick = deadline / _tickInterval;
+    if (tick < _curTick)
+        tick = _curTick;
+    else if (tick >= _curTick + slotCount)
+        tick = _curTick + slotCount - 1;
+
+    Entry entry;
+    entry.sessionId = sessionId;
+    entry.deadline = deadline;
+    _slots[static_cast<size_t>(tick % slotCount)].push_back(entry);
+
+    ++_size;
+}
+
+void LLBC_IdleWheel::Tick(sint64 now, std::vector<Entry> &expired)
+{
+    const sint64 nowTick = now / _tickInterval;
+    if (nowTick < _curTick)
+        return;
+
+    // Skip the ticks which elapsed more than one round, all slots will be visited once.
+    const sint64 slotCount = static_cast<sint64>(_slots.size());
+    if (nowTick - _curTick >= slotCount)
+        _curTick = nowTick - slotCount + 1;
+
+    while (_curTick <= nowTick)
+    {
+        // Advance current tick before re-add entries, re-added entries never placed to ticking slot.
+        _tickingSlot.swap(_slots[static_cast<size_t>(_curTick % slotCount)]);
+        ++_curTick;
+
+        _size -= _tickingSlot.size();
+        for (auto &entry : _tickingSlot)
+        {
+            if (entry.deadline <= now)
+                expired.push_back(entry);
+            else
+                Add(entry.sessionId, entry.deadline);
+        }
+
+        _tickingSlot.clear();
+    }
+}
+
+void LLBC_IdleWheel::Clear()
+{
+    for (auto &slot : _slots)
+        slot.clear();
+
+    _size = 0;
+}
+
+__LLBC_NS_END
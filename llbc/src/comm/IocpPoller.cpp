@@ -247,6 +247,11 @@ void LLBC_IocpPoller::RemoveSession(LLBC_Session *session)
     Base::RemoveSession(session);
 }
 
+bool LLBC_IocpPoller::IsMigratable(LLBC_Session *session) const
+{
+    return false;
+}
+
 int LLBC_IocpPoller::StartupMonitor()
 {
     const LLBC_Delegate<void()> deleg(this, &LLBC_IocpPoller::MonitorSvc);
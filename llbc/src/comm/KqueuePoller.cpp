@@ -0,0 +1,122 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/PollerType.h"
+#include "llbc/comm/KqueuePoller.h"
+
+#if LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+
+__LLBC_NS_BEGIN
+
+LLBC_KqueuePoller::LLBC_KqueuePoller()
+: _kqueue(-1)
+, _kevents()
+{
+    _pollerType = LLBC_PollerType::KqueuePoller;
+}
+
+LLBC_KqueuePoller::~LLBC_KqueuePoller()
+{
+    Stop();
+}
+
+int LLBC_KqueuePoller::InitDemux()
+{
+    if ((_kqueue = kqueue()) == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    _kevents.resize(LLBC_CFG_COMM_MAX_EVENT_COUNT);
+
+    return LLBC_OK;
+}
+
+void LLBC_KqueuePoller::DestroyDemux()
+{
+    if (_kqueue != -1)
+    {
+        close(_kqueue);
+        _kqueue = -1;
+    }
+}
+
+void LLBC_KqueuePoller::AddFd(LLBC_SocketHandle handle, int interest)
+{
+    ApplyFilters(handle, interest, true);
+}
+
+void LLBC_KqueuePoller::RemoveFd(LLBC_SocketHandle handle)
+{
+    struct kevent changes[2];
+    EV_SET(&changes[0], handle, EVFILT_READ, EV_DELETE, 0, 0, nullptr);
+    EV_SET(&changes[1], handle, EVFILT_WRITE, EV_DELETE, 0, 0, nullptr);
+
+    kevent(_kqueue, changes, 2, nullptr, 0, nullptr);
+}
+
+void LLBC_KqueuePoller::ModifyFd(LLBC_SocketHandle handle, int interest)
+{
+    ApplyFilters(handle, interest, false);
+}
+
+void LLBC_KqueuePoller::WaitFds(int timeout, _FdEvents &fdEvents)
+{
+    fdEvents.clear();
+
+    struct timespec ts;
+    ts.tv_sec = timeout / 1000;
+    ts.tv_nsec = (timeout % 1000) * 1000000;
+
+    const int readyCount = kevent(_kqueue, nullptr, 0, _kevents.data(), static_cast<int>(_kevents.size()), &ts);
+    for (int i = 0; i < readyCount; ++i)
+    {
+        const struct kevent &kev = _kevents[i];
+
+        _FdEvent fdEv;
+        fdEv.handle = static_cast<LLBC_SocketHandle>(kev.ident);
+        fdEv.readable = kev.filter == EVFILT_READ;
+        fdEv.writable = kev.filter == EVFILT_WRITE;
+        fdEv.error = (kev.flags & EV_ERROR) != 0;
+        fdEvents.push_back(fdEv);
+    }
+}
+
+void LLBC_KqueuePoller::ApplyFilters(LLBC_SocketHandle handle, int interest, bool add)
+{
+    const int addFlag = add ? EV_ADD : 0;
+    struct kevent changes[2];
+    EV_SET(&changes[0], handle, EVFILT_READ,
+           addFlag | ((interest & Interest_Read) ? EV_ENABLE : EV_DISABLE), 0, 0, nullptr);
+    EV_SET(&changes[1], handle, EVFILT_WRITE,
+           addFlag | ((interest & Interest_Write) ? EV_ENABLE : EV_DISABLE), 0, 0, nullptr);
+
+    kevent(_kqueue, changes, 2, nullptr, 0, nullptr);
+}
+
+__LLBC_NS_END
+
+#endif // LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
@@ -0,0 +1,168 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/OpcodeStats.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_LatencyHistogram::LLBC_LatencyHistogram()
+{
+    Reset();
+}
+
+void LLBC_LatencyHistogram::Record(sint64 value)
+{
+    if (UNLIKELY(value < 0))
+        value = 0;
+
+    if (_count == 0 || value < _min)
+        _min = value;
+    if (value > _max)
+        _max = value;
+
+    ++_count;
+    _sum += static_cast<double>(value);
+    ++_buckets[GetBucketIdx(static_cast<uint64>(value))];
+}
+
+void LLBC_LatencyHistogram::Reset()
+{
+    _count = 0;
+    _min = 0;
+    _max = 0;
+    _sum = 0.0;
+    memset(_buckets, 0, sizeof(_buckets));
+}
+
+uint64 LLBC_LatencyHistogram::GetCount() const
+{
+    return _count;
+}
+
+sint64 LLBC_LatencyHistogram::GetMin() const
+{
+    return _min;
+}
+
+sint64 LLBC_LatencyHistogram::GetMax() const
+{
+    return _max;
+}
+
+double LLBC_LatencyHistogram::GetMean() const
+{
+    return _count != 0 ? _sum / _count : 0.0;
+}
+
+sint64 LLBC_LatencyHistogram::GetValueAtPercentile(double percentile) const
+{
+    if (_count == 0)
+        return 0;
+
+    percentile = MIN(MAX(percentile, 0.0), 100.0);
+    uint64 target = static_cast<uint64>(percentile / 100.0 * _count + 0.5);
+    if (target == 0)
+        target = 1;
+
+    uint64 accumulated = 0;
+    for (int bucketIdx = 0; bucketIdx != BucketCount; ++bucketIdx)
+    {
+        accumulated += _buckets[bucketIdx];
+        if (accumulated >= target)
+            return MIN(static_cast<sint64>(GetBucketHighValue(bucketIdx)), _max);
+    }
+
+    return _max;
+}
+
+LLBC_String LLBC_LatencyHistogram::ToString() const
+{
+    return LLBC_String().format(
+        "cnt:%llu, min:%.1fus, mean:%.1fus, p50:%.1fus, p90:%.1fus, p99:%.1fus, p999:%.1fus, max:%.1fus",
+        _count,
+        _min / 1000.0,
+        GetMean() / 1000.0,
+        GetValueAtPercentile(50.0) / 1000.0,
+        GetValueAtPercentile(90.0) / 1000.0,
+        GetValueAtPercentile(99.0) / 1000.0,
+        GetValueAtPercentile(99.9) / 1000.0,
+        _max / 1000.0);
+}
+
+int LLBC_LatencyHistogram::GetBucketIdx(uint64 value)
+{
+    if (value < static_cast<uint64>(ExactBucketCount))
+        return static_cast<int>(value);
+
+    int highestBit = 0;
+    for (uint64 v = value; v >>= 1; )
+        ++highestBit;
+    if (highestBit >= MaxValueBits)
+        return BucketCount - 1;
+
+    // value >> shift in range [SubBucketCount, 2 * SubBucketCount).
+    const int shift = highestBit - SubBucketBits;
+    return ExactBucketCount +
+        (shift - 1) * SubBucketCount + static_cast<int>((value >> shift) - SubBucketCount);
+}
+
+uint64 LLBC_LatencyHistogram::GetBucketHighValue(int bucketIdx)
+{
+    if (bucketIdx < ExactBucketCount)
+        return static_cast<uint64>(bucketIdx);
+
+    const int shift = (bucketIdx - ExactBucketCount) / SubBucketCount + 1;
+    const uint64 subBucket = (bucketIdx - ExactBucketCount) % SubBucketCount + SubBucketCount;
+
+    return ((subBucket + 1) << shift) - 1;
+}
+
+LLBC_OpcodeStat::LLBC_OpcodeStat()
+: recvCount(0)
+, recvBytes(0)
+, sendCount(0)
+, sendBytes(0)
+{
+}
+
+void LLBC_OpcodeStat::Reset()
+{
+    recvCount = 0;
+    recvBytes = 0;
+    sendCount = 0;
+    sendBytes = 0;
+
+    decodeTime.Reset();
+    handleTime.Reset();
+}
+
+LLBC_String LLBC_OpcodeStat::ToString() const
+{
+    return LLBC_String().format(
+        "recv:%llu(%llu bytes), send:%llu(%llu bytes), decode:[%s], handle:[%s]",
+        recvCount, recvBytes, sendCount, sendBytes,
+        decodeTime.ToString().c_str(), handleTime.ToString().c_str());
+}
+
+__LLBC_NS_END
@@ -0,0 +1,123 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/OverloadPolicy.h"
+
+namespace
+{
+    typedef LLBC_NS LLBC_OverloadPolicy This;
+}
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const struct
+{
+    int flag;
+    const char *desc;
+} __g_flagDescs[] =
+{
+    {LLBC_NS LLBC_OverloadPolicy::PauseRead, "PauseRead"},
+    {LLBC_NS LLBC_OverloadPolicy::ShedLowPriority, "ShedLowPriority"},
+    {LLBC_NS LLBC_OverloadPolicy::RejectAccept, "RejectAccept"},
+};
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+bool LLBC_OverloadPolicy::IsValid(int policy)
+{
+    return (policy & ~This::All) == 0;
+}
+
+LLBC_String LLBC_OverloadPolicy::Policy2Str(int policy)
+{
+    if (!IsValid(policy))
+        return "Invalid";
+    if (policy == This::None)
+        return "None";
+
+    LLBC_String repr;
+    for (auto &flagDesc : LLBC_INL_NS __g_flagDescs)
+    {
+        if (policy & flagDesc.flag)
+            repr.append_format("%s%s", repr.empty() ? "" : "|", flagDesc.desc);
+    }
+
+    return repr;
+}
+
+int LLBC_OverloadPolicy::Str2Policy(const LLBC_String &policyStr)
+{
+    int policy = This::None;
+    const LLBC_Strings flagStrs = policyStr.split('|');
+    for (auto &flagStr : flagStrs)
+    {
+        const LLBC_String lowercased = flagStr.strip().tolower();
+        if (lowercased.empty() || lowercased == "none")
+            continue;
+
+        bool found = false;
+        for (auto &flagDesc : LLBC_INL_NS __g_flagDescs)
+        {
+            if (lowercased == LLBC_String(flagDesc.desc).tolower())
+            {
+                policy |= flagDesc.flag;
+                found = true;
+                break;
+            }
+        }
+
+        if (!found)
+            return -1;
+    }
+
+    return policy;
+}
+
+LLBC_OverloadInfo::LLBC_OverloadInfo()
+: overloaded(false)
+, policy(LLBC_OverloadPolicy::None)
+, queueDepth(0)
+, queueDelay(0)
+, overloadTime(0)
+, shedPacketCount(0)
+{
+}
+
+LLBC_String LLBC_OverloadInfo::ToString() const
+{
+    LLBC_String repr;
+    repr.format("%s overload, policy:%s, queue depth:%lu, queue delay:%lldms",
+                overloaded ? "enter" : "leave",
+                LLBC_OverloadPolicy::Policy2Str(policy).c_str(),
+                queueDepth,
+                queueDelay);
+    if (!overloaded)
+        repr.append_format(", overload time:%lldms, shed packets:%llu", overloadTime, shedPacketCount);
+
+    return repr;
+}
+
+__LLBC_NS_END
@@ -24,6 +24,7 @@
 
 #include "llbc/comm/Coder.h"
 #include "llbc/comm/Packet.h"
+#include "llbc/comm/Component.h"
 
 __LLBC_INTERNAL_NS_BEGIN
 
@@ -41,6 +42,7 @@ LLBC_Packet::LLBC_Packet()
 , _acceptSessionId(0)
 , _senderSvcId(0)
 , _recverSvcId(0)
+, _sessionInfo(nullptr)
 
 , _opcode(0)
 , _status(0)
@@ -59,6 +61,9 @@ LLBC_Packet::LLBC_Packet()
 , _preHandleResult(nullptr)
 
 , _payload(nullptr)
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+, _inlinePayload(_inlinePayloadBuf, sizeof(_inlinePayloadBuf))
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
 
 , _selfPoolInst(nullptr)
 , _msgBlockPoolInst(nullptr)
@@ -80,6 +85,16 @@ LLBC_Packet::~LLBC_Packet()
 #endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
 }
 
+const LLBC_SockAddr_IN &LLBC_Packet::GetLocalAddr() const
+{
+    return _sessionInfo ? _sessionInfo->GetLocalAddr() : _localAddr;
+}
+
+const LLBC_SockAddr_IN &LLBC_Packet::GetPeerAddr() const
+{
+    return _sessionInfo ? _sessionInfo->GetPeerAddr() : _peerAddr;
+}
+
 #if LLBC_CFG_COMM_ENABLE_STATUS_DESC
 const LLBC_String &LLBC_Packet::GetStatusDesc() const
 {
@@ -126,6 +141,15 @@ void LLBC_Packet::Clear()
     // Clear payload.
     if (_payload)
     {
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+        if (_payload == &_inlinePayload)
+        {
+            _inlinePayload.SetReadPos(0);
+            _inlinePayload.SetWritePos(0);
+            _payload = nullptr;
+        }
+        else
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
         if (_payloadDeleteDeleg)
         {
             _payloadDeleteDeleg(_payload);
@@ -158,6 +182,7 @@ void LLBC_Packet::Clear()
     _recverSvcId = 0;
     _localAddr.SetIp(0); _localAddr.SetPort(0);
     _peerAddr.SetIp(0); _peerAddr.SetPort(0);
+    _sessionInfo = nullptr;
 
     _opcode = 0;
     _status = 0;
@@ -225,9 +250,6 @@ bool LLBC_Packet::Encode()
 {
     if (_encoder)
     {
-        if (!_payload && _msgBlockPoolInst)
-            _payload = reinterpret_cast<LLBC_MessageBlock *>(_msgBlockPoolInst->Get());
-
         if (!_encoder->Encode(*this))
             return false;
 
@@ -250,6 +272,10 @@ LLBC_MessageBlock *LLBC_Packet::GiveUpPayload()
     Encode();
     if (!_payload)
         return nullptr;
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+    else if (_payload == &_inlinePayload)
+        SpillInlinePayload(0);
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
 
     LLBC_MessageBlock *block = _payload;
     _payload = nullptr;
@@ -306,11 +332,56 @@ void LLBC_Packet::CleanupPreHandleResult()
     }
 }
 
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+void LLBC_Packet::SpillInlinePayload(size_t reserveSize)
+{
+    // Create standalone message block.
+    const size_t writePos = _inlinePayload.GetWritePos();
+    LLBC_MessageBlock *block;
+    if (_msgBlockPoolInst)
+        block = reinterpret_cast<LLBC_MessageBlock *>(_msgBlockPoolInst->Get());
+    else
+        block = new LLBC_MessageBlock(writePos + reserveSize);
+
+    // Copy inline payload data(keep read position).
+    block->Write(_inlinePayloadBuf, writePos);
+    block->SetReadPos(_inlinePayload.GetReadPos());
+
+    // Reset inline payload.
+    _inlinePayload.SetReadPos(0);
+    _inlinePayload.SetWritePos(0);
+
+    _payload = block;
+}
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+
+void LLBC_Packet::SetSessionInfo(const LLBC_SessionInfo *sessionInfo)
+{
+    if (!sessionInfo && _sessionInfo)
+    {
+        _localAddr = _sessionInfo->GetLocalAddr();
+        _peerAddr = _sessionInfo->GetPeerAddr();
+    }
+
+    _sessionInfo = sessionInfo;
+}
+
 void LLBC_Packet::CleanupPayload()
 {
     if (!_payload)
         return;
 
+#if LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+    if (_payload == &_inlinePayload)
+    {
+        _inlinePayload.SetReadPos(0);
+        _inlinePayload.SetWritePos(0);
+        _payload = nullptr;
+
+        return;
+    }
+#endif // LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE > 0
+
     if (_payloadDeleteDeleg)
     {
         _payloadDeleteDeleg(_payload);
@@ -0,0 +1,343 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+ #include <fcntl.h>
+ #include <sys/mman.h>
+#endif // Non-Win32
+
+#include "llbc/comm/Packet.h"
+#include "llbc/comm/PacketCapture.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const char __magic[8] = {'L', 'L', 'B', 'C', 'C', 'A', 'P', '\0'};
+static const LLBC_NS uint32 __version = 1;
+
+static const size_t __fileHeaderLen = sizeof(__magic) + sizeof(LLBC_NS uint32) * 2;
+static const size_t __recordHeaderLen = sizeof(LLBC_NS uint32) + sizeof(LLBC_NS sint32) * 3 + sizeof(LLBC_NS sint64);
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_PacketCaptureWriter::LLBC_PacketCaptureWriter()
+: _recordCount(0)
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+, _fd(-1)
+, _mapped(nullptr)
+, _mappedSize(0)
+, _writePos(0)
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+{
+}
+
+LLBC_PacketCaptureWriter::~LLBC_PacketCaptureWriter()
+{
+    Close();
+}
+
+int LLBC_PacketCaptureWriter::Open(const LLBC_String &filePath)
+{
+    if (UNLIKELY(filePath.empty()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    if (UNLIKELY(IsOpened()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    #if LLBC_TARGET_PLATFORM_NON_WIN32
+    if ((_fd = open(filePath.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644)) == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+    #else // Win32
+    if (_file.Open(filePath, LLBC_FileMode::BinaryWrite) != LLBC_OK)
+        return LLBC_FAILED;
+    #endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+    _filePath = filePath;
+    _recordCount = 0;
+    _beginTime = LLBC_CPUTime::Current();
+
+    // Write file header.
+    const uint32 reserved = 0;
+    if (WriteData(LLBC_INL_NS __magic, sizeof(LLBC_INL_NS __magic)) != LLBC_OK ||
+        WriteData(&LLBC_INL_NS __version, sizeof(LLBC_INL_NS __version)) != LLBC_OK ||
+        WriteData(&reserved, sizeof(reserved)) != LLBC_OK)
+    {
+        const int errNo = LLBC_GetLastError();
+        Close();
+        LLBC_SetLastError(errNo);
+
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
+void LLBC_PacketCaptureWriter::Close()
+{
+    if (!IsOpened())
+        return;
+
+    #if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Unmap & truncate file to real size.
+    if (_mapped)
+        munmap(_mapped, _mappedSize);
+    if (ftruncate(_fd, static_cast<off_t>(_writePos)) != 0)
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+    close(_fd);
+
+    _fd = -1;
+    _mapped = nullptr;
+    _mappedSize = 0;
+    _writePos = 0;
+    #else // Win32
+    _file.Close();
+    #endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+    _filePath.clear();
+}
+
+bool LLBC_PacketCaptureWriter::IsOpened() const
+{
+    #if LLBC_TARGET_PLATFORM_NON_WIN32
+    return _fd != -1;
+    #else // Win32
+    return _file.IsOpened();
+    #endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
+const LLBC_String &LLBC_PacketCaptureWriter::GetFilePath() const
+{
+    return _filePath;
+}
+
+uint64 LLBC_PacketCaptureWriter::GetRecordCount() const
+{
+    return _recordCount;
+}
+
+int LLBC_PacketCaptureWriter::Write(const LLBC_Packet &packet)
+{
+    if (UNLIKELY(!IsOpened()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_OPEN);
+        return LLBC_FAILED;
+    }
+
+    const size_t payloadLen = packet.GetRawPayloadLength();
+    if (UNLIKELY(payloadLen > static_cast<size_t>(0xffffffffu)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    // Build record header.
+    char header[LLBC_INL_NS __recordHeaderLen];
+    char *headerPtr = header;
+
+    const uint32 len = static_cast<uint32>(payloadLen);
+    const sint32 sessionId = packet.GetSessionId();
+    const sint32 opcode = packet.GetOpcode();
+    const sint32 status = packet.GetStatus();
+    const sint64 timestamp = (LLBC_CPUTime::Current() - _beginTime).ToNanoSeconds();
+
+    memcpy(headerPtr, &len, sizeof(len)), headerPtr += sizeof(len);
+    memcpy(headerPtr, &sessionId, sizeof(sessionId)), headerPtr += sizeof(sessionId);
+    memcpy(headerPtr, &opcode, sizeof(opcode)), headerPtr += sizeof(opcode);
+    memcpy(headerPtr, &status, sizeof(status)), headerPtr += sizeof(status);
+    memcpy(headerPtr, &timestamp, sizeof(timestamp));
+
+    // Write record header & payload.
+    if (WriteData(header, sizeof(header)) != LLBC_OK ||
+        (payloadLen > 0 && WriteData(packet.GetRawPayload(), payloadLen) != LLBC_OK))
+        return LLBC_FAILED;
+
+    ++_recordCount;
+
+    return LLBC_OK;
+}
+
+int LLBC_PacketCaptureWriter::WriteData(const void *data, size_t len)
+{
+    #if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (_writePos + len > _mappedSize && Reserve(len) != LLBC_OK)
+        return LLBC_FAILED;
+
+    memcpy(_mapped + _writePos, data, len);
+    _writePos += len;
+
+    return LLBC_OK;
+    #else // Win32
+    return _file.Write(data, len) == static_cast<long>(len) ? LLBC_OK : LLBC_FAILED;
+    #endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+int LLBC_PacketCaptureWriter::Reserve(size_t len)
+{
+    // Grow mapped size, aligned to LLBC_CFG_COMM_PACKET_CAPTURE_MAP_SIZE.
+    const size_t growSize = LLBC_CFG_COMM_PACKET_CAPTURE_MAP_SIZE;
+    const size_t newSize = (_writePos + len + growSize - 1) / growSize * growSize;
+    if (_mapped)
+    {
+        munmap(_mapped, _mappedSize);
+        _mapped = nullptr;
+        _mappedSize = 0;
+    }
+
+    if (ftruncate(_fd, static_cast<off_t>(newSize)) != 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    void *mapped = mmap(nullptr, newSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    _mapped = reinterpret_cast<char *>(mapped);
+    _mappedSize = newSize;
+
+    return LLBC_OK;
+}
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+LLBC_PacketCaptureReader::LLBC_PacketCaptureReader()
+: _opened(false)
+, _readPos(0)
+{
+}
+
+int LLBC_PacketCaptureReader::Open(const LLBC_String &filePath)
+{
+    if (UNLIKELY(_opened))
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    LLBC_File file;
+    if (file.Open(filePath, LLBC_FileMode::BinaryRead) != LLBC_OK)
+        return LLBC_FAILED;
+
+    _content = file.ReadToEnd();
+    file.Close();
+
+    // Validate file header.
+    if (_content.size() < LLBC_INL_NS __fileHeaderLen ||
+        memcmp(_content.data(), LLBC_INL_NS __magic, sizeof(LLBC_INL_NS __magic)) != 0 ||
+        memcmp(_content.data() + sizeof(LLBC_INL_NS __magic),
+               &LLBC_INL_NS __version,
+               sizeof(LLBC_INL_NS __version)) != 0)
+    {
+        _content.clear();
+        LLBC_SetLastError(LLBC_ERROR_FORMAT);
+
+        return LLBC_FAILED;
+    }
+
+    _opened = true;
+    _readPos = LLBC_INL_NS __fileHeaderLen;
+
+    return LLBC_OK;
+}
+
+void LLBC_PacketCaptureReader::Close()
+{
+    _opened = false;
+    _content.clear();
+    _readPos = 0;
+}
+
+bool LLBC_PacketCaptureReader::IsOpened() const
+{
+    return _opened;
+}
+
+int LLBC_PacketCaptureReader::Read(LLBC_PacketCaptureRecord &record)
+{
+    if (UNLIKELY(!_opened))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_OPEN);
+        return LLBC_FAILED;
+    }
+
+    const size_t remain = _content.size() - _readPos;
+    if (remain == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_END);
+        return LLBC_FAILED;
+    }
+    else if (remain < LLBC_INL_NS __recordHeaderLen)
+    {
+        LLBC_SetLastError(LLBC_ERROR_FORMAT);
+        return LLBC_FAILED;
+    }
+
+    // Read record header.
+    const char *headerPtr = _content.data() + _readPos;
+
+    uint32 len;
+    memcpy(&len, headerPtr, sizeof(len)), headerPtr += sizeof(len);
+    memcpy(&record.sessionId, headerPtr, sizeof(sint32)), headerPtr += sizeof(sint32);
+    memcpy(&record.opcode, headerPtr, sizeof(sint32)), headerPtr += sizeof(sint32);
+    memcpy(&record.status, headerPtr, sizeof(sint32)), headerPtr += sizeof(sint32);
+    memcpy(&record.timestamp, headerPtr, sizeof(sint64));
+
+    if (remain - LLBC_INL_NS __recordHeaderLen < len)
+    {
+        LLBC_SetLastError(LLBC_ERROR_FORMAT);
+        return LLBC_FAILED;
+    }
+
+    // Fill record payload.
+    record.payload = _content.data() + _readPos + LLBC_INL_NS __recordHeaderLen;
+    record.payloadLen = len;
+
+    _readPos += LLBC_INL_NS __recordHeaderLen + len;
+
+    return LLBC_OK;
+}
+
+void LLBC_PacketCaptureReader::Rewind()
+{
+    if (_opened)
+        _readPos = LLBC_INL_NS __fileHeaderLen;
+}
+
+__LLBC_NS_END
@@ -0,0 +1,509 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/Socket.h"
+#include "llbc/comm/Session.h"
+#include "llbc/comm/ServiceEvent.h"
+#include "llbc/comm/PollerType.h"
+#include "llbc/comm/PollPoller.h"
+#include "llbc/comm/Service.h"
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+
+namespace
+{
+    typedef LLBC_NS LLBC_BasePoller Base;
+}
+
+__LLBC_NS_BEGIN
+
+LLBC_PollPoller::LLBC_PollPoller()
+: _pollerType(LLBC_PollerType::PollPoller)
+
+, _waiting(false)
+
+, _readPaused(false)
+, _interests()
+, _fdEvents()
+
+, _pollFds()
+, _pollFdIndexes()
+{
+    _wakeupFds[0] = _wakeupFds[1] = LLBC_INVALID_SOCKET_HANDLE;
+}
+
+LLBC_PollPoller::~LLBC_PollPoller()
+{
+    Stop();
+}
+
+int LLBC_PollPoller::Start()
+{
+    if (_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    // Create demultiplexer & wakeup pipe.
+    if (InitDemux() != LLBC_OK)
+        return LLBC_FAILED;
+
+    if (pipe(_wakeupFds) != 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        DestroyDemux();
+
+        return LLBC_FAILED;
+    }
+
+    LLBC_SetNonBlocking(_wakeupFds[0]);
+    LLBC_SetNonBlocking(_wakeupFds[1]);
+    AddFd(_wakeupFds[0], Interest_Read);
+
+    if (Activate() != LLBC_OK)
+    {
+        close(_wakeupFds[0]);
+        close(_wakeupFds[1]);
+        _wakeupFds[0] = _wakeupFds[1] = LLBC_INVALID_SOCKET_HANDLE;
+
+        DestroyDemux();
+
+        return LLBC_FAILED;
+    }
+
+    _started = true;
+    return LLBC_OK;
+}
+
+void LLBC_PollPoller::Svc()
+{
+    while (!_started)
+        LLBC_Sleep(20);
+
+    // Wait fd events at most maxWaitTime, make sure idle sessions can be checked in time.
+    static const int maxWaitTime = 50;
+    while (!_stopping)
+    {
+        HandleQueuedEvents(0);
+        UpdateReadPaused();
+
+        // Set waiting flag before check queued events, the pusher will wake up poller if flag set.
+        _waiting = true;
+        WaitFds(GetMessageSize() > 0 ? 0 : maxWaitTime, _fdEvents);
+        _waiting = false;
+
+        for (size_t i = 0; i < _fdEvents.size(); ++i)
+            HandleFdEvent(_fdEvents[i]);
+    }
+}
+
+void LLBC_PollPoller::Cleanup()
+{
+    close(_wakeupFds[0]);
+    close(_wakeupFds[1]);
+    _wakeupFds[0] = _wakeupFds[1] = LLBC_INVALID_SOCKET_HANDLE;
+
+    DestroyDemux();
+
+    _readPaused = false;
+    _interests.clear();
+    _fdEvents.clear();
+
+    Base::Cleanup();
+}
+
+int LLBC_PollPoller::Push(LLBC_MessageBlock *block)
+{
+    const int ret = Base::Push(block);
+    if (_waiting)
+        Wakeup();
+
+    return ret;
+}
+
+void LLBC_PollPoller::HandleEv_AsyncConn(LLBC_PollerEvent &ev)
+{
+    LLBC_Socket *socket = new LLBC_Socket;
+    socket->SetNonBlocking();
+    socket->SetPollerType(_pollerType);
+
+    const LLBC_SocketHandle handle = socket->Handle();
+    if (socket->Connect(ev.peerAddr) == LLBC_OK)
+    {
+        _svc->Push(LLBC_SvcEvUtil::
+                BuildAsyncConnResultEv(ev.sessionId, true, "Success", ev.peerAddr));
+
+        SetConnectedSocketOpts(socket, *ev.sessionOpts);
+        AddSession(CreateSession(socket, ev.sessionId, *ev.sessionOpts, nullptr));
+
+        LLBC_XDelete(ev.sessionOpts);
+    }
+    else if (LLBC_GetLastError() == LLBC_ERROR_WBLOCK)
+    {
+        LLBC_AsyncConnInfo conn;
+        conn.socket = socket;
+        conn.peerAddr = ev.peerAddr;
+        conn.sessionId = ev.sessionId;
+        conn.sessionOpts = *ev.sessionOpts;
+
+        _connecting.insert(std::make_pair(handle, conn));
+        WatchFd(handle, Interest_Write);
+
+        LLBC_XDelete(ev.sessionOpts);
+    }
+    else
+    {
+        delete socket;
+        LLBC_XDelete(ev.sessionOpts);
+
+        _svc->Push(LLBC_SvcEvUtil::
+                BuildAsyncConnResultEv(ev.sessionId, false, LLBC_FormatLastError(), ev.peerAddr));
+    }
+}
+
+void LLBC_PollPoller::HandleEv_Send(LLBC_PollerEvent &ev)
+{
+    const int sessionId = ev.un.packet->GetSessionId();
+
+    Base::HandleEv_Send(ev);
+
+    // Try send immediately, only watch writable event if send data remained.
+    _Sessions::iterator it = _sessions.find(sessionId);
+    if (it != _sessions.end())
+        FlushSend(it->second);
+}
+
+void LLBC_PollPoller::HandleEv_Monitor(LLBC_PollerEvent &ev)
+{
+    ASSERT(false && "Poll Poller could not process Monitor Event");
+}
+
+void LLBC_PollPoller::AddSession(LLBC_Session *session)
+{
+    Base::AddSession(session);
+
+    // Migrated/Taken over session maybe has pending send data.
+    LLBC_Socket *sock = session->GetSocket();
+    int interest = sock->IsListen() ? Interest_Accept : Interest_Read;
+    if (sock->IsExistNoSendData())
+        interest |= Interest_Write;
+
+    WatchFd(session->GetSocketHandle(), interest);
+}
+
+void LLBC_PollPoller::RemoveSession(LLBC_Session *session)
+{
+    UnwatchFd(session->GetSocketHandle());
+
+    Base::RemoveSession(session);
+}
+
+void LLBC_PollPoller::DetachSession(LLBC_Session *session)
+{
+    UnwatchFd(session->GetSocketHandle());
+
+    Base::DetachSession(session);
+}
+
+void LLBC_PollPoller::FlushSend(LLBC_Session *session)
+{
+    const int sessionId = session->GetId();
+    session->OnSend();
+
+    // Session maybe removed in OnSend().
+    _Sessions::iterator it = _sessions.find(sessionId);
+    if (it == _sessions.end())
+        return;
+
+    session = it->second;
+    SetWriteInterest(session->GetSocketHandle(),
+                     session->GetSocket()->IsExistNoSendData());
+}
+
+int LLBC_PollPoller::InitDemux()
+{
+    _pollFds.clear();
+    _pollFdIndexes.clear();
+
+    return LLBC_OK;
+}
+
+void LLBC_PollPoller::DestroyDemux()
+{
+    _pollFds.clear();
+    _pollFdIndexes.clear();
+}
+
+void LLBC_PollPoller::AddFd(LLBC_SocketHandle handle, int interest)
+{
+    struct pollfd pfd;
+    pfd.fd = handle;
+    pfd.events = ((interest & Interest_Read) ? POLLIN : 0) | ((interest & Interest_Write) ? POLLOUT : 0);
+    pfd.revents = 0;
+
+    _pollFdIndexes[handle] = _pollFds.size();
+    _pollFds.push_back(pfd);
+}
+
+void LLBC_PollPoller::RemoveFd(LLBC_SocketHandle handle)
+{
+    std::unordered_map<LLBC_SocketHandle, size_t>::iterator it = _pollFdIndexes.find(handle);
+    if (it == _pollFdIndexes.end())
+        return;
+
+    // Swap-remove, move the last pollfd to the removed position.
+    const size_t idx = it->second;
+    _pollFdIndexes.erase(it);
+    if (idx != _pollFds.size() - 1)
+    {
+        _pollFds[idx] = _pollFds.back();
+        _pollFdIndexes[_pollFds[idx].fd] = idx;
+    }
+
+    _pollFds.pop_back();
+}
+
+void LLBC_PollPoller::ModifyFd(LLBC_SocketHandle handle, int interest)
+{
+    std::unordered_map<LLBC_SocketHandle, size_t>::iterator it = _pollFdIndexes.find(handle);
+    if (it != _pollFdIndexes.end())
+        _pollFds[it->second].events =
+            ((interest & Interest_Read) ? POLLIN : 0) | ((interest & Interest_Write) ? POLLOUT : 0);
+}
+
+void LLBC_PollPoller::WaitFds(int timeout, _FdEvents &fdEvents)
+{
+    fdEvents.clear();
+
+    int readyCount = poll(_pollFds.data(), static_cast<nfds_t>(_pollFds.size()), timeout);
+    for (size_t i = 0; i < _pollFds.size() && readyCount > 0; ++i)
+    {
+        const struct pollfd &pfd = _pollFds[i];
+        if (pfd.revents == 0)
+            continue;
+
+        --readyCount;
+
+        _FdEvent fdEv;
+        fdEv.handle = pfd.fd;
+        fdEv.readable = (pfd.revents & (POLLIN | POLLHUP)) != 0;
+        fdEv.writable = (pfd.revents & POLLOUT) != 0;
+        fdEv.error = (pfd.revents & (POLLERR | POLLNVAL)) != 0;
+        fdEvents.push_back(fdEv);
+    }
+}
+
+void LLBC_PollPoller::WatchFd(LLBC_SocketHandle handle, int interest)
+{
+    _interests[handle] = interest;
+    AddFd(handle, ToDemuxInterest(interest));
+}
+
+void LLBC_PollPoller::UnwatchFd(LLBC_SocketHandle handle)
+{
+    if (_interests.erase(handle) > 0)
+        RemoveFd(handle);
+}
+
+void LLBC_PollPoller::SetWriteInterest(LLBC_SocketHandle handle, bool write)
+{
+    std::unordered_map<LLBC_SocketHandle, int>::iterator it = _interests.find(handle);
+    if (it == _interests.end())
+        return;
+
+    const int interest = write ? (it->second | Interest_Write) : (it->second & ~Interest_Write);
+    if (interest == it->second)
+        return;
+
+    it->second = interest;
+    ModifyFd(handle, ToDemuxInterest(interest));
+}
+
+int LLBC_PollPoller::ToDemuxInterest(int interest) const
+{
+    int demuxInterest = interest & Interest_Write;
+    if ((interest & Interest_Accept) ||
+        ((interest & Interest_Read) && !_readPaused))
+        demuxInterest |= Interest_Read;
+
+    return demuxInterest;
+}
+
+void LLBC_PollPoller::UpdateReadPaused()
+{
+    const bool readPaused = IsReadPaused();
+    if (LIKELY(readPaused == _readPaused))
+        return;
+
+    // Read paused state changed, update all session sockets read interest.
+    _readPaused = readPaused;
+    for (std::unordered_map<LLBC_SocketHandle, int>::iterator it = _interests.begin();
+         it != _interests.end();
+         ++it)
+    {
+        if (it->second & Interest_Read)
+            ModifyFd(it->first, ToDemuxInterest(it->second));
+    }
+}
+
+void LLBC_PollPoller::Wakeup()
+{
+    // Write failed(EAGAIN) means wakeup pipe has unread data, poller will be woken up anyway.
+    const char ch = 0;
+    const ssize_t ret = write(_wakeupFds[1], &ch, 1);
+    (void)ret;
+}
+
+void LLBC_PollPoller::DrainWakeup()
+{
+    char buf[64];
+    while (read(_wakeupFds[0], buf, sizeof(buf)) > 0)
+        ;
+}
+
+void LLBC_PollPoller::HandleFdEvent(const _FdEvent &fdEv)
+{
+    if (fdEv.handle == _wakeupFds[0])
+    {
+        DrainWakeup();
+        return;
+    }
+
+    // Connecting socket.
+    _Connecting::iterator connIt = _connecting.find(fdEv.handle);
+    if (connIt != _connecting.end())
+    {
+        HandleConnecting(connIt, fdEv);
+        return;
+    }
+
+    // Session socket, maybe removed by previous fd event.
+    _Sockets::iterator sockIt = _sockets.find(fdEv.handle);
+    if (sockIt == _sockets.end())
+        return;
+
+    LLBC_Session *session = sockIt->second;
+    if (fdEv.error && !fdEv.readable)
+    {
+        int sockErr;
+        LLBC_SessionCloseInfo *closeInfo;
+        if (UNLIKELY(session->GetSocket()->GetPendingError(sockErr) != LLBC_OK))
+            closeInfo = new LLBC_SessionCloseInfo;
+        else
+            closeInfo = new LLBC_SessionCloseInfo(LLBC_ERROR_CLIB, sockErr);
+
+        session->OnClose(closeInfo);
+        return;
+    }
+
+    if (fdEv.readable)
+    {
+        if (session->GetSocket()->IsListen())
+        {
+            Accept(session);
+            return;
+        }
+
+        const int sessionId = session->GetId();
+        session->OnRecv();
+        if (!fdEv.writable)
+            return;
+
+        // Session maybe removed in OnRecv().
+        _Sessions::iterator it = _sessions.find(sessionId);
+        if (it == _sessions.end())
+            return;
+
+        session = it->second;
+    }
+
+    if (fdEv.writable)
+        FlushSend(session);
+}
+
+void LLBC_PollPoller::Accept(LLBC_Session *session)
+{
+    LLBC_Socket *newSocket = session->GetSocket()->Accept();
+    if (LIKELY(newSocket))
+    {
+        // Service overloaded, close new accepted socket immediately.
+        if (UNLIKELY(IsAcceptRejected()))
+        {
+            delete newSocket;
+            return;
+        }
+
+        newSocket->SetNonBlocking();
+        newSocket->SetPollerType(_pollerType);
+
+        SetConnectedSocketOpts(newSocket, session->GetSessionOpts());
+        AddToPoller(CreateSession(newSocket, 0, session->GetSessionOpts(), session));
+    }
+}
+
+void LLBC_PollPoller::HandleConnecting(_Connecting::iterator it, const _FdEvent &fdEv)
+{
+    LLBC_AsyncConnInfo &asyncInfo = it->second;
+    LLBC_Socket *socket = asyncInfo.socket;
+
+    UnwatchFd(it->first);
+
+    int sockErr;
+    bool connected = false;
+    const char *reason = nullptr;
+    if (UNLIKELY(socket->GetPendingError(sockErr) != LLBC_OK))
+    {
+        reason = LLBC_FormatLastError();
+    }
+    else if (sockErr != 0)
+    {
+        reason = LLBC_StrErrorEx(LLBC_ERROR_CLIB, sockErr);
+    }
+    else
+    {
+        connected = fdEv.writable;
+        reason = LLBC_StrError(connected ? LLBC_ERROR_SUCCESS : LLBC_ERROR_UNKNOWN);
+    }
+
+    // Build async connect event and push it to service.
+    _svc->Push(LLBC_SvcEvUtil::BuildAsyncConnResultEv(asyncInfo.sessionId, connected, reason, asyncInfo.peerAddr));
+
+    if (connected)
+    {
+        SetConnectedSocketOpts(socket, asyncInfo.sessionOpts);
+        AddSession(CreateSession(socket, asyncInfo.sessionId, asyncInfo.sessionOpts, nullptr));
+    }
+    else
+    {
+        delete socket;
+    }
+
+    _connecting.erase(it);
+}
+
+__LLBC_NS_END
+
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
@@ -175,6 +175,29 @@ LLBC_MessageBlock * LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(int sessionId,
     return block;
 }
 
+LLBC_MessageBlock *LLBC_PollerEvUtil::BuildMigrateSessionEv(int sessionId, int toPollerId)
+{
+    _Block *block = new _Block(sizeof(_Ev));
+    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
+    ev.type = _Ev::MigrateSession;
+    ev.sessionId = sessionId;
+    ev.un.toPollerId = toPollerId;
+
+    block->SetWritePos(sizeof(_Ev));
+    return block;
+}
+
+LLBC_MessageBlock *LLBC_PollerEvUtil::BuildSendFileEv(LLBC_FileRegion *fileRegion)
+{
+    _Block *block = new _Block(sizeof(_Ev));
+    _Ev &ev = *reinterpret_cast<_Ev *>(block->GetData());
+    ev.type = _Ev::SendFile;
+    ev.un.fileRegion = fileRegion;
+
+    block->SetWritePos(sizeof(_Ev));
+    return block;
+}
+
 void LLBC_PollerEvUtil::DestroyEv(LLBC_PollerEvent &ev)
 {
     switch (ev.type)
@@ -208,6 +231,14 @@ void LLBC_PollerEvUtil::DestroyEv(LLBC_PollerEvent &ev)
         delete ev.un.protocolStackCtrlInfo.ctrlData;
         break;
 
+    case _Ev::SendFile:
+        LLBC_Recycle(ev.un.fileRegion->header);
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+        close(ev.un.fileRegion->fd);
+#endif // Non-Win32
+        delete ev.un.fileRegion;
+        break;
+
     default:
         break;
     }
@@ -25,6 +25,7 @@
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/PollerType.h"
+#include "llbc/comm/PollerPlacePolicy.h"
 #include "llbc/comm/PollerEvent.h"
 #include "llbc/comm/BasePoller.h"
 #include "llbc/comm/PollerMgr.h"
@@ -64,9 +65,23 @@ LLBC_PollerMgr::LLBC_PollerMgr()
 , _pollerCount(0)
 , _pollers(nullptr)
 , _pollerLock()
+, _retiredPollers()
+, _pollerThreadName()
+, _pollerCPUMask(0)
+, _pollerCPUSpread(false)
+, _busyPollWindow(0)
+, _overloadFlags(0)
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+, _queueStatsEnabled(false)
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
 
 , _maxSessionId(1)
 
+, _placePolicy(LLBC_PollerPlacePolicy::Modulo)
+, _routes()
+, _routeCounts()
+, _routeLock()
+
 , _pendingAddSocks()
 , _pendingAsyncConns()
 {
@@ -77,6 +92,11 @@ LLBC_PollerMgr::~LLBC_PollerMgr()
     Stop();
 }
 
+int LLBC_PollerMgr::GetPollerType() const
+{
+    return _type;
+}
+
 void LLBC_PollerMgr::SetPollerType(int type)
 {
     _type = type;
@@ -87,6 +107,29 @@ void LLBC_PollerMgr::SetService(LLBC_Service *svc)
     _svc = svc;
 }
 
+int LLBC_PollerMgr::GetPlacePolicy() const
+{
+    return _placePolicy;
+}
+
+int LLBC_PollerMgr::SetPlacePolicy(int policy)
+{
+    if (!LLBC_PollerPlacePolicy::IsValid(policy))
+    {
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return LLBC_FAILED;
+    }
+
+    _placePolicy = policy;
+
+    return LLBC_OK;
+}
+
+int LLBC_PollerMgr::GetPollerCount() const
+{
+    return _pollerCount;
+}
+
 int LLBC_PollerMgr::Start(int count)
 {
     if (count <= 0)
@@ -94,6 +137,11 @@ int LLBC_PollerMgr::Start(int count)
         LLBC_SetLastError(LLBC_ERROR_INVALID);
         return LLBC_FAILED;
     }
+    else if (count > LLBC_CFG_COMM_MAX_POLLER_COUNT)
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
     else if (_pollers)
     {
         LLBC_SetLastError(LLBC_ERROR_REENTRY);
@@ -101,8 +149,11 @@ int LLBC_PollerMgr::Start(int count)
     }
 
     _pollerCount = count;
-    _pollers = LLBC_Malloc(LLBC_BasePoller *, sizeof(LLBC_BasePoller *) * count);
-    memset(_pollers, 0, sizeof(LLBC_BasePoller *) * count);
+    _routeCounts.assign(count, 0);
+
+    // Pollers array always allocate max poller count slots, avoid reallocate when poller count changed.
+    _pollers = LLBC_Malloc(LLBC_BasePoller *, sizeof(LLBC_BasePoller *) * LLBC_CFG_COMM_MAX_POLLER_COUNT);
+    memset(_pollers, 0, sizeof(LLBC_BasePoller *) * LLBC_CFG_COMM_MAX_POLLER_COUNT);
 
     // Create pollers.
     for (int i = 0; i < count; ++i)
@@ -112,6 +163,11 @@ int LLBC_PollerMgr::Start(int count)
         _pollers[i]->SetService(_svc);
         _pollers[i]->SetPollerMgr(this);
         _pollers[i]->SetBrothersCount(count);
+        ApplyPollerThreadCfg(_pollers[i], i);
+        _pollers[i]->SetBusyPollWindow(_busyPollWindow);
+        #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+        _pollers[i]->SetQueueStatsEnabled(_queueStatsEnabled);
+        #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
     }
 
     // Startup all pollers.
@@ -122,7 +178,7 @@ int LLBC_PollerMgr::Start(int count)
     for (_PendingAddSocks::iterator it = _pendingAddSocks.begin();
          it != _pendingAddSocks.end();
          ++it)
-         _pollers[it->first % _pollerCount]->Push(
+         _pollers[PlaceSession(it->first, it->second.second)]->Push(
                 LLBC_PollerEvUtil::BuildAddSockEv(it->second.first, it->first, it->second.second));
     _pendingAddSocks.clear();
 
@@ -131,7 +187,7 @@ int LLBC_PollerMgr::Start(int count)
          it != _pendingAsyncConns.end();
          ++it)
     {
-        _pollers[it->first % _pollerCount]->Push(
+        _pollers[PlaceSession(it->first, it->second.second)]->Push(
             LLBC_PollerEvUtil::BuildAsyncConnEv(it->first, it->second.second, it->second.first));
     }
     _pendingAsyncConns.clear();
@@ -160,10 +216,202 @@ void LLBC_PollerMgr::Stop()
         _pollerCount = 0;
     }
 
+    // Delete all retired pollers.
+    LLBC_STLHelper::DeleteContainer(_retiredPollers);
+
+    // Cleanup all routes.
+    _routeLock.Lock();
+    _routes.clear();
+    _routeCounts.clear();
+    _routeLock.Unlock();
+
     // Reset max sessionId.
     _maxSessionId = 1;
 }
 
+int LLBC_PollerMgr::SetPollerCount(int count)
+{
+    if (!_pollers)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+    else if (count <= 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return LLBC_FAILED;
+    }
+    else if (count > LLBC_CFG_COMM_MAX_POLLER_COUNT)
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+#if LLBC_TARGET_PLATFORM_WIN32
+    // Iocp poller sessions could not migrate, so poller count could not change.
+    if (_type == LLBC_PollerType::IocpPoller)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+        return LLBC_FAILED;
+    }
+#endif // LLBC_TARGET_PLATFORM_WIN32
+
+    const int oldCount = _pollerCount;
+    if (count == oldCount)
+        return LLBC_OK;
+
+    if (count > oldCount)
+    {
+        // Create and startup new pollers.
+        for (int i = oldCount; i < count; ++i)
+        {
+            LLBC_BasePoller *poller = LLBC_BasePoller::Create(_type);
+            poller->SetPollerId(i);
+            poller->SetService(_svc);
+            poller->SetPollerMgr(this);
+            poller->SetBrothersCount(count);
+            ApplyPollerThreadCfg(poller, i);
+            poller->SetBusyPollWindow(_busyPollWindow);
+            #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+            poller->SetQueueStatsEnabled(_queueStatsEnabled);
+            #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+            _pollerLock.Lock();
+            _pollers[i] = poller;
+            _pollerLock.Unlock();
+
+            if (poller->Start() != LLBC_OK)
+            {
+                // New pollers not placed any session, stop and delete them directly.
+                for (int j = oldCount; j <= i; ++j)
+                {
+                    LLBC_BasePoller *newPoller = _pollers[j];
+                    newPoller->Stop();
+
+                    _pollerLock.Lock();
+                    _pollers[j] = nullptr;
+                    _pollerLock.Unlock();
+
+                    delete newPoller;
+                }
+
+                return LLBC_FAILED;
+            }
+        }
+
+        // Let new pollers join the session placing.
+        _routeLock.Lock();
+        if (static_cast<int>(_routeCounts.size()) < count)
+            _routeCounts.resize(count, 0);
+        _pollerCount = count;
+        _routeLock.Unlock();
+
+        for (int i = 0; i < oldCount; ++i)
+            _pollers[i]->SetBrothersCount(count);
+
+        return LLBC_OK;
+    }
+
+    // Stop placing session to removed pollers, and drain them.
+    _routeLock.Lock();
+    _pollerCount = count;
+    _routeLock.Unlock();
+
+    for (int i = 0; i < count; ++i)
+        _pollers[i]->SetBrothersCount(count);
+    for (int i = count; i < oldCount; ++i)
+        _pollers[i]->Drain();
+
+    // Wait removed pollers drained and stop them, the stale events maybe still pushing to
+    // removed pollers, so the poller objects will be deleted when poller manager stop.
+    for (int i = count; i < oldCount; ++i)
+    {
+        LLBC_BasePoller *poller = _pollers[i];
+        while (!poller->IsDrained())
+            LLBC_Sleep(20);
+
+        poller->Stop();
+        _retiredPollers.push_back(poller);
+    }
+
+    return LLBC_OK;
+}
+
+void LLBC_PollerMgr::SetPollerThreadName(const LLBC_String &namePrefix)
+{
+    _pollerThreadName = namePrefix;
+}
+
+void LLBC_PollerMgr::SetPollerCPUAffinity(uint64 cpuMask, bool spread)
+{
+    _pollerCPUMask = cpuMask;
+    _pollerCPUSpread = spread;
+}
+
+int LLBC_PollerMgr::GetBusyPollWindow() const
+{
+    return _busyPollWindow;
+}
+
+void LLBC_PollerMgr::SetBusyPollWindow(int busyPollWindow)
+{
+    LLBC_LockGuard guard(_pollerLock);
+
+    _busyPollWindow = busyPollWindow;
+    if (_pollers)
+    {
+        for (int i = 0; i < _pollerCount; ++i)
+            _pollers[i]->SetBusyPollWindow(busyPollWindow);
+    }
+}
+
+int LLBC_PollerMgr::GetOverloadFlags() const
+{
+    return _overloadFlags;
+}
+
+void LLBC_PollerMgr::SetOverloadFlags(int overloadFlags)
+{
+    _overloadFlags = overloadFlags;
+}
+
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+void LLBC_PollerMgr::SetQueueStatsEnabled(bool enabled)
+{
+    LLBC_LockGuard guard(_pollerLock);
+
+    _queueStatsEnabled = enabled;
+    if (_pollers)
+    {
+        for (int i = 0; i < _pollerCount; ++i)
+            _pollers[i]->SetQueueStatsEnabled(enabled);
+    }
+}
+
+void LLBC_PollerMgr::GetQueueStats(std::vector<LLBC_QueueStat> &stats) const
+{
+    LLBC_LockGuard guard(_pollerLock);
+
+    stats.clear();
+    if (!_pollers)
+        return;
+
+    stats.resize(_pollerCount);
+    for (int i = 0; i < _pollerCount; ++i)
+        _pollers[i]->GetQueueStat(stats[i]);
+}
+
+void LLBC_PollerMgr::ResetQueueStats()
+{
+    LLBC_LockGuard guard(_pollerLock);
+    if (!_pollers)
+        return;
+
+    for (int i = 0; i < _pollerCount; ++i)
+        _pollers[i]->ResetQueueStat();
+}
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 int LLBC_PollerMgr::Listen(const char *ip, uint16 port, LLBC_IProtocolFactory *protoFactory, const LLBC_SessionOpts &sessionOpts)
 {
     LLBC_SockAddr_IN local;
@@ -189,19 +437,8 @@ int LLBC_PollerMgr::Listen(const char *ip, uint16 port, LLBC_IProtocolFactory *p
         return 0;
     }
 
-    // Allocate sessionId and add proto factory to service(is exist).
-    const int sessionId = AllocSessionId();
-    if (protoFactory)
-        _svc->AddSessionProtocolFactory(sessionId, protoFactory);
-
-    // Add to poller or pending.
-    if (LIKELY(_pollers))
-        _pollers[sessionId % _pollerCount]->Push(
-                LLBC_PollerEvUtil::BuildAddSockEv(sock, sessionId, sessionOpts));
-    else
-        _pendingAddSocks.insert(std::make_pair(sessionId, std::make_pair(sock, sessionOpts)));
-
-    return sessionId;
+    // Allocate sessionId, add proto factory to service(is exist) and add to poller.
+    return AddSocket(sock, protoFactory, sessionOpts);
 }
 
 int LLBC_PollerMgr::Connect(const char *ip, uint16 port, LLBC_IProtocolFactory *protoFactory, const LLBC_SessionOpts &sessionOpts)
@@ -226,19 +463,8 @@ int LLBC_PollerMgr::Connect(const char *ip, uint16 port, LLBC_IProtocolFactory *
         return 0;
     }
 
-    // Allocate session and add protoFactory to service(if exist).
-    const int sessionId = AllocSessionId();
-    if (protoFactory)
-        _svc->AddSessionProtocolFactory(sessionId, protoFactory);
-
-    // Add to poller or pending.
-    if (LIKELY(_pollers))
-        _pollers[sessionId % _pollerCount]->Push(
-                LLBC_PollerEvUtil::BuildAddSockEv(sock, sessionId, sessionOpts));
-    else
-        _pendingAddSocks.insert(std::make_pair(sessionId, std::make_pair(sock, sessionOpts)));
-
-    return sessionId;
+    // Allocate session, add protoFactory to service(if exist) and add to poller.
+    return AddSocket(sock, protoFactory, sessionOpts);
 }
 
 int LLBC_PollerMgr::AsyncConn(const char *ip,
@@ -259,7 +485,7 @@ int LLBC_PollerMgr::AsyncConn(const char *ip,
         _svc->AddSessionProtocolFactory(sessionId, protoFactory);
 
     if (LIKELY(_pollers))
-        _pollers[sessionId % _pollerCount]->Push(
+        _pollers[PlaceSession(sessionId, sessionOpts)]->Push(
                 LLBC_PollerEvUtil::BuildAsyncConnEv(sessionId, sessionOpts, peer));
     else
         _pendingAsyncConns.insert(std::make_pair(sessionId, std::make_pair(peer, sessionOpts)));
@@ -269,24 +495,111 @@ int LLBC_PollerMgr::AsyncConn(const char *ip,
     return LLBC_OK;
 }
 
+int LLBC_PollerMgr::ListenUdp(const char *ip, uint16 port, LLBC_IProtocolFactory *protoFactory, const LLBC_SessionOpts &sessionOpts)
+{
+    // Datagram session depend on recvmmsg()/sendmmsg(), only supported in EpollPoller.
+    if (_type != LLBC_PollerType::EpollPoller)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+        return 0;
+    }
+
+    LLBC_SockAddr_IN local;
+    if (This::GetAddr(ip, port, local) != LLBC_OK)
+        return 0;
+
+    // Create datagram socket and listen(only mark listen flag).
+    LLBC_Socket *sock = new LLBC_Socket(LLBC_INVALID_SOCKET_HANDLE, true);
+    sock->SetPollerType(_type);
+    if (!*sock ||
+        sock->SetNonBlocking() != LLBC_OK ||
+        sock->EnableAddressReusable() != LLBC_OK ||
+        sock->BindTo(local) != LLBC_OK ||
+        (sessionOpts.GetSockSendBufSize() != 0 && sock->SetSendBufSize(sessionOpts.GetSockSendBufSize()) != LLBC_OK) ||
+        (sessionOpts.GetSockRecvBufSize() != 0 && sock->SetRecvBufSize(sessionOpts.GetSockRecvBufSize()) != LLBC_OK) ||
+        sock->Listen() != LLBC_OK ||
+        sock->UpdateLocalAddress() != LLBC_OK ||
+        sock->SetMaxPacketSize(sessionOpts.GetMaxPacketSize()) != LLBC_OK)
+    {
+        delete sock;
+        return 0;
+    }
+
+    return AddSocket(sock, protoFactory, sessionOpts);
+}
+
+int LLBC_PollerMgr::ConnectUdp(const char *ip, uint16 port, LLBC_IProtocolFactory *protoFactory, const LLBC_SessionOpts &sessionOpts)
+{
+    // Datagram session depend on recvmmsg()/sendmmsg(), only supported in EpollPoller.
+    if (_type != LLBC_PollerType::EpollPoller)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+        return 0;
+    }
+
+    LLBC_SockAddr_IN peer;
+    if (This::GetAddr(ip, port, peer) != LLBC_OK)
+        return 0;
+
+    // Create datagram socket and connect(datagram socket connect never block).
+    LLBC_Socket *sock = new LLBC_Socket(LLBC_INVALID_SOCKET_HANDLE, true);
+    sock->SetPollerType(_type);
+    if (!*sock ||
+        (sessionOpts.GetSockSendBufSize() != 0 && sock->SetSendBufSize(sessionOpts.GetSockSendBufSize()) != LLBC_OK) ||
+        (sessionOpts.GetSockRecvBufSize() != 0 && sock->SetRecvBufSize(sessionOpts.GetSockRecvBufSize()) != LLBC_OK) ||
+        sock->Connect(peer) != LLBC_OK ||
+        sock->SetNonBlocking() != LLBC_OK ||
+        sock->SetMaxPacketSize(sessionOpts.GetMaxPacketSize()) != LLBC_OK)
+    {
+        delete sock;
+        return 0;
+    }
+
+    return AddSocket(sock, protoFactory, sessionOpts);
+}
+
 int LLBC_PollerMgr::Send(LLBC_Packet *packet)
 {
-    _pollers[packet->GetSessionId() % 
-        _pollerCount]->Push(LLBC_PollerEvUtil::BuildSendEv(packet));
-    return LLBC_OK;
+    return PushToSessionPoller(packet->GetSessionId(), LLBC_PollerEvUtil::BuildSendEv(packet));
+}
+
+int LLBC_PollerMgr::SendFile(LLBC_FileRegion *fileRegion)
+{
+    return PushToSessionPoller(fileRegion->header->GetSessionId(), LLBC_PollerEvUtil::BuildSendFileEv(fileRegion));
 }
 
 void LLBC_PollerMgr::Close(int sessionId, const char *reason)
 {
-    _pollers[sessionId % _pollerCount]->Push(LLBC_PollerEvUtil::BuildCloseEv(sessionId, reason));
+    PushToSessionPoller(sessionId, LLBC_PollerEvUtil::BuildCloseEv(sessionId, reason));
 }
 
 void LLBC_PollerMgr::CtrlProtocolStack(int sessionId,
                                        int ctrlCmd,
                                        const LLBC_Variant &ctrlData)
 {
-    _pollers[sessionId % _pollerCount]->Push(
-        LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(sessionId, ctrlCmd, ctrlData));
+    PushToSessionPoller(sessionId,
+                        LLBC_PollerEvUtil::BuildCtrlProtocolStackEv(sessionId, ctrlCmd, ctrlData));
+}
+
+int LLBC_PollerMgr::MigrateSession(int sessionId, int pollerIdx)
+{
+#if LLBC_TARGET_PLATFORM_WIN32
+    // Iocp poller bind socket to completion port, could not migrate.
+    if (_type == LLBC_PollerType::IocpPoller)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+        return LLBC_FAILED;
+    }
+#endif // LLBC_TARGET_PLATFORM_WIN32
+
+    if (pollerIdx < 0 || pollerIdx >= _pollerCount)
+    {
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    return PushToSessionPoller(sessionId,
+                               LLBC_PollerEvUtil::BuildMigrateSessionEv(sessionId, pollerIdx));
 }
 
 int LLBC_PollerMgr::AllocSessionId()
@@ -294,6 +607,204 @@ int LLBC_PollerMgr::AllocSessionId()
     return LLBC_AtomicFetchAndAdd(&_maxSessionId, 1);
 }
 
+int LLBC_PollerMgr::AddSocket(LLBC_Socket *sock, LLBC_IProtocolFactory *protoFactory, const LLBC_SessionOpts &sessionOpts)
+{
+    // Allocate sessionId and add proto factory to service(is exist).
+    const int sessionId = AllocSessionId();
+    if (protoFactory)
+        _svc->AddSessionProtocolFactory(sessionId, protoFactory);
+
+    // Add to poller or pending.
+    if (LIKELY(_pollers))
+        _pollers[PlaceSession(sessionId, sessionOpts)]->Push(
+                LLBC_PollerEvUtil::BuildAddSockEv(sock, sessionId, sessionOpts));
+    else
+        _pendingAddSocks.insert(std::make_pair(sessionId, std::make_pair(sock, sessionOpts)));
+
+    return sessionId;
+}
+
+int LLBC_PollerMgr::PlaceSession(int sessionId, const LLBC_SessionOpts &sessionOpts)
+{
+    LLBC_LockGuard guard(_routeLock);
+
+    // Pinned session always placed to pinned poller.
+    int pollerIdx = sessionOpts.GetPinnedPoller();
+    if (pollerIdx < 0 || pollerIdx >= _pollerCount)
+        pollerIdx = _placePolicy == LLBC_PollerPlacePolicy::Modulo ?
+            sessionId % _pollerCount : GetLeastLoadedPoller(_placePolicy);
+
+    _routes[sessionId] = pollerIdx;
+    ++_routeCounts[pollerIdx];
+
+    return pollerIdx;
+}
+
+int LLBC_PollerMgr::GetPollerIdx(int sessionId)
+{
+    LLBC_LockGuard guard(_routeLock);
+
+    _Routes::const_iterator it = _routes.find(sessionId);
+    return it != _routes.end() ? it->second : sessionId % _pollerCount;
+}
+
+int LLBC_PollerMgr::PushToSessionPoller(int sessionId, LLBC_MessageBlock *block)
+{
+    // The poller maybe removed(stopped but not deleted), drop the event.
+    LLBC_BasePoller *poller = _pollers[GetPollerIdx(sessionId)];
+    if (UNLIKELY(!poller))
+    {
+        LLBC_PollerEvUtil::DestroyEv(block);
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+
+        return LLBC_FAILED;
+    }
+
+    poller->Push(block);
+
+    return LLBC_OK;
+}
+
+int LLBC_PollerMgr::GetDrainTarget(int sessionId)
+{
+    LLBC_LockGuard guard(_routeLock);
+
+    const int policy = _placePolicy;
+    return policy == LLBC_PollerPlacePolicy::Modulo ?
+        sessionId % _pollerCount : GetLeastLoadedPoller(policy);
+}
+
+void LLBC_PollerMgr::SetRoute(int sessionId, int pollerIdx)
+{
+    LLBC_LockGuard guard(_routeLock);
+    if (UNLIKELY(pollerIdx < 0 || pollerIdx >= static_cast<int>(_routeCounts.size())))
+        return;
+
+    // Only update exist route, session maybe removed by new poller before route update.
+    _Routes::iterator it = _routes.find(sessionId);
+    if (it == _routes.end() || it->second == pollerIdx)
+        return;
+
+    --_routeCounts[it->second];
+    ++_routeCounts[pollerIdx];
+    it->second = pollerIdx;
+}
+
+void LLBC_PollerMgr::RemoveRoute(int sessionId)
+{
+    LLBC_LockGuard guard(_routeLock);
+
+    _Routes::iterator it = _routes.find(sessionId);
+    if (it == _routes.end())
+        return;
+
+    --_routeCounts[it->second];
+    _routes.erase(it);
+}
+
+int LLBC_PollerMgr::GetBalanceTarget(int pollerIdx, int &migrateCount)
+{
+    migrateCount = 0;
+
+    const int policy = _placePolicy;
+    if (policy == LLBC_PollerPlacePolicy::Modulo)
+        return -1;
+
+    LLBC_LockGuard guard(_routeLock);
+    if (UNLIKELY(pollerIdx < 0 || pollerIdx >= static_cast<int>(_routeCounts.size())))
+        return -1;
+
+    const int targetIdx = GetLeastLoadedPoller(policy);
+    if (targetIdx == pollerIdx)
+        return -1;
+
+    // Sessions gap must greater than 1, otherwise migrate will cause ping-pong.
+    const int sessionsGap = _routeCounts[pollerIdx] - _routeCounts[targetIdx];
+    if (sessionsGap <= 1)
+        return -1;
+
+    if (policy == LLBC_PollerPlacePolicy::LeastSessions)
+    {
+        migrateCount = MIN(sessionsGap / 2, LLBC_CFG_COMM_POLLER_MAX_MIGRATE_PER_BALANCE);
+    }
+    else
+    {
+        // Only migrate when the poller bytes/s greater than double target poller bytes/s.
+        LLBC_BasePoller *poller = _pollers[pollerIdx];
+        LLBC_BasePoller *target = _pollers[targetIdx];
+        if (!poller || !target || poller->GetBytesPerSec() <= target->GetBytesPerSec() * 2)
+            return -1;
+
+        migrateCount = 1;
+    }
+
+    return targetIdx;
+}
+
+void LLBC_PollerMgr::ApplyPollerThreadCfg(LLBC_BasePoller *poller, int pollerIdx) const
+{
+    if (!_pollerThreadName.empty())
+        poller->SetThreadName(LLBC_String().format("%s%d", _pollerThreadName.c_str(), pollerIdx));
+
+    if (_pollerCPUMask == 0)
+        return;
+    if (!_pollerCPUSpread)
+    {
+        poller->SetCPUAffinity(_pollerCPUMask);
+        return;
+    }
+
+    // Spread mode, pin poller to the (pollerIdx % cpuCount)th cpu of cpu mask.
+    int cpuCount = 0;
+    for (int cpu = 0; cpu < 64; ++cpu)
+        cpuCount += (_pollerCPUMask >> cpu) & 0x01;
+
+    int cpuNth = pollerIdx % cpuCount;
+    for (int cpu = 0; cpu < 64; ++cpu)
+    {
+        if (((_pollerCPUMask >> cpu) & 0x01) && cpuNth-- == 0)
+        {
+            poller->SetCPUAffinity(static_cast<uint64>(1) << cpu);
+            break;
+        }
+    }
+}
+
+int LLBC_PollerMgr::GetLeastLoadedPoller(int policy) const
+{
+    int leastIdx = 0;
+    if (policy == LLBC_PollerPlacePolicy::LeastSessions)
+    {
+        for (int i = 1; i < _pollerCount; ++i)
+        {
+            if (_routeCounts[i] < _routeCounts[leastIdx])
+                leastIdx = i;
+        }
+    }
+    else
+    {
+        sint64 leastBytes = -1;
+        for (int i = 0; i < _pollerCount; ++i)
+        {
+            LLBC_BasePoller *poller = _pollers[i];
+            if (UNLIKELY(!poller))
+                continue;
+
+            // If bytes/s same, prefer the poller which has less sessions.
+            const sint64 bytes = poller->GetBytesPerSec();
+            if (leastBytes < 0 ||
+                bytes < leastBytes ||
+                (bytes == leastBytes && _routeCounts[i] < _routeCounts[leastIdx]))
+            {
+                leastIdx = i;
+                leastBytes = bytes;
+            }
+        }
+    }
+
+    return leastIdx;
+}
+
 int LLBC_PollerMgr::PushMsgToPoller(int id, LLBC_MessageBlock *block)
 {
     LLBC_LockGuard guard(_pollerLock);
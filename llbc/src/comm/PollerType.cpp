@@ -36,8 +36,13 @@ static const LLBC_NS LLBC_String __g_descs[] =
     "SelectPoller",
 #if LLBC_TARGET_PLATFORM_WIN32
     "IocpPoller",
-#elif LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+#else // Non-WIN32
+    "PollPoller",
+ #if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
     "EpollPoller",
+ #elif LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+    "KqueuePoller",
+ #endif
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
     "Invalid"
@@ -0,0 +1,95 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/QueueStats.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_QueueStat::LLBC_QueueStat()
+{
+    Reset();
+}
+
+void LLBC_QueueStat::RecordEnqueue(size_t depth)
+{
+    ++enqueueCount;
+    if (depth > maxDepth)
+        maxDepth = depth;
+}
+
+void LLBC_QueueStat::RecordDequeue(sint64 queueTime)
+{
+    ++dequeueCount;
+    this->queueTime.Record(queueTime);
+}
+
+void LLBC_QueueStat::RecordWakeup(size_t depth)
+{
+    ++wakeupCount;
+    wakeupDepthSum += depth;
+    if (depth > maxDepth)
+        maxDepth = depth;
+}
+
+void LLBC_QueueStat::Reset()
+{
+    beginTime = LLBC_GetMilliSeconds();
+    enqueueCount = 0;
+    dequeueCount = 0;
+    wakeupCount = 0;
+    wakeupDepthSum = 0;
+    maxDepth = 0;
+
+    queueTime.Reset();
+}
+
+double LLBC_QueueStat::GetEnqueueRate() const
+{
+    const sint64 elapsed = LLBC_GetMilliSeconds() - beginTime;
+    return elapsed > 0 ? enqueueCount * 1000.0 / elapsed : 0.0;
+}
+
+double LLBC_QueueStat::GetDequeueRate() const
+{
+    const sint64 elapsed = LLBC_GetMilliSeconds() - beginTime;
+    return elapsed > 0 ? dequeueCount * 1000.0 / elapsed : 0.0;
+}
+
+double LLBC_QueueStat::GetMeanWakeupDepth() const
+{
+    return wakeupCount != 0 ? static_cast<double>(wakeupDepthSum) / wakeupCount : 0.0;
+}
+
+LLBC_String LLBC_QueueStat::ToString() const
+{
+    return LLBC_String().format(
+        "enqueue:%llu(%.1f/s), dequeue:%llu(%.1f/s), wakeup:%llu(mean depth:%.1f), max depth:%lu, queue time:[%s]",
+        enqueueCount, GetEnqueueRate(),
+        dequeueCount, GetDequeueRate(),
+        wakeupCount, GetMeanWakeupDepth(),
+        maxDepth,
+        queueTime.ToString().c_str());
+}
+
+__LLBC_NS_END
@@ -84,6 +84,17 @@ void LLBC_SelectPoller::Svc()
 
         reads = _reads;
         writes = _writes;
+
+        // Read paused, only select listen sockets readable(accept new sessions).
+        if (UNLIKELY(IsReadPaused()))
+        {
+            for (auto &sockItem : _sockets)
+            {
+                if (!sockItem.second->GetSocket()->IsListen())
+                    LLBC_ClrFd(sockItem.first, &reads);
+            }
+        }
+
         excepts = _excepts;
         const int evCount = LLBC_Select(
             static_cast<int>(_maxFd + 1),&reads, &writes, &excepts, interval);
@@ -284,6 +295,18 @@ void LLBC_SelectPoller::RemoveSession(LLBC_Session *session)
     UpdateMaxFd();
 }
 
+void LLBC_SelectPoller::DetachSession(LLBC_Session *session)
+{
+    const _Handle handle = session->GetSocketHandle();
+    LLBC_ClrFd(handle, &_reads);
+    LLBC_ClrFd(handle, &_writes);
+    LLBC_ClrFd(handle, &_excepts);
+
+    Base::DetachSession(session);
+
+    UpdateMaxFd();
+}
+
 void LLBC_SelectPoller::UpdateMaxFd()
 {
     _maxFd = 0;
@@ -298,6 +321,13 @@ void LLBC_SelectPoller::Accept(LLBC_Session *session)
     LLBC_Socket *newSocket = session->GetSocket()->Accept();
     if (LIKELY(newSocket))
     {
+        // Service overloaded, close new accepted socket immediately.
+        if (UNLIKELY(IsAcceptRejected()))
+        {
+            delete newSocket;
+            return;
+        }
+
         newSocket->SetNonBlocking();
 
         SetConnectedSocketOpts(newSocket, session->GetSessionOpts());
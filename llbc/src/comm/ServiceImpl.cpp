@@ -30,10 +30,12 @@
 
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/PollerType.h"
+#include "llbc/comm/FileRegion.h"
 #include "llbc/comm/protocol/IProtocol.h"
 #include "llbc/comm/protocol/ProtocolStack.h"
 #include "llbc/comm/protocol/RawProtocolFactory.h"
 #include "llbc/comm/protocol/NormalProtocolFactory.h"
+#include "llbc/comm/protocol/DatagramProtocolFactory.h"
 #include "llbc/comm/Component.h"
 #include "llbc/comm/ServiceImpl.h"
 #include "llbc/comm/ServiceMgr.h"
@@ -82,6 +84,7 @@ LLBC_ServiceImpl::LLBC_ServiceImpl(const LLBC_String &name,
 , _cfgType(LLBC_AppConfigType::End)
 
 , _fullStack(fullStack)
+, _decodeOffload(false)
 , _dftProtocolFactory(dftProtocolFactory)
 , _sessionProtoFactory()
 , _driveMode(SelfDrive)
@@ -102,8 +105,61 @@ LLBC_ServiceImpl::LLBC_ServiceImpl(const LLBC_String &name,
 , _afterStop(false)
 
 , _pollerMgr()
+, _pollerModelSet(false)
+
+, _svcThreadName()
+, _svcCPUMask(0)
+, _pollerThreadName()
+, _pollerCPUMask(0)
+, _pollerCPUSpread(false)
+
 , _readySessionInfos()
+, _retiredReadySessionInfos()
 , _readySessionInfosLock()
+, _localSessionCount(0)
+
+, _priorityLanesEnabled(false)
+, _opcodePriorities()
+, _sessionPriorities()
+, _priorityLock()
+, _priorityBudgets()
+, _priorityLanes()
+, _priorityLaneSizes()
+
+, _overloadPolicy(LLBC_OverloadPolicy::None)
+, _overloadHighWatermark(0)
+, _overloadLowWatermark(0)
+, _overloadMaxDelay(0)
+, _overloaded(false)
+, _overloadBeginTime(0)
+, _shedPacketCount(0)
+, _overloadBeginShedCount(0)
+, _overloadChanged(false)
+, _pendingOverloadInfos()
+, _overloadLock()
+
+, _packetCapturing(false)
+, _captureWriter(nullptr)
+, _captureLock()
+
+, _packetReplaying(false)
+, _replayReader(nullptr)
+, _replaySpeed(1.0)
+, _replaySessionId(0)
+, _replayBeginTime()
+, _replayRecord()
+, _replayRecordPending(false)
+, _replayLock()
+
+, _maxRpcCallId(0)
+, _rpcCalls()
+
+, _maxCoroId(0)
+, _curCoroId(0)
+, _corosStopping(false)
+, _coroStackPool()
+, _coros()
+, _readyCoros()
 
 , _willRegComps()
 
@@ -115,6 +171,7 @@ LLBC_ServiceImpl::LLBC_ServiceImpl(const LLBC_String &name,
 , _caredEventComps{}
 , _coders()
 , _handlers()
+, _coroHandlers()
 , _preHandlers()
 #if LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
 , _unifyPreHandler()
@@ -141,6 +198,22 @@ LLBC_ServiceImpl::LLBC_ServiceImpl(const LLBC_String &name,
 , _evManagerMaxListenerStub(0)
 
 , _svcMgr(*LLBC_ServiceMgrSingleton)
+
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+, _opcodeStatsEnabled(false)
+, _opcodeStatsDumpInterval(0)
+, _resetOpcodeStatsAfterDump(false)
+, _lastOpcodeStatsDumpTime(0)
+
+, _frameProfileEnabled(false)
+, _profilingFrame(false)
+, _slowFrameBudget(0)
+
+, _queueStatsEnabled(false)
+, _queueStatsDumpInterval(0)
+, _resetQueueStatsAfterDump(false)
+, _lastQueueStatsDumpTime(0)
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
 {
     // Create service name, if is empty.
     if (_name.empty())
@@ -174,6 +247,7 @@ LLBC_ServiceImpl::~LLBC_ServiceImpl()
 
     LLBC_STLHelper::DeleteContainer(_coders);
     _handlers.clear();
+    _coroHandlers.clear();
     _preHandlers.clear();
     #if LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
     _unifyPreHandler = nullptr;
@@ -185,6 +259,9 @@ LLBC_ServiceImpl::~LLBC_ServiceImpl()
 
     RemoveAllReadySessions();
 
+    StopPacketCapture();
+    StopPacketReplay();
+
     DestroyFrameTasks();
 
     LLBC_STLHelper::DeleteContainer(_sessionProtoFactory);
@@ -196,6 +273,24 @@ bool LLBC_ServiceImpl::IsFullStack() const
     return _fullStack;
 }
 
+bool LLBC_ServiceImpl::IsDecodeOffload() const
+{
+    return _decodeOffload;
+}
+
+int LLBC_ServiceImpl::SetDecodeOffload(bool decodeOffload)
+{
+    // Full-stack service always decode packets in poller threads.
+    LLBC_SetErrAndReturnIf(_fullStack, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
+
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_started, LLBC_ERROR_INITED, LLBC_FAILED);
+
+    _decodeOffload = decodeOffload;
+
+    return LLBC_OK;
+}
+
 auto LLBC_ServiceImpl::GetDriveMode() const -> DriveMode
 {
     return _driveMode;
@@ -279,6 +374,24 @@ int LLBC_ServiceImpl::Start(int pollerCount)
         return LLBC_FAILED;
     }
 
+    // Update service config.
+    UpdateServiceCfg();
+
+    // Apply service/poller threads name, cpu affinity and poller busy poll window.
+    ApplyThreadCfg();
+
+    // Apply poller model config(if api not set).
+    LLBC_String pollerModel;
+    if (!_pollerModelSet &&
+        !(pollerModel = GetServiceCfgValue("pollerModel")).empty())
+    {
+        const int pollerType = LLBC_PollerType::Str2Type(pollerModel);
+        if (LLBC_PollerType::IsValid(pollerType))
+            _pollerMgr.SetPollerType(pollerType);
+        else
+            LLOG_WARN("Service[%s] pollerModel config[%s] invalid, ignored", GetName().c_str(), pollerModel.c_str());
+    }
+
     // Start pollermgr.
     if (_pollerMgr.Start(pollerCount) != LLBC_OK)
     {
@@ -286,9 +399,6 @@ int LLBC_ServiceImpl::Start(int pollerCount)
         return LLBC_FAILED;
     }
 
-    // Update service config.
-    UpdateServiceCfg();
-
     // Add to service tls or activate.
     if (_driveMode == ExternalDrive)
     {
@@ -512,6 +622,73 @@ int LLBC_ServiceImpl::AsyncConn(const char *ip,
     return pendingSessionId;
 }
 
+int LLBC_ServiceImpl::ConnectLocal(LLBC_Service *otherSvc)
+{
+    if (UNLIKELY(!otherSvc || otherSvc == this))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return 0;
+    }
+
+    LLBC_LockGuard guard(_lock);
+    if (UNLIKELY(!_started || !otherSvc->IsStarted()))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return 0;
+    }
+
+    // Allocate session Ids from both services, the Ids never route to pollers.
+    This *peerSvc = static_cast<This *>(otherSvc);
+    const int sessionId = _pollerMgr.AllocSessionId();
+    const int peerSessionId = peerSvc->_pollerMgr.AllocSessionId();
+
+    // Add ready sessions to both services first, makesure both sides can send packet immediately.
+    AddLocalReadySession(sessionId, peerSvc, peerSessionId);
+    peerSvc->AddLocalReadySession(peerSessionId, this, sessionId);
+
+    // Fire session-create events.
+    PushLocalSessionCreateEv(sessionId);
+    peerSvc->PushLocalSessionCreateEv(peerSessionId);
+
+    return sessionId;
+}
+
+int LLBC_ServiceImpl::ListenUdp(const char *ip,
+                                uint16 port,
+                                LLBC_IProtocolFactory *protoFactory,
+                                const LLBC_SessionOpts &sessionOpts)
+{
+    if (!protoFactory)
+        protoFactory = new LLBC_DatagramProtocolFactory;
+
+    LLBC_LockGuard guard(_lock);
+    const int sessionId = _pollerMgr.ListenUdp(ip, port, protoFactory, sessionOpts);
+    if (sessionId != 0)
+        AddReadySession(sessionId, 0, true);
+    else
+        LLBC_XDelete(protoFactory);
+
+    return sessionId;
+}
+
+int LLBC_ServiceImpl::ConnectUdp(const char *ip,
+                                 uint16 port,
+                                 LLBC_IProtocolFactory *protoFactory,
+                                 const LLBC_SessionOpts &sessionOpts)
+{
+    if (!protoFactory)
+        protoFactory = new LLBC_DatagramProtocolFactory;
+
+    LLBC_LockGuard guard(_lock);
+    const int sessionId = _pollerMgr.ConnectUdp(ip, port, protoFactory, sessionOpts);
+    if (sessionId != 0)
+        AddReadySession(sessionId, 0, false);
+    else
+        LLBC_XDelete(protoFactory);
+
+    return sessionId;
+}
+
 bool LLBC_ServiceImpl::IsSessionValidate(int sessionId)
 {
     if (UNLIKELY(sessionId == 0))
@@ -532,6 +709,73 @@ int LLBC_ServiceImpl::Send(LLBC_Packet *packet)
     return LockableSend(packet);
 }
 
+int LLBC_ServiceImpl::SendFile(int sessionId, int opcode, int fd, sint64 offset, size_t length, int status)
+{
+    #if LLBC_TARGET_PLATFORM_WIN32
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+    #else // Non-Win32
+    if (UNLIKELY(fd < 0 || offset < 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_LockGuard guard(_lock);
+    if (UNLIKELY(!_started))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    // Session check(not allow send file to listen session or local session).
+    _readySessionInfosLock.Lock();
+    auto readySInfoIt = _readySessionInfos.find(sessionId);
+    if (readySInfoIt == _readySessionInfos.end())
+    {
+        _readySessionInfosLock.Unlock();
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+        return LLBC_FAILED;
+    }
+
+    const _ReadySessionInfo *readySInfo = readySInfoIt->second;
+    if (UNLIKELY(readySInfo->isListenSession))
+    {
+        _readySessionInfosLock.Unlock();
+        LLBC_SetLastError(LLBC_ERROR_IS_LISTEN_SOCKET);
+        return LLBC_FAILED;
+    }
+    else if (UNLIKELY(readySInfo->localPeerSvc))
+    {
+        _readySessionInfosLock.Unlock();
+        LLBC_SetLastError(LLBC_ERROR_NOT_SUPPORT);
+        return LLBC_FAILED;
+    }
+    _readySessionInfosLock.Unlock();
+
+    // Dup fd, file region will own the dupped fd.
+    const int dupFd = dup(fd);
+    if (UNLIKELY(dupFd < 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    // Build header packet & file region, then push to poller.
+    LLBC_Packet *header = _packetObjectPool.GetObject();
+    header->SetHeader(0, sessionId, opcode, status);
+    header->SetSenderServiceId(_id);
+
+    LLBC_FileRegion *fileRegion = new LLBC_FileRegion;
+    fileRegion->header = header;
+    fileRegion->fd = dupFd;
+    fileRegion->offset = offset;
+    fileRegion->length = length;
+
+    return _pollerMgr.SendFile(fileRegion);
+    #endif // LLBC_TARGET_PLATFORM_WIN32
+}
+
 int LLBC_ServiceImpl::Broadcast(int svcId, int opcode, LLBC_Coder *coder, int status)
 {
     // Copy all connected session Ids.
@@ -558,10 +802,9 @@ int LLBC_ServiceImpl::Broadcast(int svcId, int opcode, const void *bytes, size_t
 {
     LLBC_LockGuard guard(_lock);
 
-    // Foreach to call internal method LockableSend() method to complete.
-    // lock = false
-    // validCheck = false
-    LLBC_LockGuard readySInfosGuard(_readySessionInfosLock);
+    // Copy all connected session Ids(LockableSend() may lock _readySessionInfosLock again).
+    _readySessionInfosLock.Lock();
+    LLBC_SessionIdList connSIds;
     for (auto readySInfoIt = _readySessionInfos.begin();
          readySInfoIt != _readySessionInfos.end();
          ++readySInfoIt)
@@ -570,8 +813,15 @@ int LLBC_ServiceImpl::Broadcast(int svcId, int opcode, const void *bytes, size_t
         if (readySInfo->isListenSession)
             continue;
 
-        LockableSend(svcId, readySInfo->sessionId, opcode, bytes, len, status, false, false);
+        connSIds.push_back(readySInfo->sessionId);
     }
+    _readySessionInfosLock.Unlock();
+
+    // Foreach to call internal method LockableSend() method to complete.
+    // lock = false
+    // validCheck = false
+    for (auto &sessionId : connSIds)
+        LockableSend(svcId, sessionId, opcode, bytes, len, status, false, false);
 
     return LLBC_OK;
 }
@@ -585,18 +835,38 @@ int LLBC_ServiceImpl::RemoveSession(int sessionId, const char *reason)
         return LLBC_FAILED;
     }
 
-    LLBC_LockGuard readySInfosGuard(_readySessionInfosLock);
+    _readySessionInfosLock.Lock();
     auto readySInfoIt = _readySessionInfos.find(sessionId);
     if (readySInfoIt == _readySessionInfos.end())
     {
+        _readySessionInfosLock.Unlock();
         LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+
         return LLBC_FAILED;
     }
 
-    _pollerMgr.Close(sessionId, reason);
-
-    delete readySInfoIt->second;
+    _ReadySessionInfo *readySInfo = readySInfoIt->second;
     _readySessionInfos.erase(readySInfoIt);
+    if (readySInfo->localPeerSvc)
+        --_localSessionCount;
+    _retiredReadySessionInfos.push_back(readySInfo);
+    _readySessionInfosLock.Unlock();
+
+    if (readySInfo->localPeerSvc)
+    {
+        // Local session: remove peer side session, if peer side already removed(closing at the same time),
+        // peer service will fire session-destroy event by itself.
+        This *peerSvc = readySInfo->localPeerSvc;
+        if (peerSvc->RemoveReadySession(readySInfo->localPeerSessionId))
+            peerSvc->PushLocalSessionDestroyEv(readySInfo->localPeerSessionId,
+                                               new LLBC_SessionCloseInfo(LLBC_ERROR_END, LLBC_ERROR_SUCCESS));
+
+        PushLocalSessionDestroyEv(sessionId, new LLBC_SessionCloseInfo(const_cast<char *>(reason ? reason : "")));
+    }
+    else
+    {
+        _pollerMgr.Close(sessionId, reason);
+    }
 
     return LLBC_OK;
 }
@@ -622,10 +892,10 @@ int LLBC_ServiceImpl::CtrlProtocolStack(int sessionId,
         return LLBC_FAILED;
     }
 
+    const _ReadySessionInfo * const &readySInfo = readySInfoIt->second;
     if (!_fullStack)
     {
         bool removeSession = false;
-        const _ReadySessionInfo * const &readySInfo = readySInfoIt->second;
         if (!readySInfo->codecStack->CtrlStackCodec(ctrlCmd, ctrlData, removeSession))
         {
             _readySessionInfosLock.Unlock();
@@ -638,13 +908,618 @@ int LLBC_ServiceImpl::CtrlProtocolStack(int sessionId,
         }
     }
 
+    // Local session has no pack stack in poller.
+    const bool isLocalSession = readySInfo->localPeerSvc != nullptr;
     _readySessionInfosLock.Unlock();
 
-    _pollerMgr.CtrlProtocolStack(sessionId, ctrlCmd, ctrlData);
+    if (!isLocalSession)
+        _pollerMgr.CtrlProtocolStack(sessionId, ctrlCmd, ctrlData);
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::SetPollerPlacePolicy(int policy)
+{
+    return _pollerMgr.SetPlacePolicy(policy);
+}
+
+int LLBC_ServiceImpl::MigrateSession(int sessionId, int pollerIdx)
+{
+    LLBC_LockGuard guard(_lock);
+    if (!_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    _readySessionInfosLock.Lock();
+    auto readySInfoIt = _readySessionInfos.find(sessionId);
+    if (readySInfoIt == _readySessionInfos.end())
+    {
+        _readySessionInfosLock.Unlock();
+        LLBC_SetLastError(LLBC_ERROR_NOT_FOUND);
+
+        return LLBC_FAILED;
+    }
+
+    // Local session not placed in any poller.
+    const bool isLocalSession = readySInfoIt->second->localPeerSvc != nullptr;
+    _readySessionInfosLock.Unlock();
+    if (isLocalSession)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return LLBC_FAILED;
+    }
+
+    return _pollerMgr.MigrateSession(sessionId, pollerIdx);
+}
+
+int LLBC_ServiceImpl::GetPollerCount() const
+{
+    return _pollerMgr.GetPollerCount();
+}
+
+int LLBC_ServiceImpl::SetPollerCount(int pollerCount)
+{
+    LLBC_LockGuard guard(_lock);
+    if (!_started)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return LLBC_FAILED;
+    }
+
+    return _pollerMgr.SetPollerCount(pollerCount);
+}
+
+const LLBC_String &LLBC_ServiceImpl::GetPollerModel() const
+{
+    return LLBC_PollerType::Type2Str(_pollerMgr.GetPollerType());
+}
+
+int LLBC_ServiceImpl::SetPollerModel(const LLBC_String &pollerModel)
+{
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_started, LLBC_ERROR_INITED, LLBC_FAILED);
+
+    const int pollerType = LLBC_PollerType::Str2Type(pollerModel);
+    LLBC_SetErrAndReturnIf(!LLBC_PollerType::IsValid(pollerType), LLBC_ERROR_ARG, LLBC_FAILED);
+
+    _pollerMgr.SetPollerType(pollerType);
+    _pollerModelSet = true;
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::SetThreadName(const LLBC_String &threadName)
+{
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_started, LLBC_ERROR_INITED, LLBC_FAILED);
+
+    _svcThreadName = threadName;
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::SetCPUAffinity(uint64 cpuMask)
+{
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_started, LLBC_ERROR_INITED, LLBC_FAILED);
+
+    _svcCPUMask = cpuMask;
 
     return LLBC_OK;
 }
 
+int LLBC_ServiceImpl::SetPollerThreadName(const LLBC_String &namePrefix)
+{
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_started, LLBC_ERROR_INITED, LLBC_FAILED);
+
+    _pollerThreadName = namePrefix;
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::SetPollerCPUAffinity(uint64 cpuMask, bool spread)
+{
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_started, LLBC_ERROR_INITED, LLBC_FAILED);
+
+    _pollerCPUMask = cpuMask;
+    _pollerCPUSpread = spread;
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::SetOpcodePriority(int opcode, int priority)
+{
+    LLBC_SetErrAndReturnIf(!LLBC_PacketPriority::IsValid(priority) && priority != LLBC_PacketPriority::End,
+                           LLBC_ERROR_ARG,
+                           LLBC_FAILED);
+
+    LLBC_LockGuard guard(_priorityLock);
+    if (priority == LLBC_PacketPriority::End)
+        _opcodePriorities.erase(opcode);
+    else
+        _opcodePriorities[opcode] = priority;
+
+    _priorityLanesEnabled = true;
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::SetSessionPriority(int sessionId, int priority)
+{
+    LLBC_SetErrAndReturnIf(sessionId == 0 ||
+                               (!LLBC_PacketPriority::IsValid(priority) && priority != LLBC_PacketPriority::End),
+                           LLBC_ERROR_ARG,
+                           LLBC_FAILED);
+
+    LLBC_LockGuard guard(_priorityLock);
+    if (priority == LLBC_PacketPriority::End)
+        _sessionPriorities.erase(sessionId);
+    else
+        _sessionPriorities[sessionId] = priority;
+
+    _priorityLanesEnabled = true;
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::SetPriorityBudget(int priority, int budget)
+{
+    LLBC_SetErrAndReturnIf(!LLBC_PacketPriority::IsValid(priority) || budget < 0, LLBC_ERROR_ARG, LLBC_FAILED);
+
+    _priorityBudgets[priority] = budget;
+    _priorityLanesEnabled = true;
+
+    return LLBC_OK;
+}
+
+size_t LLBC_ServiceImpl::GetPendingPacketCount(int priority) const
+{
+    return LLBC_PacketPriority::IsValid(priority) ? _priorityLaneSizes[priority] : 0;
+}
+
+int LLBC_ServiceImpl::SetOverloadProtection(int policy, size_t highWatermark, size_t lowWatermark, int maxDelay)
+{
+    LLBC_SetErrAndReturnIf(!LLBC_OverloadPolicy::IsValid(policy) ||
+                               maxDelay < 0 ||
+                               (highWatermark > 0 && lowWatermark >= highWatermark) ||
+                               (policy != LLBC_OverloadPolicy::None && highWatermark == 0 && maxDelay == 0),
+                           LLBC_ERROR_ARG,
+                           LLBC_FAILED);
+
+    LLBC_LockGuard guard(_overloadLock);
+    _overloadPolicy = policy;
+    _overloadHighWatermark = policy != LLBC_OverloadPolicy::None ? highWatermark : 0;
+    _overloadLowWatermark = lowWatermark;
+    _overloadMaxDelay = policy != LLBC_OverloadPolicy::None ? maxDelay : 0;
+
+    // Protection disabled or policy changed while overloaded.
+    if (_overloaded)
+    {
+        if (policy == LLBC_OverloadPolicy::None)
+            LeaveOverload(0, 0);
+        else
+            _pollerMgr.SetOverloadFlags(policy & (LLBC_OverloadPolicy::PauseRead | LLBC_OverloadPolicy::RejectAccept));
+    }
+
+    return LLBC_OK;
+}
+
+bool LLBC_ServiceImpl::IsOverloaded() const
+{
+    return _overloaded;
+}
+
+uint64 LLBC_ServiceImpl::GetShedPacketCount() const
+{
+    LLBC_LockGuard guard(_overloadLock);
+    return _shedPacketCount;
+}
+
+int LLBC_ServiceImpl::StartPacketCapture(const LLBC_String &filePath)
+{
+    LLBC_LockGuard guard(_captureLock);
+    if (UNLIKELY(_captureWriter))
+    {
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+        return LLBC_FAILED;
+    }
+
+    LLBC_PacketCaptureWriter *writer = new LLBC_PacketCaptureWriter;
+    if (writer->Open(filePath) != LLBC_OK)
+    {
+        delete writer;
+        return LLBC_FAILED;
+    }
+
+    _captureWriter = writer;
+    _packetCapturing = true;
+
+    return LLBC_OK;
+}
+
+void LLBC_ServiceImpl::StopPacketCapture()
+{
+    LLBC_LockGuard guard(_captureLock);
+
+    _packetCapturing = false;
+    LLBC_XDelete(_captureWriter);
+}
+
+bool LLBC_ServiceImpl::IsPacketCapturing() const
+{
+    return _packetCapturing;
+}
+
+int LLBC_ServiceImpl::ReplayPacketCapture(const LLBC_String &filePath, double speed, int sessionId)
+{
+    if (UNLIKELY(sessionId < 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // Load capture file outside replay lock.
+    LLBC_PacketCaptureReader *reader = new LLBC_PacketCaptureReader;
+    if (reader->Open(filePath) != LLBC_OK)
+    {
+        delete reader;
+        return LLBC_FAILED;
+    }
+
+    LLBC_LockGuard guard(_replayLock);
+    if (UNLIKELY(_replayReader))
+    {
+        delete reader;
+        LLBC_SetLastError(LLBC_ERROR_REENTRY);
+
+        return LLBC_FAILED;
+    }
+
+    _replayReader = reader;
+    _replaySpeed = speed;
+    _replaySessionId = sessionId;
+    _replayBeginTime = LLBC_CPUTime::Current();
+    _replayRecordPending = false;
+    _packetReplaying = true;
+
+    return LLBC_OK;
+}
+
+void LLBC_ServiceImpl::StopPacketReplay()
+{
+    LLBC_LockGuard guard(_replayLock);
+
+    _packetReplaying = false;
+    _replayRecordPending = false;
+    LLBC_XDelete(_replayReader);
+}
+
+bool LLBC_ServiceImpl::IsPacketReplaying() const
+{
+    return _packetReplaying;
+}
+
+sint64 LLBC_ServiceImpl::Call(LLBC_Packet *packet,
+                              const LLBC_Delegate<void(const LLBC_RpcResult &)> &callback,
+                              int timeout)
+{
+    // Call must be in service thread, timer scheduler available only after service started.
+    if (UNLIKELY(!_started || !_timerScheduler))
+    {
+        LLBC_Recycle(packet);
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+
+        return 0;
+    }
+
+    if (UNLIKELY(!callback))
+    {
+        LLBC_Recycle(packet);
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+
+        return 0;
+    }
+
+    // Mark packet as rpc request, carry call Id.
+    const sint64 callId = ++_maxRpcCallId;
+    const int sessionId = packet->GetSessionId();
+    const int opcode = packet->GetOpcode();
+    packet->SetFlags((packet->GetFlags() & ~LLBC_RpcFlags::All) | LLBC_RpcFlags::Request);
+    packet->SetExtData1(callId);
+    if (LockableSend(packet) != LLBC_OK)
+        return 0;
+
+    // Record call & schedule timeout timer(response always handled in service thread, no race here).
+    _RpcCall &call = _rpcCalls[callId];
+    call.sessionId = sessionId;
+    call.opcode = opcode;
+    call.beginTime = LLBC_GetMicroSeconds();
+    call.callback = callback;
+    call.timer = new LLBC_Timer(LLBC_Delegate<void(LLBC_Timer *)>(this, &LLBC_ServiceImpl::OnRpcCallTimeout),
+                                nullptr,
+                                _timerScheduler);
+    call.timer->GetTimerData() = callId;
+    call.timer->Schedule(LLBC_TimeSpan::FromMillis(timeout > 0 ? timeout : LLBC_CFG_COMM_DFT_RPC_TIMEOUT));
+
+    return callId;
+}
+
+int LLBC_ServiceImpl::CancelCall(sint64 callId)
+{
+    auto callIt = _rpcCalls.find(callId);
+    LLBC_SetErrAndReturnIf(callIt == _rpcCalls.end(), LLBC_ERROR_NOT_FOUND, LLBC_FAILED);
+
+    delete callIt->second.timer;
+    _rpcCalls.erase(callIt);
+
+    return LLBC_OK;
+}
+
+size_t LLBC_ServiceImpl::GetPendingCallCount() const
+{
+    return _rpcCalls.size();
+}
+
+sint64 LLBC_ServiceImpl::Go(const LLBC_Delegate<void()> &entry)
+{
+    // Coroutine must be created in service thread, not allow create coroutine when stopping coroutines.
+    if (UNLIKELY(!_started || !_timerScheduler))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+        return 0;
+    }
+    else if (UNLIKELY(_corosStopping))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return 0;
+    }
+    else if (UNLIKELY(!entry))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return 0;
+    }
+
+    const sint64 coroId = ++_maxCoroId;
+    LLBC_Coro *coro = new LLBC_Coro(entry, _coroStackPool);
+    _coros.insert(std::make_pair(coroId, coro));
+    if (RunCoro(coroId, coro) != LLBC_OK)
+    {
+        _coros.erase(coroId);
+        delete coro;
+
+        return 0;
+    }
+
+    return coroId;
+}
+
+sint64 LLBC_ServiceImpl::GetCurrentCoroId() const
+{
+    return _curCoroId;
+}
+
+size_t LLBC_ServiceImpl::GetCoroCount() const
+{
+    return _coros.size();
+}
+
+int LLBC_ServiceImpl::YieldCoro()
+{
+    LLBC_SetErrAndReturnIf(_curCoroId == 0, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
+    LLBC_SetErrAndReturnIf(_corosStopping, LLBC_ERROR_CANCELLED, LLBC_FAILED);
+
+    // Yield back to resumer, RunCoro() will restore current coroutine Id.
+    if (_coros[_curCoroId]->Yield() != LLBC_OK)
+        return LLBC_FAILED;
+
+    LLBC_SetErrAndReturnIf(_corosStopping, LLBC_ERROR_CANCELLED, LLBC_FAILED);
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::ResumeCoro(sint64 coroId)
+{
+    auto coroIt = _coros.find(coroId);
+    LLBC_SetErrAndReturnIf(coroIt == _coros.end(), LLBC_ERROR_NOT_FOUND, LLBC_FAILED);
+    LLBC_SetErrAndReturnIf(coroIt->second->GetState() != LLBC_Coro::State::Suspended, LLBC_ERROR_INVALID, LLBC_FAILED);
+
+    // Resume in coroutine, delay to next loop to avoid nested coroutine stacks.
+    if (_curCoroId != 0)
+    {
+        _readyCoros.push_back(coroId);
+        return LLBC_OK;
+    }
+
+    return RunCoro(coroId, coroIt->second);
+}
+
+int LLBC_ServiceImpl::CoroSleep(int milliseconds)
+{
+    const sint64 coroId = _curCoroId;
+    LLBC_SetErrAndReturnIf(coroId == 0, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
+
+    if (milliseconds <= 0)
+    {
+        _readyCoros.push_back(coroId);
+        return YieldCoro();
+    }
+
+    // Timer allow delete in it's timeout handler, so timer could be placed at coroutine stack.
+    LLBC_Timer timer([this, coroId](LLBC_Timer *) { ResumeCoro(coroId); }, nullptr, _timerScheduler);
+    timer.Schedule(LLBC_TimeSpan::FromMillis(milliseconds));
+
+    return YieldCoro();
+}
+
+int LLBC_ServiceImpl::Push(LLBC_MessageBlock *block)
+{
+    // Service overloaded, shed low priority packets before enqueue.
+    if (UNLIKELY(_overloaded) &&
+        (_overloadPolicy & LLBC_OverloadPolicy::ShedLowPriority) &&
+        ShedOverloadPacket(block))
+        return LLBC_OK;
+
+    // Stamp enqueue time, use to statistic queue time or check overload queueing delay.
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_queueStatsEnabled || _overloadMaxDelay > 0))
+    #else // !LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_overloadMaxDelay > 0))
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+        reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos())->enqueueTime = LLBC_GetMicroSeconds();
+
+    LLBC_Task::Push(block);
+
+    // Check queue depth when enqueue, the service frame maybe stalled and can't check overload in time.
+    if (UNLIKELY(_overloadHighWatermark > 0) && !_overloaded)
+    {
+        const size_t queueDepth = GetMessageSize();
+        if (queueDepth >= _overloadHighWatermark)
+        {
+            LLBC_LockGuard guard(_overloadLock);
+            if (!_overloaded && _overloadHighWatermark > 0)
+                EnterOverload(queueDepth, 0);
+        }
+    }
+
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_queueStatsEnabled))
+    {
+        LLBC_LockGuard guard(_queueStatLock);
+        _queueStat.RecordEnqueue(GetMessageSize());
+    }
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+    return LLBC_OK;
+}
+
+int LLBC_ServiceImpl::GetPollerBusyPoll() const
+{
+    return _pollerMgr.GetBusyPollWindow();
+}
+
+int LLBC_ServiceImpl::SetPollerBusyPoll(int busyPollWindow)
+{
+    LLBC_SetErrAndReturnIf(busyPollWindow < 0, LLBC_ERROR_ARG, LLBC_FAILED);
+
+    _pollerMgr.SetBusyPollWindow(busyPollWindow);
+
+    return LLBC_OK;
+}
+
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+void LLBC_ServiceImpl::SetOpcodeStatsEnabled(bool enabled)
+{
+    _opcodeStatsEnabled = enabled;
+}
+
+bool LLBC_ServiceImpl::IsOpcodeStatsEnabled() const
+{
+    return _opcodeStatsEnabled;
+}
+
+void LLBC_ServiceImpl::GetOpcodeStats(std::map<int, LLBC_OpcodeStat> &stats) const
+{
+    LLBC_LockGuard guard(_opcodeStatsLock);
+    stats = _opcodeStats;
+}
+
+void LLBC_ServiceImpl::ResetOpcodeStats()
+{
+    LLBC_LockGuard guard(_opcodeStatsLock);
+    _opcodeStats.clear();
+}
+
+int LLBC_ServiceImpl::SetOpcodeStatsDump(int interval, const char *loggerName, bool resetAfterDump)
+{
+    if (UNLIKELY(interval < 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_LockGuard guard(_opcodeStatsLock);
+    _opcodeStatsDumpInterval = interval;
+    _opcodeStatsDumpLogger = loggerName ? loggerName : "";
+    _resetOpcodeStatsAfterDump = resetAfterDump;
+    _lastOpcodeStatsDumpTime = LLBC_GetMilliSeconds();
+
+    return LLBC_OK;
+}
+
+void LLBC_ServiceImpl::SetFrameProfileEnabled(bool enabled)
+{
+    _frameProfileEnabled = enabled;
+}
+
+bool LLBC_ServiceImpl::IsFrameProfileEnabled() const
+{
+    return _frameProfileEnabled;
+}
+
+void LLBC_ServiceImpl::GetFrameProfile(LLBC_FrameProfile &profile, bool current) const
+{
+    LLBC_LockGuard guard(_frameProfileLock);
+    profile = current ? _frameProfile : _lastFrameProfile;
+}
+
+void LLBC_ServiceImpl::SetSlowFrameHandler(const LLBC_Delegate<void(const LLBC_SlowFrameInfo &)> &handler, int budget)
+{
+    LLBC_LockGuard guard(_frameProfileLock);
+    _slowFrameHandler = handler;
+    _slowFrameBudget = MAX(0, budget);
+}
+
+void LLBC_ServiceImpl::SetQueueStatsEnabled(bool enabled)
+{
+    _queueStatsEnabled = enabled;
+    _pollerMgr.SetQueueStatsEnabled(enabled);
+}
+
+bool LLBC_ServiceImpl::IsQueueStatsEnabled() const
+{
+    return _queueStatsEnabled;
+}
+
+void LLBC_ServiceImpl::GetQueueStats(LLBC_QueueStat &svcStat, std::vector<LLBC_QueueStat> &pollerStats) const
+{
+    _queueStatLock.Lock();
+    svcStat = _queueStat;
+    _queueStatLock.Unlock();
+
+    _pollerMgr.GetQueueStats(pollerStats);
+}
+
+void LLBC_ServiceImpl::ResetQueueStats()
+{
+    _queueStatLock.Lock();
+    _queueStat.Reset();
+    _queueStatLock.Unlock();
+
+    _pollerMgr.ResetQueueStats();
+}
+
+int LLBC_ServiceImpl::SetQueueStatsDump(int interval, const char *loggerName, bool resetAfterDump)
+{
+    if (UNLIKELY(interval < 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    LLBC_LockGuard guard(_queueStatLock);
+    _queueStatsDumpInterval = interval;
+    _queueStatsDumpLogger = loggerName ? loggerName : "";
+    _resetQueueStatsAfterDump = resetAfterDump;
+    _lastQueueStatsDumpTime = LLBC_GetMilliSeconds();
+
+    return LLBC_OK;
+}
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 int LLBC_ServiceImpl::AddComponent(LLBC_Component *comp)
 {
     if (UNLIKELY(!comp))
@@ -850,9 +1725,33 @@ int LLBC_ServiceImpl::AddStatusDesc(int status, const LLBC_String &desc)
 
     return LLBC_OK;
 }
-#endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
+#endif // LLBC_CFG_COMM_ENABLE_STATUS_DESC
+
+int LLBC_ServiceImpl::Subscribe(int opcode, const LLBC_Delegate<void(LLBC_Packet &)> &deleg)
+{
+    if (UNLIKELY(!deleg))
+    {
+        LLBC_SetLastError(LLBC_ERROR_INVALID);
+        return LLBC_FAILED;
+    }
+
+    LLBC_LockGuard guard(_lock);
+    if (UNLIKELY(_started && !_initingComp))
+    {
+        LLBC_SetLastError(LLBC_ERROR_INITED);
+        return LLBC_FAILED;
+    }
+    else if (_coroHandlers.find(opcode) != _coroHandlers.end() ||
+             !_handlers.insert(std::make_pair(opcode, deleg)).second)
+    {
+        LLBC_SetLastError(LLBC_ERROR_REPEAT);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
 
-int LLBC_ServiceImpl::Subscribe(int opcode, const LLBC_Delegate<void(LLBC_Packet &)> &deleg)
+int LLBC_ServiceImpl::SubscribeCoro(int opcode, const LLBC_Delegate<void(LLBC_Packet &)> &deleg)
 {
     if (UNLIKELY(!deleg))
     {
@@ -866,7 +1765,8 @@ int LLBC_ServiceImpl::Subscribe(int opcode, const LLBC_Delegate<void(LLBC_Packet
         LLBC_SetLastError(LLBC_ERROR_INITED);
         return LLBC_FAILED;
     }
-    else if (!_handlers.insert(std::make_pair(opcode, deleg)).second)
+    else if (_handlers.find(opcode) != _handlers.end() ||
+             !_coroHandlers.insert(std::make_pair(opcode, deleg)).second)
     {
         LLBC_SetLastError(LLBC_ERROR_REPEAT);
         return LLBC_FAILED;
@@ -1107,19 +2007,64 @@ void LLBC_ServiceImpl::OnSvc(bool fullFrame)
     if (fullFrame)
         _begHeartbeatTime = LLBC_GetMilliSeconds();
 
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    // Begin frame profile, if enabled(the enabled flag will not change in frame).
+    _profilingFrame = _frameProfileEnabled;
+    if (UNLIKELY(_profilingFrame))
+        BeginFrameProfile();
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
     // Handle frame-tasks.
     HandleFrameTasks();
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_profilingFrame))
+        EndFramePhase(LLBC_FramePhase::FrameTasks);
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+    // Replay due captured packets(will be handled in queued events).
+    if (UNLIKELY(_packetReplaying))
+        UpdatePacketReplay();
 
-    // Process queued events.
+    // Process queued events & resume ready coroutines.
     HandleQueuedEvents();
+    ResumeReadyCoros();
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_profilingFrame))
+        EndFramePhase(LLBC_FramePhase::QueuedEvents);
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
 
     // Update all components.
     UpdateComps();
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_profilingFrame))
+        EndFramePhase(LLBC_FramePhase::UpdateComps);
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
     UpdateTimerScheduler();
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_profilingFrame))
+        EndFramePhase(LLBC_FramePhase::UpdateTimers);
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
     UpdateAutoReleasePool();
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    UpdateOpcodeStatsDump();
+    UpdateQueueStatsDump();
+    if (UNLIKELY(_profilingFrame))
+        EndFramePhase(LLBC_FramePhase::UpdateReleasePool);
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
 
     // Handle frame-tasks.
     HandleFrameTasks();
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_profilingFrame))
+    {
+        EndFramePhase(LLBC_FramePhase::FrameTasks);
+        EndFrameProfile();
+
+        _profilingFrame = false;
+    }
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
 
     // Process Idle.
     if (fullFrame)
@@ -1294,7 +2239,7 @@ void LLBC_ServiceImpl::AddReadySession(int sessionId, int acceptSessionId, bool
     }
 }
 
-void LLBC_ServiceImpl::RemoveReadySession(int sessionId)
+bool LLBC_ServiceImpl::RemoveReadySession(int sessionId)
 {
     // Lock.
     _readySessionInfosLock.Lock();
@@ -1304,25 +2249,124 @@ void LLBC_ServiceImpl::RemoveReadySession(int sessionId)
     if (readySInfoIt == _readySessionInfos.end())
     {
         _readySessionInfosLock.Unlock();
-        return;
+        return false;
     }
 
-    // Erase from dict.
+    // Erase from dict, the ready session info will be deleted after current events handled.
     _ReadySessionInfo *readySInfo = readySInfoIt->second;
     _readySessionInfos.erase(readySInfoIt);
+    if (readySInfo->localPeerSvc)
+        --_localSessionCount;
+    _retiredReadySessionInfos.push_back(readySInfo);
 
     // Unlock.
     _readySessionInfosLock.Unlock();
 
-    // At last, delete ready session info.
-    delete readySInfo;
+    return true;
 }
 
 void LLBC_ServiceImpl::RemoveAllReadySessions()
 {
     _readySessionInfosLock.Lock();
     LLBC_STLHelper::DeleteContainer(_readySessionInfos, true, false);
+    LLBC_STLHelper::DeleteContainer(_retiredReadySessionInfos, true, false);
+    _localSessionCount = 0;
+    _readySessionInfosLock.Unlock();
+}
+
+void LLBC_ServiceImpl::DeleteRetiredReadySessions()
+{
+    std::vector<_ReadySessionInfo *> retiredReadySInfos;
+
+    _readySessionInfosLock.Lock();
+    retiredReadySInfos.swap(_retiredReadySessionInfos);
+    _readySessionInfosLock.Unlock();
+
+    LLBC_STLHelper::DeleteContainer(retiredReadySInfos, true, false);
+}
+
+void LLBC_ServiceImpl::AddLocalReadySession(int sessionId, This *peerSvc, int peerSessionId)
+{
+    // Local session always hold a codec stack, packet encode/decode will be done in service thread.
+    _ReadySessionInfo *readySInfo = new _ReadySessionInfo(sessionId,
+                                                          0,
+                                                          false,
+                                                          CreateCodecStack(sessionId, 0, nullptr));
+    readySInfo->localPeerSvc = peerSvc;
+    readySInfo->localPeerSessionId = peerSessionId;
+
+    _readySessionInfosLock.Lock();
+    _readySessionInfos.insert(std::make_pair(sessionId, readySInfo));
+    ++_localSessionCount;
+    _readySessionInfosLock.Unlock();
+}
+
+int LLBC_ServiceImpl::SendToLocalPeer(This *peerSvc, int peerSessionId, LLBC_Packet *packet)
+{
+    if (UNLIKELY(!peerSvc->_started))
+    {
+        LLBC_Recycle(packet);
+        LLBC_SetLastError(LLBC_ERROR_NOT_INIT);
+
+        return LLBC_FAILED;
+    }
+
+    // Remap session Id to peer side session Id, and push to peer service directly.
+    packet->SetSessionId(peerSessionId);
+    peerSvc->Push(LLBC_SvcEvUtil::BuildDataArrivalEv(packet));
+
+    return LLBC_OK;
+}
+
+void LLBC_ServiceImpl::PushLocalSessionCreateEv(int sessionId)
+{
+    const LLBC_SockAddr_IN nullAddr;
+    Push(LLBC_SvcEvUtil::BuildSessionCreateEv(nullAddr,
+                                              nullAddr,
+                                              false,
+                                              sessionId,
+                                              0,
+                                              LLBC_INVALID_SOCKET_HANDLE));
+}
+
+void LLBC_ServiceImpl::PushLocalSessionDestroyEv(int sessionId, LLBC_SessionCloseInfo *closeInfo)
+{
+    if (UNLIKELY(!_started || _stopping))
+    {
+        delete closeInfo;
+        return;
+    }
+
+    const LLBC_SockAddr_IN nullAddr;
+    Push(LLBC_SvcEvUtil::BuildSessionDestroyEv(nullAddr,
+                                               nullAddr,
+                                               false,
+                                               sessionId,
+                                               0,
+                                               LLBC_INVALID_SOCKET_HANDLE,
+                                               closeInfo));
+}
+
+void LLBC_ServiceImpl::CloseAllLocalSessions()
+{
+    // Collect all local sessions peer info.
+    std::vector<std::pair<This *, int> > localPeers;
+    _readySessionInfosLock.Lock();
+    for (auto &readySInfoItem : _readySessionInfos)
+    {
+        const _ReadySessionInfo * const &readySInfo = readySInfoItem.second;
+        if (readySInfo->localPeerSvc)
+            localPeers.push_back(std::make_pair(readySInfo->localPeerSvc, readySInfo->localPeerSessionId));
+    }
     _readySessionInfosLock.Unlock();
+
+    // Notify all peer services(don't hold _readySessionInfosLock, peer may closing at the same time).
+    for (auto &localPeer : localPeers)
+    {
+        if (localPeer.first->RemoveReadySession(localPeer.second))
+            localPeer.first->PushLocalSessionDestroyEv(localPeer.second,
+                                                       new LLBC_SessionCloseInfo(LLBC_ERROR_END, LLBC_ERROR_SUCCESS));
+    }
 }
 
 void LLBC_ServiceImpl::Svc()
@@ -1359,12 +2403,34 @@ void LLBC_ServiceImpl::Svc()
 
 void LLBC_ServiceImpl::Cleanup()
 {
-    // Force handle queued events.
+    // Force handle queued events(include priority lanes pending packets).
     if (_started &&
         _stopping &&
         _compsStartFinished &&
         _compsStartRet == LLBC_ERROR_SUCCESS)
+    {
         HandleQueuedEvents();
+        HandlePriorityLanes(true);
+    }
+
+    // Cleanup priority lanes unhandled packets & session priorities.
+    ClearPriorityLanes();
+    _priorityLock.Lock();
+    _sessionPriorities.clear();
+    _priorityLock.Unlock();
+
+    // Reset overload state.
+    ResetOverload();
+
+    // Finish all in-flight rpc calls.
+    FinishAllRpcCalls(LLBC_RpcStatus::ServiceStopped);
+
+    // Stop packet capture(flush capture file) & replay.
+    StopPacketCapture();
+    StopPacketReplay();
+
+    // Stop all coroutines(after rpc calls finished, awaiting coroutines already resumed).
+    StopAllCoros();
 
     // Stop poller manager.
     _pollerMgr.Stop();
@@ -1373,7 +2439,8 @@ void LLBC_ServiceImpl::Cleanup()
     if (_driveMode == ExternalDrive)
         _timerScheduler->CancelAll();
 
-    // Cleanup ready-sessionInfos map.
+    // Close all local sessions, cleanup ready-sessionInfos map.
+    CloseAllLocalSessions();
     RemoveAllReadySessions();
 
     // Stop components, destroy release-pool.
@@ -1397,6 +2464,7 @@ void LLBC_ServiceImpl::Cleanup()
 
     // Reset some variables.
     _relaxTimes = 0;
+    _corosStopping = false;
 
     _propCfg.RemoveAllProperties();
     _nonPropCfg = LLBC_Variant::nil;
@@ -1470,104 +2538,632 @@ void LLBC_ServiceImpl::UpdateServiceCfg(LLBC_SvcEv_AppCfgReloadedEv *ev)
                     svcCfgName != "svc")
                     continue;
 
-                const auto &svcCfgAttrs = svcCfg[LLBC_XMLKeys::Attrs];
-                if (svcCfgAttrs["Name"] == GetName() ||
-                    svcCfgAttrs["name"] == GetName())
-                {
-                    _nonPropCfg = svcCfg;
-                    break;
-                }
-            }
+                const auto &svcCfgAttrs = svcCfg[LLBC_XMLKeys::Attrs];
+                if (svcCfgAttrs["Name"] == GetName() ||
+                    svcCfgAttrs["name"] == GetName())
+                {
+                    _nonPropCfg = svcCfg;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+LLBC_String LLBC_ServiceImpl::GetServiceCfgValue(const char *key) const
+{
+    if (_cfgType == LLBC_AppConfigType::Property)
+        return _propCfg.HasProperty(key) ? _propCfg.GetValue(key).AsStr().strip() : LLBC_String();
+    else if (_cfgType == LLBC_AppConfigType::Ini)
+        return _nonPropCfg[GetName()][key].AsStr().strip();
+    else if (_cfgType == LLBC_AppConfigType::Xml)
+        return _nonPropCfg[LLBC_XMLKeys::Attrs][key].AsStr().strip();
+
+    return LLBC_String();
+}
+
+void LLBC_ServiceImpl::ApplyThreadCfg()
+{
+    // Service thread name & cpu affinity.
+    uint64 cpuMask;
+    LLBC_String cfgVal;
+    if (_driveMode == SelfDrive)
+    {
+        LLBC_Task::SetThreadName(!_svcThreadName.empty() ? _svcThreadName : GetServiceCfgValue("threadName"));
+
+        cpuMask = _svcCPUMask;
+        if (cpuMask == 0 &&
+            !(cfgVal = GetServiceCfgValue("cpuAffinity")).empty() &&
+            LLBC_ParseCPUMask(cfgVal.c_str(), cpuMask) != LLBC_OK)
+            LLOG_WARN("Service[%s] cpuAffinity config[%s] invalid, ignored", GetName().c_str(), cfgVal.c_str());
+        LLBC_Task::SetCPUAffinity(cpuMask);
+    }
+
+    // Poller threads name & cpu affinity.
+    _pollerMgr.SetPollerThreadName(
+        !_pollerThreadName.empty() ? _pollerThreadName : GetServiceCfgValue("pollerThreadName"));
+
+    cpuMask = _pollerCPUMask;
+    bool spread = _pollerCPUSpread;
+    if (cpuMask == 0 && !(cfgVal = GetServiceCfgValue("pollerCpuAffinity")).empty())
+    {
+        if (LLBC_ParseCPUMask(cfgVal.c_str(), cpuMask) != LLBC_OK)
+            LLOG_WARN("Service[%s] pollerCpuAffinity config[%s] invalid, ignored", GetName().c_str(), cfgVal.c_str());
+        spread = LLBC_Variant(GetServiceCfgValue("pollerCpuSpread")).AsLooseBool();
+    }
+    _pollerMgr.SetPollerCPUAffinity(cpuMask, spread);
+
+    // Poller busy poll window(if api not set).
+    if (_pollerMgr.GetBusyPollWindow() == 0 &&
+        !(cfgVal = GetServiceCfgValue("pollerBusyPoll")).empty())
+        _pollerMgr.SetBusyPollWindow(MAX(0, LLBC_Str2Int32(cfgVal.c_str())));
+}
+
+void LLBC_ServiceImpl::AddServiceToTls()
+{
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+
+    int idx = 0;
+    const int lmt = LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT;
+    for (; idx <= lmt; ++idx)
+    {
+        if (!tls->commTls.services[idx])
+            break;
+    }
+
+    tls->commTls.services[idx] = this;
+}
+
+void LLBC_ServiceImpl::RemoveServiceFromTls()
+{
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+
+    int idx = 0;
+    const int lmt = LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT;
+    for (; idx <= lmt; ++idx)
+    {
+        if (tls->commTls.services[idx] == this)
+            break;
+    }
+
+    memmove(&tls->commTls.services[idx],
+            &tls->commTls.services[idx + 1],
+            sizeof(tls->commTls.services[0]) * (lmt + 1 - (idx + 1)));
+}
+
+bool LLBC_ServiceImpl::IsCanContinueDriveService()
+{
+    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+
+    int checkIdx = 0;
+    const int lmt = LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT;
+    for (; checkIdx <= lmt; ++checkIdx)
+    {
+        if (tls->commTls.services[checkIdx] == nullptr)
+            break;
+    }
+
+    return checkIdx < lmt ? true : false;
+}
+
+void LLBC_ServiceImpl::HandleFrameTasks()
+{
+    auto &tasks = _frameTasks[_frameTaskIdx];
+    if (tasks.empty())
+        return;
+
+    _frameTaskIdx ^= 1;
+    const auto endIt = tasks.end();
+    for (auto it = tasks.begin(); it != endIt; ++it)
+        (it->first)(this, it->second);
+
+    tasks.clear();
+}
+
+void LLBC_ServiceImpl::DestroyFrameTasks()
+{
+    for (size_t i = 0; i < sizeof(_frameTasks) / sizeof(_frameTasks[0]); ++i)
+        _frameTasks[i].clear();
+    _frameTaskIdx = 0;
+}
+
+void LLBC_ServiceImpl::HandleQueuedEvents()
+{
+    LLBC_MessageBlock *block, *blocks;
+    if (PopAll(blocks) != LLBC_OK)
+        blocks = nullptr;
+
+    // Check overload state(use popped events as queue depth/delay samples), and report state transitions.
+    if (UNLIKELY(_overloadPolicy != LLBC_OverloadPolicy::None))
+        CheckOverload(blocks);
+    if (UNLIKELY(_overloadChanged))
+        NotifyOverloadChanged();
+
+    if (blocks)
+    {
+        #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+        if (UNLIKELY(_queueStatsEnabled))
+            StatDequeuedEvents(blocks);
+        #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+        while (blocks)
+        {
+            block = blocks;
+            blocks = blocks->GetNext();
+
+            if (UNLIKELY(_priorityLanesEnabled))
+                DispatchQueuedEvent(block);
+            else
+                HandleQueuedEvent(block);
+        }
+    }
+
+    // Handle priority lanes packets, the packets which exceed priority budget will be handled in next frame.
+    if (UNLIKELY(_priorityLanesEnabled))
+        HandlePriorityLanes(false);
+
+    // Delete retired ready session infos, all packets which referenced them already handled.
+    // Note: The pending packets in priority lanes not resolved session info yet, so not reference them.
+    DeleteRetiredReadySessions();
+}
+
+void LLBC_ServiceImpl::HandleQueuedEvent(LLBC_MessageBlock *block)
+{
+    LLBC_ServiceEvent *ev = reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
+    (this->*_evHandlers[ev->type])(*ev);
+
+    delete ev;
+    delete block;
+}
+
+void LLBC_ServiceImpl::DispatchQueuedEvent(LLBC_MessageBlock *block)
+{
+    // Data arrival event, place to priority lane.
+    LLBC_ServiceEvent *ev = reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
+    if (ev->type == LLBC_ServiceEventType::DataArrival)
+    {
+        const int priority = GetPacketPriority(static_cast<LLBC_SvcEv_DataArrival *>(ev)->packet);
+        _priorityLanes[priority].push_back(block);
+        ++_priorityLaneSizes[priority];
+
+        return;
+    }
+
+    // Session destroy event, handle all pending packets of the session first.
+    if (ev->type == LLBC_ServiceEventType::SessionDestroy)
+    {
+        const int sessionId = static_cast<LLBC_SvcEv_SessionDestroy *>(ev)->sessionId;
+        FlushSessionPendingPackets(sessionId);
+
+        _priorityLock.Lock();
+        _sessionPriorities.erase(sessionId);
+        _priorityLock.Unlock();
+    }
+
+    // Other events, handle immediately.
+    HandleQueuedEvent(block);
+}
+
+int LLBC_ServiceImpl::GetPacketPriority(const LLBC_Packet *packet)
+{
+    int opcodePriority = LLBC_PacketPriority::End;
+    int sessionPriority = LLBC_PacketPriority::End;
+
+    _priorityLock.Lock();
+    if (!_opcodePriorities.empty())
+    {
+        auto it = _opcodePriorities.find(packet->GetOpcode());
+        if (it != _opcodePriorities.end())
+            opcodePriority = it->second;
+    }
+
+    if (!_sessionPriorities.empty())
+    {
+        auto it = _sessionPriorities.find(packet->GetSessionId());
+        if (it != _sessionPriorities.end())
+            sessionPriority = it->second;
+    }
+    _priorityLock.Unlock();
+
+    // Use the higher priority(less value), if both not set, use Normal priority.
+    const int priority = MIN(opcodePriority, sessionPriority);
+    return priority != LLBC_PacketPriority::End ? priority : static_cast<int>(LLBC_PacketPriority::Normal);
+}
+
+void LLBC_ServiceImpl::HandlePriorityLanes(bool ignoreBudget)
+{
+    for (int priority = LLBC_PacketPriority::Begin; priority != LLBC_PacketPriority::End; ++priority)
+    {
+        auto &lane = _priorityLanes[priority];
+        const int budget = ignoreBudget ? 0 : _priorityBudgets[priority];
+        for (int handled = 0; !lane.empty() && (budget == 0 || handled < budget); ++handled)
+        {
+            LLBC_MessageBlock *block = lane.front();
+            lane.pop_front();
+            --_priorityLaneSizes[priority];
+
+            HandleQueuedEvent(block);
+        }
+    }
+}
+
+void LLBC_ServiceImpl::FlushSessionPendingPackets(int sessionId)
+{
+    std::vector<LLBC_MessageBlock *> sessionBlocks;
+    for (int priority = LLBC_PacketPriority::Begin; priority != LLBC_PacketPriority::End; ++priority)
+    {
+        auto &lane = _priorityLanes[priority];
+        if (lane.empty())
+            continue;
+
+        // Pick out session pending packets(keep arrival order).
+        auto it = lane.begin();
+        while (it != lane.end())
+        {
+            LLBC_ServiceEvent *ev = reinterpret_cast<LLBC_ServiceEvent *>((*it)->GetDataStartWithReadPos());
+            if (static_cast<LLBC_SvcEv_DataArrival *>(ev)->packet->GetSessionId() == sessionId)
+            {
+                sessionBlocks.push_back(*it);
+                it = lane.erase(it);
+                --_priorityLaneSizes[priority];
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    for (auto &block : sessionBlocks)
+        HandleQueuedEvent(block);
+}
+
+void LLBC_ServiceImpl::ClearPriorityLanes()
+{
+    for (int priority = LLBC_PacketPriority::Begin; priority != LLBC_PacketPriority::End; ++priority)
+    {
+        auto &lane = _priorityLanes[priority];
+        for (auto &block : lane)
+        {
+            delete reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
+            delete block;
+        }
+
+        lane.clear();
+        _priorityLaneSizes[priority] = 0;
+    }
+}
+
+bool LLBC_ServiceImpl::ShedOverloadPacket(LLBC_MessageBlock *block)
+{
+    LLBC_ServiceEvent *ev = reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
+    if (ev->type != LLBC_ServiceEventType::DataArrival ||
+        GetPacketPriority(static_cast<LLBC_SvcEv_DataArrival *>(ev)->packet) != LLBC_PacketPriority::Low)
+        return false;
+
+    LLBC_SvcEvUtil::DestroyEvBlock(block);
+
+    _overloadLock.Lock();
+    ++_shedPacketCount;
+    _overloadLock.Unlock();
+
+    return true;
+}
+
+void LLBC_ServiceImpl::CheckOverload(LLBC_MessageBlock *blocks)
+{
+    // Queue depth = popped events count + priority lanes pending packets count.
+    // Queueing delay = the oldest popped event queued time.
+    size_t queueDepth = 0;
+    sint64 queueDelay = 0;
+    const sint64 now = LLBC_GetMicroSeconds();
+    for (LLBC_MessageBlock *block = blocks; block; block = block->GetNext())
+    {
+        ++queueDepth;
+        const LLBC_ServiceEvent *ev = reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
+        if (queueDelay == 0 && ev->enqueueTime > 0)
+            queueDelay = (now - ev->enqueueTime) / 1000;
+    }
+
+    for (int priority = LLBC_PacketPriority::Begin; priority != LLBC_PacketPriority::End; ++priority)
+        queueDepth += _priorityLaneSizes[priority];
+
+    LLBC_LockGuard guard(_overloadLock);
+    if (!_overloaded)
+    {
+        if ((_overloadHighWatermark > 0 && queueDepth >= _overloadHighWatermark) ||
+            (_overloadMaxDelay > 0 && queueDelay >= _overloadMaxDelay))
+            EnterOverload(queueDepth, queueDelay);
+    }
+    else if ((_overloadHighWatermark == 0 || queueDepth <= _overloadLowWatermark) &&
+             (_overloadMaxDelay == 0 || queueDelay <= _overloadMaxDelay / 2) &&
+             LLBC_GetMilliSeconds() - _overloadBeginTime >= LLBC_CFG_COMM_MIN_OVERLOAD_DURATION)
+    {
+        LeaveOverload(queueDepth, queueDelay);
+    }
+}
+
+void LLBC_ServiceImpl::EnterOverload(size_t queueDepth, sint64 queueDelay)
+{
+    _overloaded = true;
+    _overloadBeginTime = LLBC_GetMilliSeconds();
+    _overloadBeginShedCount = _shedPacketCount;
+    _pollerMgr.SetOverloadFlags(_overloadPolicy & (LLBC_OverloadPolicy::PauseRead | LLBC_OverloadPolicy::RejectAccept));
+
+    LLBC_OverloadInfo info;
+    info.overloaded = true;
+    info.policy = _overloadPolicy;
+    info.queueDepth = queueDepth;
+    info.queueDelay = queueDelay;
+    _pendingOverloadInfos.push_back(info);
+
+    _overloadChanged = true;
+}
+
+void LLBC_ServiceImpl::LeaveOverload(size_t queueDepth, sint64 queueDelay)
+{
+    _overloaded = false;
+    _pollerMgr.SetOverloadFlags(LLBC_OverloadPolicy::None);
+
+    LLBC_OverloadInfo info;
+    info.overloaded = false;
+    info.policy = _overloadPolicy;
+    info.queueDepth = queueDepth;
+    info.queueDelay = queueDelay;
+    info.overloadTime = LLBC_GetMilliSeconds() - _overloadBeginTime;
+    info.shedPacketCount = _shedPacketCount - _overloadBeginShedCount;
+    _pendingOverloadInfos.push_back(info);
+
+    _overloadChanged = true;
+}
+
+void LLBC_ServiceImpl::NotifyOverloadChanged()
+{
+    _overloadLock.Lock();
+    std::vector<LLBC_OverloadInfo> infos;
+    infos.swap(_pendingOverloadInfos);
+    _overloadChanged = false;
+    const bool shedPending = _overloaded && (_overloadPolicy & LLBC_OverloadPolicy::ShedLowPriority);
+    _overloadLock.Unlock();
+
+    // Shed the low priority packets which queued before overloaded.
+    if (shedPending && !_priorityLanes[LLBC_PacketPriority::Low].empty())
+    {
+        const size_t shedCount = _priorityLanes[LLBC_PacketPriority::Low].size();
+        for (auto &block : _priorityLanes[LLBC_PacketPriority::Low])
+            LLBC_SvcEvUtil::DestroyEvBlock(block);
+        _priorityLanes[LLBC_PacketPriority::Low].clear();
+        _priorityLaneSizes[LLBC_PacketPriority::Low] = 0;
+
+        _overloadLock.Lock();
+        _shedPacketCount += shedCount;
+        _overloadLock.Unlock();
+    }
+
+    auto &caredComps = _caredEventComps[LLBC_ComponentEventIndex::OnOverloadChanged];
+    for (auto &info : infos)
+    {
+        if (info.overloaded)
+            LLOG_WARN("Service[%s] %s", GetName().c_str(), info.ToString().c_str());
+        else
+            LLOG_INFO("Service[%s] %s", GetName().c_str(), info.ToString().c_str());
+
+        const size_t compsSize = caredComps.size();
+        for (size_t compIdx = 0; compIdx != compsSize; ++compIdx)
+        {
+            LLBC_Component *&comp = caredComps[compIdx];
+            if (LIKELY(comp->_started))
+                comp->OnOverloadChanged(info);
         }
     }
 }
 
-void LLBC_ServiceImpl::AddServiceToTls()
+void LLBC_ServiceImpl::ResetOverload()
 {
-    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    LLBC_LockGuard guard(_overloadLock);
+    _overloaded = false;
+    _pollerMgr.SetOverloadFlags(LLBC_OverloadPolicy::None);
 
-    int idx = 0;
-    const int lmt = LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT;
-    for (; idx <= lmt; ++idx)
+    _pendingOverloadInfos.clear();
+    _overloadChanged = false;
+}
+
+void LLBC_ServiceImpl::OnRpcCallTimeout(LLBC_Timer *timer)
+{
+    FinishRpcCall(timer->GetTimerData().AsInt64(), LLBC_RpcStatus::Timeout, nullptr);
+}
+
+bool LLBC_ServiceImpl::FinishRpcCall(sint64 callId, int rpcStatus, LLBC_Packet *response)
+{
+    auto callIt = _rpcCalls.find(callId);
+    if (callIt == _rpcCalls.end())
+        return false;
+
+    // Erase call before callback, callback may issue new calls.
+    const _RpcCall call = callIt->second;
+    _rpcCalls.erase(callIt);
+
+    // Delete timer(timer scheduler allow delete timer in it's timeout handler).
+    delete call.timer;
+
+    LLBC_RpcResult result;
+    result.callId = callId;
+    result.sessionId = call.sessionId;
+    result.opcode = call.opcode;
+    result.status = rpcStatus;
+    result.elapsed = LLBC_GetMicroSeconds() - call.beginTime;
+    result.response = response;
+    call.callback(result);
+
+    return true;
+}
+
+void LLBC_ServiceImpl::FinishSessionRpcCalls(int sessionId, int rpcStatus)
+{
+    std::vector<sint64> callIds;
+    for (auto &callItem : _rpcCalls)
     {
-        if (!tls->commTls.services[idx])
-            break;
+        if (callItem.second.sessionId == sessionId)
+            callIds.push_back(callItem.first);
     }
 
-    tls->commTls.services[idx] = this;
+    for (auto &callId : callIds)
+        FinishRpcCall(callId, rpcStatus, nullptr);
 }
 
-void LLBC_ServiceImpl::RemoveServiceFromTls()
+void LLBC_ServiceImpl::FinishAllRpcCalls(int rpcStatus)
 {
-    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    std::vector<sint64> callIds;
+    for (auto &callItem : _rpcCalls)
+        callIds.push_back(callItem.first);
 
-    int idx = 0;
-    const int lmt = LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT;
-    for (; idx <= lmt; ++idx)
+    for (auto &callId : callIds)
+        FinishRpcCall(callId, rpcStatus, nullptr);
+
+    // Discard the calls issued in callbacks.
+    for (auto &callItem : _rpcCalls)
+        delete callItem.second.timer;
+    _rpcCalls.clear();
+}
+
+int LLBC_ServiceImpl::RunCoro(sint64 coroId, LLBC_Coro *coro)
+{
+    const sint64 prevCoroId = _curCoroId;
+    _curCoroId = coroId;
+    const int ret = coro->Resume();
+    _curCoroId = prevCoroId;
+    if (UNLIKELY(ret != LLBC_OK))
+        return LLBC_FAILED;
+
+    // Coroutine finished, release coroutine & stack.
+    if (coro->IsFinished())
     {
-        if (tls->commTls.services[idx] == this)
-            break;
+        _coros.erase(coroId);
+        delete coro;
     }
 
-    memmove(&tls->commTls.services[idx],
-            &tls->commTls.services[idx + 1],
-            sizeof(tls->commTls.services[0]) * (lmt + 1 - (idx + 1)));
+    return LLBC_OK;
 }
 
-bool LLBC_ServiceImpl::IsCanContinueDriveService()
+void LLBC_ServiceImpl::ResumeReadyCoros()
 {
-    __LLBC_LibTls *tls = __LLBC_GetLibTls();
+    if (_readyCoros.empty())
+        return;
 
-    int checkIdx = 0;
-    const int lmt = LLBC_CFG_COMM_PER_THREAD_DRIVE_MAX_SVC_COUNT;
-    for (; checkIdx <= lmt; ++checkIdx)
+    // Swap out ready coroutines, coroutines yield to next loop will not be resumed in this loop.
+    std::vector<sint64> readyCoros;
+    readyCoros.swap(_readyCoros);
+    for (auto &coroId : readyCoros)
     {
-        if (tls->commTls.services[checkIdx] == nullptr)
-            break;
+        auto coroIt = _coros.find(coroId);
+        if (coroIt != _coros.end() &&
+            coroIt->second->GetState() == LLBC_Coro::State::Suspended)
+            RunCoro(coroId, coroIt->second);
     }
+}
 
-    return checkIdx < lmt ? true : false;
+void LLBC_ServiceImpl::StopAllCoros()
+{
+    // Resume all suspended coroutines, all awaits return failed when stopping.
+    _corosStopping = true;
+    _readyCoros.clear();
+    std::vector<sint64> coroIds;
+    for (auto &coroItem : _coros)
+        coroIds.push_back(coroItem.first);
+
+    for (auto &coroId : coroIds)
+    {
+        auto coroIt = _coros.find(coroId);
+        if (coroIt != _coros.end() &&
+            coroIt->second->GetState() == LLBC_Coro::State::Suspended)
+            RunCoro(coroId, coroIt->second);
+    }
+
+    // Coroutine can't yield when stopping, all coroutines should finished here.
+    LLBC_STLHelper::DeleteContainer(_coros);
+    _readyCoros.clear();
 }
 
-void LLBC_ServiceImpl::HandleFrameTasks()
+void LLBC_ServiceImpl::CapturePacket(const LLBC_Packet &packet)
 {
-    auto &tasks = _frameTasks[_frameTaskIdx];
-    if (tasks.empty())
+    LLBC_LockGuard guard(_captureLock);
+    if (UNLIKELY(!_captureWriter))
         return;
 
-    _frameTaskIdx ^= 1;
-    const auto endIt = tasks.end();
-    for (auto it = tasks.begin(); it != endIt; ++it)
-        (it->first)(this, it->second);
+    // Write failed(eg: disk full), stop capture.
+    if (UNLIKELY(_captureWriter->Write(packet) != LLBC_OK))
+    {
+        LLOG_WARN("Service[%s] capture packet to file[%s] failed, stop capture, err: %s",
+                  GetName().c_str(), _captureWriter->GetFilePath().c_str(), LLBC_FormatLastError());
 
-    tasks.clear();
+        _packetCapturing = false;
+        LLBC_XDelete(_captureWriter);
+    }
 }
 
-void LLBC_ServiceImpl::DestroyFrameTasks()
+void LLBC_ServiceImpl::UpdatePacketReplay()
 {
-    for (size_t i = 0; i < sizeof(_frameTasks) / sizeof(_frameTasks[0]); ++i)
-        _frameTasks[i].clear();
-    _frameTaskIdx = 0;
+    LLBC_LockGuard guard(_replayLock);
+    if (UNLIKELY(!_replayReader))
+        return;
+
+    // Replay due records, records timestamp scaled by replay speed.
+    const sint64 elapsed = (LLBC_CPUTime::Current() - _replayBeginTime).ToNanoSeconds();
+    for (int i = 0; i < LLBC_CFG_COMM_PACKET_REPLAY_BATCH_SIZE; ++i)
+    {
+        if (!_replayRecordPending)
+        {
+            if (_replayReader->Read(_replayRecord) != LLBC_OK)
+            {
+                if (LLBC_GetLastError() != LLBC_ERROR_END)
+                    LLOG_WARN("Service[%s] replay packet capture failed, capture file corrupted, err: %s",
+                              GetName().c_str(), LLBC_FormatLastError());
+
+                _packetReplaying = false;
+                LLBC_XDelete(_replayReader);
+
+                return;
+            }
+
+            _replayRecordPending = true;
+        }
+
+        if (_replaySpeed > 0.0 && _replayRecord.timestamp / _replaySpeed > elapsed)
+            break;
+
+        ReplayPacket(_replayRecord);
+        _replayRecordPending = false;
+    }
 }
 
-void LLBC_ServiceImpl::HandleQueuedEvents()
+void LLBC_ServiceImpl::ReplayPacket(const LLBC_PacketCaptureRecord &record)
 {
-    LLBC_ServiceEvent *ev;
-    LLBC_MessageBlock *block, *blocks;
-    if (PopAll(blocks) == LLBC_OK)
+    LLBC_Packet *packet = _packetObjectPool.GetObject();
+    packet->SetHeader(_replaySessionId != 0 ? _replaySessionId : record.sessionId, record.opcode, record.status);
+    if (record.payloadLen > 0)
+        packet->Write(record.payload, record.payloadLen);
+
+    // Decode packet(full-stack session packets decoded in poller).
+    auto coderIt = _coders.find(record.opcode);
+    if (coderIt != _coders.end())
     {
-        while (blocks)
+        LLBC_Coder *coder = coderIt->second->Create();
+        if (UNLIKELY(!coder->Decode(*packet)))
         {
-            block = blocks;
-            blocks = blocks->GetNext();
+            LLOG_WARN("Service[%s] replay packet decode failed, opcode: %d, payloadLen: %lu",
+                      GetName().c_str(), record.opcode, record.payloadLen);
 
-            ev = reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
-            (this->*_evHandlers[ev->type])(*ev);
+            LLBC_Recycle(coder);
+            LLBC_Recycle(packet);
 
-            delete ev;
-            delete block;
+            return;
         }
+
+        packet->SetDecoder(coder);
     }
+
+    // Deliver to normal data arrival path.
+    Push(LLBC_SvcEvUtil::BuildDataArrivalEv(packet));
 }
 
 void LLBC_ServiceImpl::HandleEv_SessionCreate(LLBC_ServiceEvent &_)
@@ -1575,9 +3171,21 @@ void LLBC_ServiceImpl::HandleEv_SessionCreate(LLBC_ServiceEvent &_)
     typedef LLBC_SvcEv_SessionCreate _Ev;
     _Ev &ev = static_cast<_Ev &>(_);
 
-    // Add session to connected sessionIds set.
+    // Add session to connected sessionIds set, and fill session info(received packets resolve addresses from it).
     {
         AddReadySession(ev.sessionId, ev.acceptSessionId, ev.isListen, true);
+
+        _readySessionInfosLock.Lock();
+        auto readySInfoIt = _readySessionInfos.find(ev.sessionId);
+        if (readySInfoIt != _readySessionInfos.end())
+        {
+            LLBC_SessionInfo &sessionInfo = readySInfoIt->second->sessionInfo;
+            sessionInfo.SetAcceptSessionId(ev.acceptSessionId);
+            sessionInfo.SetLocalAddr(ev.local);
+            sessionInfo.SetPeerAddr(ev.peer);
+            sessionInfo.SetSocket(ev.handle);
+        }
+        _readySessionInfosLock.Unlock();
     }
 
     // Check has care session-create ev comps or not, if has cared event comps, dispatch event.
@@ -1614,6 +3222,10 @@ void LLBC_ServiceImpl::HandleEv_SessionDestroy(LLBC_ServiceEvent &_)
         RemoveReadySession(ev.sessionId);
     }
 
+    // Finish session in-flight rpc calls.
+    if (!_rpcCalls.empty())
+        FinishSessionRpcCalls(ev.sessionId, LLBC_RpcStatus::SessionDestroyed);
+
     // Check has care session-destroy ev comps or not, if has cared event comps, dispatch event.
     auto &caredComps = _caredEventComps[LLBC_ComponentEventIndex::OnSessionDestroy];
     if (!caredComps.empty())
@@ -1671,9 +3283,12 @@ void LLBC_ServiceImpl::HandleEv_AsyncConnResult(LLBC_ServiceEvent &_)
         }
     }
 
-    // Remove session protocol factory, if connect failed.
+    // Remove session protocol factory and route, if connect failed.
     if (!ev.connected)
+    {
         RemoveSessionProtocolFactory(ev.sessionId);
+        _pollerMgr.RemoveRoute(ev.sessionId);
+    }
 }
 
 void LLBC_ServiceImpl::HandleEv_DataArrival(LLBC_ServiceEvent &_)
@@ -1695,10 +3310,21 @@ void LLBC_ServiceImpl::HandleEv_DataArrival(LLBC_ServiceEvent &_)
 
     ev.packet = nullptr;
 
-    if (!_fullStack)
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    // Record statistics begin info, if opcode statistics enabled.
+    const bool statEnabled = _opcodeStatsEnabled;
+    const size_t statBytes = statEnabled ? packet->GetPayloadLength() : 0;
+    sint64 statDecodeTime = -1;
+    LLBC_CPUTime statBegTime = statEnabled ? LLBC_CPUTime::Current() : LLBC_CPUTime();
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+    // Decode packet, if not decoded in poller(decode offload enabled and not local session) or in replay.
+    const _ReadySessionInfo * const &readySInfo = readySInfoIt->second;
+    if (readySInfo->codecStack &&
+        (!_decodeOffload || readySInfo->localPeerSvc) &&
+        !packet->GetDecoder())
     {
         bool removeSession;
-        const _ReadySessionInfo * const &readySInfo = readySInfoIt->second;
         if (UNLIKELY(readySInfo->codecStack->RecvCodec(packet, packet, removeSession) != LLBC_OK))
         {
             _readySessionInfosLock.Unlock();
@@ -1707,10 +3333,20 @@ void LLBC_ServiceImpl::HandleEv_DataArrival(LLBC_ServiceEvent &_)
 
             return;
         }
+
+        #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+        if (statEnabled)
+            statDecodeTime = (LLBC_CPUTime::Current() - statBegTime).ToNanoSeconds();
+        #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
     }
 
+    packet->SetSessionInfo(&readySInfo->sessionInfo);
     _readySessionInfosLock.Unlock();
 
+    // Capture packet(whole raw payload, decode not affect it), if packet capture started.
+    if (UNLIKELY(_packetCapturing))
+        CapturePacket(*packet);
+
     // Packet receiver service Id set or dispatch to another service.
     const int recverSvcId = packet->GetRecverServiceId();
     if (recverSvcId == 0) // Set receiver service Id, if the packet's receiver service Id is 0.
@@ -1726,11 +3362,36 @@ void LLBC_ServiceImpl::HandleEv_DataArrival(LLBC_ServiceEvent &_)
             return;
         }
 
+        packet->SetSessionInfo(nullptr); // Copy addresses, the session info only available in this service.
         recverSvc->Push(LLBC_SvcEvUtil::BuildDataArrivalEv(packet));
         return;
     }
 
     const int opcode = packet->GetOpcode();
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    // Stat/Profile packet when handle finished(any return path), if opcode statistics or frame profile enabled.
+    const bool profileEnabled = _profilingFrame;
+    if (statEnabled || profileEnabled)
+        statBegTime = LLBC_CPUTime::Current();
+    LLBC_Defer(if (statEnabled || profileEnabled)
+               {
+                   const sint64 handleTime = (LLBC_CPUTime::Current() - statBegTime).ToNanoSeconds();
+                   if (statEnabled)
+                       StatRecvPacket(opcode, statBytes, statDecodeTime, handleTime);
+                   if (profileEnabled)
+                       ProfileHandledPacket(opcode, handleTime);
+               });
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+    // Rpc response packet, deliver to call callback(late response of finished call will be discarded).
+    if (packet->HasFlags(LLBC_RpcFlags::Response))
+    {
+        FinishRpcCall(packet->GetExtData1(), LLBC_RpcStatus::Ok, packet);
+        LLBC_Recycle(packet);
+
+        return;
+    }
+
     #if LLBC_CFG_COMM_ENABLE_STATUS_HANDLER || LLBC_CFG_COMM_ENABLE_STATUS_DESC
     const int status = packet->GetStatus();
     if (status != 0)
@@ -1782,6 +3443,27 @@ void LLBC_ServiceImpl::HandleEv_DataArrival(LLBC_ServiceEvent &_)
     }
     #endif // LLBC_CFG_COMM_ENABLE_UNIFY_PRESUBSCRIBE
 
+    // Coroutine packet handler, packet will be recycled after handler returned.
+    if (!_coroHandlers.empty())
+    {
+        auto coroIt = _coroHandlers.find(opcode);
+        if (coroIt != _coroHandlers.end())
+        {
+            auto &handler = coroIt->second;
+            if (Go([&handler, packet]() {
+                    handler(*packet);
+                    LLBC_Recycle(packet);
+                }) != 0)
+                return;
+
+            // Create coroutine failed(eg: service stopping), handle packet directly.
+            handler(*packet);
+            LLBC_Recycle(packet);
+
+            return;
+        }
+    }
+
     // Finally, search packet handler to handle,
     // if not found any packet handler, dispatch unhandled-packet event to all comps.
     auto it = _handlers.find(opcode);
@@ -2137,6 +3819,25 @@ void LLBC_ServiceImpl::UpdateComps()
     if (caredComps.empty())
         return;
 
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    if (UNLIKELY(_profilingFrame))
+    {
+        const size_t compsSize = caredComps.size();
+        for (size_t compIdx = 0; compIdx != compsSize; ++compIdx)
+        {
+            LLBC_Component *&comp = caredComps[compIdx];
+            if (LIKELY(comp->_started))
+            {
+                const LLBC_CPUTime begTime = LLBC_CPUTime::Current();
+                comp->OnUpdate();
+                _curFrameCompTimes[compIdx] += (LLBC_CPUTime::Current() - begTime).ToNanoSeconds();
+            }
+        }
+
+        return;
+    }
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
     const size_t compsSize = caredComps.size();
     for (size_t compIdx = 0; compIdx != compsSize; ++compIdx)
     {
@@ -2305,6 +4006,232 @@ void LLBC_ServiceImpl::ClearHoldedObjectPools()
 {
 }
 
+#if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+void LLBC_ServiceImpl::StatRecvPacket(int opcode, size_t bytes, sint64 decodeTime, sint64 handleTime)
+{
+    LLBC_LockGuard guard(_opcodeStatsLock);
+
+    LLBC_OpcodeStat &stat = _opcodeStats[opcode];
+    ++stat.recvCount;
+    stat.recvBytes += bytes;
+    if (decodeTime >= 0)
+        stat.decodeTime.Record(decodeTime);
+    stat.handleTime.Record(handleTime);
+}
+
+void LLBC_ServiceImpl::StatSendPacket(LLBC_Packet *packet)
+{
+    // Encode packet in caller thread, make sure sent bytes can be counted.
+    packet->Encode();
+
+    LLBC_LockGuard guard(_opcodeStatsLock);
+
+    LLBC_OpcodeStat &stat = _opcodeStats[packet->GetOpcode()];
+    ++stat.sendCount;
+    stat.sendBytes += packet->GetPayloadLength();
+}
+
+void LLBC_ServiceImpl::UpdateOpcodeStatsDump()
+{
+    if (LIKELY(_opcodeStatsDumpInterval <= 0))
+        return;
+
+    _opcodeStatsLock.Lock();
+    const sint64 now = LLBC_GetMilliSeconds();
+    if (_opcodeStatsDumpInterval <= 0 ||
+        now - _lastOpcodeStatsDumpTime < _opcodeStatsDumpInterval)
+    {
+        _opcodeStatsLock.Unlock();
+        return;
+    }
+
+    _lastOpcodeStatsDumpTime = now;
+
+    // Format opcode statistics.
+    LLBC_String dumpStr;
+    dumpStr.format("Service[%s] opcode stats(%lu opcodes):", _name.c_str(), _opcodeStats.size());
+    for (auto &statItem : _opcodeStats)
+        dumpStr.append_format("\n  opcode:%d, %s", statItem.first, statItem.second.ToString().c_str());
+
+    if (_resetOpcodeStatsAfterDump)
+        _opcodeStats.clear();
+
+    const LLBC_String dumpLogger = _opcodeStatsDumpLogger;
+    _opcodeStatsLock.Unlock();
+
+    // Dump to logger.
+    const char *loggerName = dumpLogger.empty() ? nullptr : dumpLogger.c_str();
+    LLOG(loggerName,
+         nullptr,
+         LLBC_LogLevel::Info,
+         "%s",
+         dumpStr.c_str());
+}
+
+void LLBC_ServiceImpl::BeginFrameProfile()
+{
+    _curFrameInfo.Reset();
+    _curFrameCompTimes.assign(_caredEventComps[LLBC_ComponentEventIndex::OnUpdate].size(), 0);
+
+    _framePhaseBegTime = LLBC_CPUTime::Current();
+}
+
+void LLBC_ServiceImpl::EndFramePhase(int phase)
+{
+    const LLBC_CPUTime now = LLBC_CPUTime::Current();
+    const sint64 phaseTime = (now - _framePhaseBegTime).ToNanoSeconds();
+
+    _curFrameInfo.phaseTimes[phase] += phaseTime;
+    _curFrameInfo.frameTime += phaseTime;
+
+    _framePhaseBegTime = now;
+}
+
+void LLBC_ServiceImpl::ProfileHandledPacket(int opcode, sint64 handleTime)
+{
+    if (handleTime > _curFrameInfo.slowestOpcodeTime)
+    {
+        _curFrameInfo.slowestOpcode = opcode;
+        _curFrameInfo.slowestOpcodeTime = handleTime;
+    }
+}
+
+void LLBC_ServiceImpl::EndFrameProfile()
+{
+    // Cache update components name(components will not change after service started).
+    const auto &updateComps = _caredEventComps[LLBC_ComponentEventIndex::OnUpdate];
+    if (UNLIKELY(_updateCompNames.size() != updateComps.size()))
+    {
+        _updateCompNames.clear();
+        for (auto &updateComp : updateComps)
+        {
+            const char *compName = "Unknown";
+            for (auto &compItem : _name2Comps)
+            {
+                if (compItem.second == updateComp)
+                {
+                    compName = compItem.first.c_str();
+                    break;
+                }
+            }
+
+            _updateCompNames.emplace_back(compName);
+        }
+    }
+
+    // Find the slowest component.
+    for (size_t compIdx = 0; compIdx != _curFrameCompTimes.size(); ++compIdx)
+    {
+        if (_curFrameCompTimes[compIdx] > _curFrameInfo.slowestCompTime)
+        {
+            _curFrameInfo.slowestComp = _updateCompNames[compIdx];
+            _curFrameInfo.slowestCompTime = _curFrameCompTimes[compIdx];
+        }
+    }
+
+    // Record profile & check frame budget.
+    _frameProfileLock.Lock();
+
+    const sint64 now = LLBC_GetMilliSeconds();
+    if (_frameProfile.beginTime == 0)
+    {
+        _frameProfile.beginTime = now;
+    }
+    else if (now - _frameProfile.beginTime >= LLBC_CFG_COMM_FRAME_PROFILE_WINDOW)
+    {
+        _lastFrameProfile = _frameProfile;
+        _frameProfile.Reset();
+        _frameProfile.beginTime = now;
+    }
+
+    ++_frameProfile.frameCount;
+    _frameProfile.frameTime.Record(_curFrameInfo.frameTime);
+    for (int phase = LLBC_FramePhase::Begin; phase != LLBC_FramePhase::End; ++phase)
+        _frameProfile.phaseTimes[phase].Record(_curFrameInfo.phaseTimes[phase]);
+    for (size_t compIdx = 0; compIdx != _curFrameCompTimes.size(); ++compIdx)
+        _frameProfile.compUpdateTimes[_updateCompNames[compIdx]].Record(_curFrameCompTimes[compIdx]);
+
+    const int budget = _slowFrameBudget > 0 ? _slowFrameBudget : _frameInterval;
+    _curFrameInfo.budget = static_cast<sint64>(budget) * 1000000;
+    if (budget <= 0 || _curFrameInfo.frameTime <= _curFrameInfo.budget)
+    {
+        _frameProfileLock.Unlock();
+        return;
+    }
+
+    ++_frameProfile.overrunCount;
+    const LLBC_Delegate<void(const LLBC_SlowFrameInfo &)> slowFrameHandler = _slowFrameHandler;
+    _frameProfileLock.Unlock();
+
+    // Call slow frame handler.
+    if (slowFrameHandler)
+        slowFrameHandler(_curFrameInfo);
+}
+
+void LLBC_ServiceImpl::StatDequeuedEvents(LLBC_MessageBlock *blocks)
+{
+    const sint64 now = LLBC_GetMicroSeconds();
+
+    LLBC_LockGuard guard(_queueStatLock);
+
+    size_t depth = 0;
+    for (LLBC_MessageBlock *block = blocks; block; block = block->GetNext())
+    {
+        ++depth;
+        const LLBC_ServiceEvent *ev = reinterpret_cast<LLBC_ServiceEvent *>(block->GetDataStartWithReadPos());
+        if (ev->enqueueTime > 0) // Events pushed before statistics enabled have no enqueue time.
+            _queueStat.RecordDequeue((now - ev->enqueueTime) * 1000);
+    }
+
+    _queueStat.RecordWakeup(depth);
+}
+
+void LLBC_ServiceImpl::UpdateQueueStatsDump()
+{
+    if (LIKELY(_queueStatsDumpInterval <= 0))
+        return;
+
+    _queueStatLock.Lock();
+    const sint64 now = LLBC_GetMilliSeconds();
+    if (_queueStatsDumpInterval <= 0 ||
+        now - _lastQueueStatsDumpTime < _queueStatsDumpInterval)
+    {
+        _queueStatLock.Unlock();
+        return;
+    }
+
+    _lastQueueStatsDumpTime = now;
+
+    // Format service queue statistics.
+    LLBC_String dumpStr;
+    dumpStr.format("Service[%s] queue stats:\n  service: depth:%lu, %s",
+                   _name.c_str(), GetMessageSize(), _queueStat.ToString().c_str());
+    if (_resetQueueStatsAfterDump)
+        _queueStat.Reset();
+
+    const bool resetAfterDump = _resetQueueStatsAfterDump;
+    const LLBC_String dumpLogger = _queueStatsDumpLogger;
+    _queueStatLock.Unlock();
+
+    // Format pollers queue statistics.
+    std::vector<LLBC_QueueStat> pollerStats;
+    _pollerMgr.GetQueueStats(pollerStats);
+    if (resetAfterDump)
+        _pollerMgr.ResetQueueStats();
+
+    for (size_t pollerIdx = 0; pollerIdx != pollerStats.size(); ++pollerIdx)
+        dumpStr.append_format("\n  poller %lu: %s", pollerIdx, pollerStats[pollerIdx].ToString().c_str());
+
+    // Dump to logger.
+    const char *loggerName = dumpLogger.empty() ? nullptr : dumpLogger.c_str();
+    LLOG(loggerName,
+         nullptr,
+         LLBC_LogLevel::Info,
+         "%s",
+         dumpStr.c_str());
+}
+#endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
 void LLBC_ServiceImpl::InitTimerScheduler()
 {
     if (!_timerScheduler)
@@ -2316,7 +4243,15 @@ void LLBC_ServiceImpl::InitTimerScheduler()
 
 void LLBC_ServiceImpl::UpdateTimerScheduler()
 {
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    // Timer scheduler maybe shared by services in same thread, set profile flag in every update.
+    _timerScheduler->SetTimeoutProfileEnabled(_profilingFrame);
+    _timerScheduler->Update();
+    if (UNLIKELY(_profilingFrame))
+        _timerScheduler->GetSlowestTimeout(_curFrameInfo.slowestTimerId, _curFrameInfo.slowestTimerTime);
+    #else // !LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
     _timerScheduler->Update();
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
 }
 
 void LLBC_ServiceImpl::ClearHoldedTimerScheduler()
@@ -2372,7 +4307,7 @@ int LLBC_ServiceImpl::LockableSend(LLBC_Packet *packet,
     // Validate check, if need.
     const _ReadySessionInfo *readySInfo = nullptr;
     const int sessionId = packet->GetSessionId();
-    if (!_fullStack || validCheck)
+    if (!_fullStack || validCheck || _localSessionCount > 0)
     {
         decltype(_readySessionInfos)::const_iterator readySInfoIt;
 
@@ -2406,16 +4341,23 @@ int LLBC_ServiceImpl::LockableSend(LLBC_Packet *packet,
             return LLBC_FAILED;
         }
 
-        // If enabled full-stack option, unlock _readySessionInfosLock.
-        if (_fullStack)
+        // If session don't need codec in service(enabled full-stack option and not local session),
+        // unlock _readySessionInfosLock.
+        if (!readySInfo->codecStack)
             _readySessionInfosLock.Unlock();
     }
 
     // Set sender service Id.
     packet->SetSenderServiceId(_id);
 
-    // If enabled full-stack option, send packet and return.
-    if (_fullStack)
+    #if LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+    // Stat send packet, if opcode statistics enabled.
+    if (_opcodeStatsEnabled)
+        StatSendPacket(packet);
+    #endif // LLBC_CFG_COMM_ENABLE_SAMPLER_SUPPORT
+
+    // If session don't need codec in service, send packet and return.
+    if (!readySInfo || !readySInfo->codecStack)
     {
         const int ret = _pollerMgr.Send(packet);
         if (lock)
@@ -2439,11 +4381,14 @@ int LLBC_ServiceImpl::LockableSend(LLBC_Packet *packet,
         return LLBC_FAILED;
     }
 
-    // Unlock _readySessionInfosLock.
+    // Fetch local peer info, unlock _readySessionInfosLock.
+    This * const localPeerSvc = readySInfo->localPeerSvc;
+    const int localPeerSessionId = readySInfo->localPeerSessionId;
     _readySessionInfosLock.Unlock();
 
-    // Send encoded packet.
-    const int ret = _pollerMgr.Send(encoded);
+    // Send encoded packet, local session packet will be pushed to peer service directly.
+    const int ret = localPeerSvc ?
+        SendToLocalPeer(localPeerSvc, localPeerSessionId, encoded) : _pollerMgr.Send(encoded);
     if (lock)
         _lock.Unlock();
 
@@ -2619,6 +4564,13 @@ LLBC_ServiceImpl::_ReadySessionInfo::_ReadySessionInfo(int sessionId,
     this->acceptSessionId = acceptSessionId;
     this->isListenSession = isListenSession;
     this->codecStack = codecStack;
+
+    this->localPeerSvc = nullptr;
+    this->localPeerSessionId = 0;
+
+    this->sessionInfo.SetIsListenSession(isListenSession);
+    this->sessionInfo.SetSessionId(sessionId);
+    this->sessionInfo.SetAcceptSessionId(acceptSessionId);
 }
 
 LLBC_ServiceImpl::_ReadySessionInfo::~_ReadySessionInfo()
@@ -27,6 +27,7 @@
 #include "llbc/comm/Packet.h"
 #include "llbc/comm/Socket.h"
 #include "llbc/comm/Session.h"
+#include "llbc/comm/FileRegion.h"
 #include "llbc/comm/BasePoller.h"
 #include "llbc/comm/PollerType.h"
 #include "llbc/comm/ServiceEvent.h"
@@ -89,12 +90,16 @@ LLBC_Session::LLBC_Session(const LLBC_SessionOpts &sessionOpts)
 , _sockHandle(LLBC_INVALID_SOCKET_HANDLE)
 
 , _fullStack(false)
+, _decodeOffload(false)
 , _svc(nullptr)
 , _poller(nullptr)
 
 , _protoStack(nullptr)
 
 , _pollerType(LLBC_PollerType::End)
+, _lastRecvTime(LLBC_GetMilliSeconds())
+, _lastSendTime(_lastRecvTime)
+, _idleDeadline(0)
 {
 }
 
@@ -122,7 +127,10 @@ void LLBC_Session::SetService(LLBC_Service *svc)
     _svc = svc;
 
     // Create protocol stack.
-    if ((_fullStack = svc->IsFullStack()))
+    // Note: Decode offload session use full stack to decode packets, but packets encoding still in service.
+    _fullStack = svc->IsFullStack();
+    _decodeOffload = !_fullStack && svc->IsDecodeOffload();
+    if (_fullStack || _decodeOffload)
         _protoStack = _svc->CreateFullStack(_id, _acceptId);
     else
         _protoStack = _svc->CreatePackStack(_id, _acceptId);
@@ -165,7 +173,8 @@ int LLBC_Session::Send(LLBC_Packet *packet)
 int LLBC_Session::Send(LLBC_MessageBlock *block)
 {
     // Check session send buffer size limit.
-    size_t sessionSndBufUsed = _socket->GetWillSendBuffer().GetSize();
+    size_t sessionSndBufUsed = _socket->GetWillSendBuffer().GetSize() +
+                               _socket->GetWillSendDatagramsSize();
     #if LLBC_TARGET_PLATFORM_WIN32
     if (_pollerType == LLBC_PollerType::IocpPoller)
         sessionSndBufUsed += _socket->GetIocpSendingDataSize();
@@ -187,6 +196,72 @@ int LLBC_Session::Send(LLBC_MessageBlock *block)
     return LLBC_OK;
 }
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+int LLBC_Session::SendFile(LLBC_FileRegion *fileRegion)
+{
+    LLBC_Packet *header = fileRegion->header;
+    const int fd = fileRegion->fd;
+    sint64 offset = fileRegion->offset;
+    size_t remain = fileRegion->length;
+    delete fileRegion;
+
+    // Protocol stack has no transforming layers, send header packet, the file region will be sent by sendfile().
+    bool removeSession = false;
+    LLBC_MessageBlock *block;
+    if (_protoStack->SendFileHeader(header, remain, block, removeSession) == LLBC_OK)
+    {
+        if (block && Send(block) != LLBC_OK)
+        {
+            close(fd);
+            return LLBC_FAILED;
+        }
+
+        return _socket->AsyncSendFile(fd, offset, remain);
+    }
+    else if (LLBC_GetLastError() != LLBC_ERROR_NOT_SUPPORT)
+    {
+        close(fd);
+        return removeSession ? LLBC_FAILED : LLBC_OK;
+    }
+
+    // Otherwise, read file region to header packet payload in chunks, and send it through protocol stack.
+    char buf[16 * 1024];
+    while (remain > 0)
+    {
+        ssize_t readLen;
+        while ((readLen = pread(fd, buf, MIN(remain, sizeof(buf)), static_cast<off_t>(offset))) < 0 && errno == EINTR);
+        if (readLen <= 0)
+        {
+            close(fd);
+            LLBC_Recycle(header);
+            LLBC_SetLastError(readLen == 0 ? LLBC_ERROR_END : LLBC_ERROR_CLIB);
+
+            return LLBC_FAILED;
+        }
+
+        header->Write(buf, readLen);
+        offset += readLen;
+        remain -= readLen;
+    }
+
+    close(fd);
+
+    return Send(header);
+}
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+int LLBC_Session::SendHeartbeat()
+{
+    LLBC_Packet *packet = _svc->GetPacketObjectPool().GetObject();
+    packet->SetHeader(_id, 0, 0);
+    packet->SetFlags(LLBC_CFG_COMM_HEARTBEAT_PACKET_FLAG);
+
+    // Mark as sent at once, avoid send heartbeat every tick when socket not writable.
+    _lastSendTime = LLBC_GetMilliSeconds();
+
+    return Send(packet);
+}
+
 #if LLBC_TARGET_PLATFORM_WIN32
 void LLBC_Session::OnSend(LLBC_POverlapped ol)
 {
@@ -245,6 +320,14 @@ void LLBC_Session::OnSent(size_t len)
 {
     // TODO: For support sampler, do stuff here.
     // ... ...
+
+    _lastSendTime = LLBC_GetMilliSeconds();
+    _poller->AddTrafficBytes(len);
+}
+
+void LLBC_Session::OnRecvBudgetExhausted()
+{
+    _poller->OnRecvBudgetExhausted(this);
 }
 
 bool LLBC_Session::OnRecved(LLBC_MessageBlock *block, bool &sessionRemoved)
@@ -254,8 +337,11 @@ bool LLBC_Session::OnRecved(LLBC_MessageBlock *block, bool &sessionRemoved)
 
     removeSession = false;
 
+    _lastRecvTime = LLBC_GetMilliSeconds();
+    _poller->AddTrafficBytes(block->GetReadableSize());
+
     _recvedPackets.clear();
-    if (_fullStack)
+    if (_fullStack || _decodeOffload)
         recvRet = _protoStack->Recv(block, _recvedPackets, removeSession);
     else
         recvRet = _protoStack->RecvRaw(block, _recvedPackets, removeSession);
@@ -272,9 +358,14 @@ bool LLBC_Session::OnRecved(LLBC_MessageBlock *block, bool &sessionRemoved)
     for (size_t i = 0; i < _recvedPackets.size(); ++i)
     {
         packet = _recvedPackets[i];
+        if (UNLIKELY(packet->HasFlags(LLBC_CFG_COMM_HEARTBEAT_PACKET_FLAG)))
+        {
+            // Heartbeat packet only use to refresh recv time, consume it here.
+            LLBC_Recycle(packet);
+            continue;
+        }
+
         packet->SetSessionId(_id);
-        packet->SetLocalAddr(_socket->GetLocalAddress());
-        packet->SetPeerAddr(_socket->GetPeerAddress());
 
         _svc->Push(LLBC_SvcEvUtil::BuildDataArrivalEv(packet));
     }
@@ -284,7 +375,7 @@ bool LLBC_Session::OnRecved(LLBC_MessageBlock *block, bool &sessionRemoved)
 
 void LLBC_Session::CtrlProtocolStack(int cmd, const LLBC_Variant &ctrlData, bool &removeSession)
 {
-    if (_fullStack)
+    if (_fullStack || _decodeOffload)
         (void)_protoStack->CtrlStack(cmd, ctrlData, removeSession);
     else
         (void)_protoStack->CtrlStackRaw(cmd, ctrlData, removeSession);
@@ -56,7 +56,7 @@ __LLBC_NS_BEGIN
 char LLBC_Socket::_acceptExBuf[(sizeof(LLBC_SockAddr_IN) + 16) * 2] = {0};
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
-LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle)
+LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle, bool datagram)
 : _handle(handle)
 
 , _session(nullptr)
@@ -69,6 +69,19 @@ LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle)
 , _willSend()
 , _maxPacketSize(LLBC_CFG_COMM_DFT_MAX_PACKET_SIZE)
 
+, _datagram(datagram)
+, _sharedHandle(false)
+, _willSendDatagrams()
+, _willSendDatagramsSize(0)
+, _datagramRecvArena(nullptr)
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+, _willSendAppended(0)
+, _willSendRemoved(0)
+, _willSendFiles()
+, _willSendFilesSize(0)
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
 #if LLBC_TARGET_PLATFORM_WIN32
 , _nonBlocking(false)
 , _olGroup()
@@ -81,7 +94,7 @@ LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle)
 #endif // LLBC_CFG_COMM_SESSION_RECV_BUF_USE_OBJ_POOL
 {
     if (_handle == LLBC_INVALID_SOCKET_HANDLE)
-        _handle = LLBC_CreateTcpSocket();
+        _handle = _datagram ? LLBC_CreateUdpSocket() : LLBC_CreateTcpSocket();
 
 #if LLBC_TARGET_PLATFORM_WIN32
     _olGroup.SetDeleteDataProc(&LLBC_INL_NS __OnOverlappedDelHook);
@@ -91,6 +104,15 @@ LLBC_Socket::LLBC_Socket(LLBC_SocketHandle handle)
 LLBC_Socket::~LLBC_Socket()
 {
     Close();
+
+    for (size_t i = 0; i < _willSendDatagrams.size(); ++i)
+        LLBC_Recycle(_willSendDatagrams[i]);
+    LLBC_XFree(_datagramRecvArena);
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    for (size_t i = 0; i < _willSendFiles.size(); ++i)
+        close(_willSendFiles[i].fd);
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
 void LLBC_Socket::SetSession(LLBC_Session *session)
@@ -141,7 +163,7 @@ int LLBC_Socket::Close()
         LLBC_SetLastError(LLBC_ERROR_NOT_OPEN);
         return LLBC_FAILED;
     }
-    else if (LLBC_CloseSocket(_handle) != LLBC_OK)
+    else if (!_sharedHandle && LLBC_CloseSocket(_handle) != LLBC_OK)
     {
         return LLBC_FAILED;
     }
@@ -155,6 +177,16 @@ bool LLBC_Socket::IsClosed() const
     return _handle == LLBC_INVALID_SOCKET_HANDLE;
 }
 
+bool LLBC_Socket::IsDatagram() const
+{
+    return _datagram;
+}
+
+bool LLBC_Socket::IsSharedHandle() const
+{
+    return _sharedHandle;
+}
+
 LLBC_Socket::operator bool () const
 {
     return !IsClosed();
@@ -199,6 +231,20 @@ int LLBC_Socket::SetNoDelay(bool noDelay)
                      len);
 }
 
+int LLBC_Socket::SetBusyPoll(int busyPoll)
+{
+#if LLBC_TARGET_PLATFORM_LINUX && defined(SO_BUSY_POLL)
+    LLBC_SocketLen len = sizeof(busyPoll);
+    return SetOption(SOL_SOCKET,
+                     SO_BUSY_POLL,
+                     reinterpret_cast<void *>(&busyPoll),
+                     len);
+#else // Non-Linux or SO_BUSY_POLL not supported
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif // LLBC_TARGET_PLATFORM_LINUX && defined(SO_BUSY_POLL)
+}
+
 bool LLBC_Socket::IsNonBlocking() const
 {
 #if LLBC_TARGET_PLATFORM_NON_WIN32
@@ -306,6 +352,14 @@ int LLBC_Socket::BindTo(const LLBC_SockAddr_IN &addr)
 
 int LLBC_Socket::Listen(int backlog)
 {
+    // Datagram socket no listen concept, only mark it as listen socket, the peers will be
+    // accepted when first datagram arrived(see AcceptDatagramPeer()).
+    if (_datagram)
+    {
+        _listenSocket = true;
+        return LLBC_OK;
+    }
+
     if (LLBC_ListenForConnection(_handle, backlog) != LLBC_OK)
         return LLBC_FAILED;
 
@@ -346,6 +400,24 @@ int LLBC_Socket::AcceptEx(LLBC_SocketHandle listenSock,
 }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+LLBC_Socket *LLBC_Socket::AcceptDatagramPeer(const LLBC_SockAddr_IN &peerAddr)
+{
+    if (UNLIKELY(!_datagram || !_listenSocket))
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_ALLOW);
+        return nullptr;
+    }
+
+    LLBC_Socket *newSocket = new LLBC_Socket(_handle, true);
+    newSocket->_sharedHandle = true;
+    newSocket->_pollerType = _pollerType;
+    newSocket->_peerAddr = peerAddr;
+    newSocket->_localAddr = _localAddr;
+    newSocket->_maxPacketSize = _maxPacketSize;
+
+    return newSocket;
+}
+
 int LLBC_Socket::Connect(const LLBC_SockAddr_IN &addr)
 {
     if (LLBC_ConnectToPeer(_handle, addr) != LLBC_OK)
@@ -392,13 +464,35 @@ int LLBC_Socket::AsyncSend(const char *buf, int len)
 
 int LLBC_Socket::AsyncSend(LLBC_MessageBlock *block)
 {
+    // Datagram socket must keep the block boundaries, one block is one datagram.
+    if (_datagram)
+    {
+        if (UNLIKELY(block->GetReadableSize() == 0))
+        {
+            LLBC_Recycle(block);
+            return LLBC_OK;
+        }
+
+        _willSendDatagramsSize += block->GetReadableSize();
+        _willSendDatagrams.push_back(block);
+
+        return LLBC_OK;
+    }
+
     // Append to msg buffer.
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    const size_t blockSize = block->GetReadableSize();
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
     if (UNLIKELY(_willSend.Append(block) != LLBC_OK))
     {
         LLBC_XRecycle(block);
         return LLBC_FAILED;
     }
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    _willSendAppended += blockSize;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
 #if LLBC_TARGET_PLATFORM_WIN32
     if (_pollerType != _PollerType::IocpPoller)
         return LLBC_OK;
@@ -449,9 +543,47 @@ int LLBC_Socket::AsyncSend(LLBC_MessageBlock *block)
     return LLBC_OK;
 }
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+int LLBC_Socket::AsyncSendFile(int fd, sint64 offset, size_t length)
+{
+    if (UNLIKELY(_datagram))
+    {
+        close(fd);
+        LLBC_SetLastError(LLBC_ERROR_NOT_SUPPORT);
+
+        return LLBC_FAILED;
+    }
+
+    if (UNLIKELY(length == 0))
+    {
+        close(fd);
+        return LLBC_OK;
+    }
+
+    _WillSendFile file;
+    file.pos = _willSendAppended;
+    file.fd = fd;
+    file.offset = offset;
+    file.remain = length;
+    _willSendFiles.push_back(file);
+    _willSendFilesSize += length;
+
+    return LLBC_OK;
+}
+
+size_t LLBC_Socket::GetWillSendFilesSize() const
+{
+    return _willSendFilesSize;
+}
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
 bool LLBC_Socket::IsExistNoSendData() const
 {
-    return !!_willSend.FirstBlock();
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    return !!_willSend.FirstBlock() || !_willSendDatagrams.empty() || !_willSendFiles.empty();
+#else
+    return !!_willSend.FirstBlock() || !_willSendDatagrams.empty();
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
 const LLBC_MessageBuffer &LLBC_Socket::GetWillSendBuffer() const
@@ -464,6 +596,76 @@ int LLBC_Socket::Recv(char *buf, int len)
     return LLBC_Recv(_handle, buf, len, 0);
 }
 
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+int LLBC_Socket::RecvDatagrams(LLBC_MessageBlock **blocks, LLBC_SockAddr_IN *peerAddrs, int count)
+{
+    if (UNLIKELY(count <= 0))
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // Lazy create the recv arena, only the handle owner datagram socket need it.
+    const size_t dgramSize = LLBC_CFG_COMM_UDP_MAX_DATAGRAM_SIZE;
+    if (!_datagramRecvArena)
+        _datagramRecvArena = LLBC_Malloc(char, dgramSize * LLBC_CFG_COMM_UDP_BATCH_SIZE);
+
+    count = MIN(count, LLBC_CFG_COMM_UDP_BATCH_SIZE);
+
+    struct iovec iovs[LLBC_CFG_COMM_UDP_BATCH_SIZE];
+    struct mmsghdr msgs[LLBC_CFG_COMM_UDP_BATCH_SIZE];
+    struct sockaddr_in addrs[LLBC_CFG_COMM_UDP_BATCH_SIZE];
+    for (int i = 0; i < count; ++i)
+    {
+        iovs[i].iov_base = _datagramRecvArena + i * dgramSize;
+        iovs[i].iov_len = dgramSize;
+
+        memset(&msgs[i], 0, sizeof(struct mmsghdr));
+        msgs[i].msg_hdr.msg_name = &addrs[i];
+        msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        msgs[i].msg_hdr.msg_iov = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    int ret;
+    while ((ret = recvmmsg(_handle, msgs, count, MSG_DONTWAIT, nullptr)) < 0 && errno == EINTR);
+    if (ret < 0)
+    {
+        if (errno == EWOULDBLOCK)
+            LLBC_SetLastError(LLBC_ERROR_WBLOCK);
+        else if (errno == EAGAIN)
+            LLBC_SetLastError(LLBC_ERROR_AGAIN);
+        else
+            LLBC_SetLastError(LLBC_ERROR_CLIB);
+
+        return LLBC_FAILED;
+    }
+
+    // Copy datagrams out from arena, truncated or empty datagram will be dropped.
+    for (int i = 0; i < ret; ++i)
+    {
+        const mmsghdr &msg = msgs[i];
+        if (UNLIKELY(msg.msg_len == 0 || (msg.msg_hdr.msg_flags & MSG_TRUNC)))
+        {
+            blocks[i] = nullptr;
+            continue;
+        }
+
+        blocks[i] = new LLBC_MessageBlock(msg.msg_len);
+        blocks[i]->Write(iovs[i].iov_base, msg.msg_len);
+        if (peerAddrs)
+            peerAddrs[i].FromOSDataType(&addrs[i]);
+    }
+
+    return ret;
+}
+#endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+
+size_t LLBC_Socket::GetWillSendDatagramsSize() const
+{
+    return _willSendDatagramsSize;
+}
+
 int LLBC_Socket::UpdateLocalAddress()
 {
     return LLBC_GetSocketName(_handle, _localAddr);
@@ -539,7 +741,56 @@ void LLBC_Socket::OnSend()
     }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
-    int len = 0, totalLen = 0;
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    if (_datagram)
+    {
+        OnSendDatagrams();
+        return;
+    }
+#endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+
+    int len = 0;
+    size_t totalLen = 0;
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Send will send data until reach the first will send file region position, then send file region.
+    while (true)
+    {
+        const LLBC_MessageBlock *firstBlock = _willSend.FirstBlock();
+        while (firstBlock)
+        {
+            size_t sendLen = firstBlock->GetReadableSize();
+            if (!_willSendFiles.empty())
+            {
+                const uint64 fileBefore = _willSendFiles.front().pos - _willSendRemoved;
+                if (fileBefore == 0)
+                    break;
+
+                sendLen = static_cast<size_t>(MIN(static_cast<uint64>(sendLen), fileBefore));
+            }
+
+            if ((len = LLBC_Send(_handle, 
+                                 firstBlock->GetDataStartWithReadPos(), 
+                                 static_cast<int>(sendLen), 0)) < 0)
+                break;
+
+            totalLen += len;
+            _willSend.Remove(len);
+            _willSendRemoved += len;
+            firstBlock = _willSend.FirstBlock();
+        }
+
+        if (len < 0 ||
+            _willSendFiles.empty() ||
+            _willSendFiles.front().pos != _willSendRemoved)
+            break;
+
+        if (SendWillSendFile(totalLen) != LLBC_OK)
+        {
+            len = -1;
+            break;
+        }
+    }
+#else // Win32
     const LLBC_MessageBlock *firstBlock = _willSend.FirstBlock();
     while (firstBlock)
     {
@@ -552,6 +803,7 @@ void LLBC_Socket::OnSend()
         _willSend.Remove(len);
         firstBlock = _willSend.FirstBlock();
     }
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
 
     if (len < 0 && LLBC_GetLastError() != LLBC_ERROR_WBLOCK
 #if LLBC_TARGET_PLATFORM_NON_WIN32
@@ -622,6 +874,28 @@ void LLBC_Socket::OnSend()
 #endif // LLBC_TARGET_PLATFORM_WIN32
 }
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+int LLBC_Socket::SendWillSendFile(size_t &totalLen)
+{
+    _WillSendFile &file = _willSendFiles.front();
+    while (file.remain > 0)
+    {
+        const int len = LLBC_SendFile(_handle, file.fd, file.offset, file.remain);
+        if (len < 0)
+            return LLBC_FAILED;
+
+        totalLen += len;
+        file.remain -= len;
+        _willSendFilesSize -= len;
+    }
+
+    close(file.fd);
+    _willSendFiles.pop_front();
+
+    return LLBC_OK;
+}
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
 #if LLBC_TARGET_PLATFORM_WIN32
 void LLBC_Socket::OnRecv(LLBC_POverlapped ol)
 #else
@@ -635,8 +909,18 @@ void LLBC_Socket::OnRecv()
     }
 #endif // LLBC_TARGET_PLATFORM_WIN32
 
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    if (_datagram)
+    {
+        OnRecvDatagrams();
+        return;
+    }
+#endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+
     int len = 0;
     bool recvFlag = false;
+    bool budgetExhausted = false;
+    const size_t recvBudget = _session->GetSessionOpts().GetRecvBudget();
     #if LLBC_CFG_COMM_SESSION_RECV_BUF_USE_OBJ_POOL
     LLBC_MessageBlock *block = _msgBlockPoolInst->GetObject();
     #else
@@ -649,6 +933,14 @@ void LLBC_Socket::OnRecv()
     {
         recvFlag = true;
         block->ShiftWritePos(len);
+
+        // Stop read when recv budget exhausted, let other sessions have chance to read.
+        if (recvBudget != 0 && block->GetReadableSize() >= recvBudget)
+        {
+            budgetExhausted = true;
+            break;
+        }
+
         if (block->GetWritableSize() == 0)
         {
             #if LLBC_TARGET_PLATFORM_WIN32
@@ -716,6 +1008,10 @@ void LLBC_Socket::OnRecv()
         LLBC_Recycle(block);
     }
 
+    // Socket maybe still has data to read, notify poller.
+    if (budgetExhausted)
+        _session->OnRecvBudgetExhausted();
+
     // Process errors.
     if (len < 0)
     {
@@ -774,6 +1070,110 @@ void LLBC_Socket::OnClose()
     Close();
 }
 
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+void LLBC_Socket::OnSendDatagrams()
+{
+    struct sockaddr_in peerAddr;
+    if (_sharedHandle)
+        peerAddr = _peerAddr.ToOSDataType();
+
+    struct iovec iovs[LLBC_CFG_COMM_UDP_BATCH_SIZE];
+    struct mmsghdr msgs[LLBC_CFG_COMM_UDP_BATCH_SIZE];
+
+    size_t totalLen = 0;
+    while (!_willSendDatagrams.empty())
+    {
+        // Build batch, shared handle(peer) socket must specific the peer address.
+        const int count = static_cast<int>(
+            MIN(_willSendDatagrams.size(), static_cast<size_t>(LLBC_CFG_COMM_UDP_BATCH_SIZE)));
+        for (int i = 0; i < count; ++i)
+        {
+            LLBC_MessageBlock *block = _willSendDatagrams[i];
+            iovs[i].iov_base = block->GetDataStartWithReadPos();
+            iovs[i].iov_len = block->GetReadableSize();
+
+            memset(&msgs[i], 0, sizeof(struct mmsghdr));
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+            if (_sharedHandle)
+            {
+                msgs[i].msg_hdr.msg_name = &peerAddr;
+                msgs[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+            }
+        }
+
+        int sent;
+        while ((sent = sendmmsg(_handle, msgs, count, MSG_DONTWAIT)) < 0 && errno == EINTR);
+        if (sent < 0)
+        {
+            // Would block, wait next time to send.
+            if (errno == EWOULDBLOCK || errno == EAGAIN)
+                break;
+
+            LLBC_SetLastError(LLBC_ERROR_CLIB);
+            if (totalLen > 0)
+                _session->OnSent(totalLen);
+
+            _session->OnClose();
+            return;
+        }
+
+        for (int i = 0; i < sent; ++i)
+        {
+            LLBC_MessageBlock *block = _willSendDatagrams.front();
+            totalLen += block->GetReadableSize();
+            _willSendDatagramsSize -= block->GetReadableSize();
+
+            LLBC_Recycle(block);
+            _willSendDatagrams.pop_front();
+        }
+
+        if (sent < count)
+            break;
+    }
+
+    if (totalLen > 0)
+        _session->OnSent(totalLen);
+}
+
+void LLBC_Socket::OnRecvDatagrams()
+{
+    LLBC_MessageBlock *blocks[LLBC_CFG_COMM_UDP_BATCH_SIZE];
+    for (; ;)
+    {
+        const int count = RecvDatagrams(blocks, nullptr, LLBC_CFG_COMM_UDP_BATCH_SIZE);
+        if (count < 0)
+        {
+            const int errNo = LLBC_GetLastError();
+            if (errNo == LLBC_ERROR_WBLOCK || errNo == LLBC_ERROR_AGAIN)
+                return;
+
+            _session->OnClose(new LLBC_SessionCloseInfo(errNo, LLBC_GetSubErrorNo()));
+            return;
+        }
+
+        // One datagram one OnRecved() call, malformed datagram only drop itself.
+        for (int i = 0; i < count; ++i)
+        {
+            if (UNLIKELY(!blocks[i]))
+                continue;
+
+            bool sessionRemoved;
+            if (!_session->OnRecved(blocks[i], sessionRemoved) && sessionRemoved)
+            {
+                for (++i; i < count; ++i)
+                    LLBC_XRecycle(blocks[i]);
+
+                return;
+            }
+        }
+
+        if (count < LLBC_CFG_COMM_UDP_BATCH_SIZE)
+            return;
+    }
+}
+#endif // LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+
 #if LLBC_TARGET_PLATFORM_WIN32
 LLBC_OverlappedGroup &LLBC_Socket::GetOverlappedGroup()
 {
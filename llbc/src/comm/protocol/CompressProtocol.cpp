@@ -52,6 +52,12 @@ int LLBC_CompressProtocol::Recv(void *in, void *&out, bool &removeSession)
     return LLBC_OK;
 }
 
+int LLBC_CompressProtocol::SendFileHeader(void *in, size_t fileLen, void *&out, bool &removeSession)
+{
+    out = in;
+    return LLBC_OK;
+}
+
 int LLBC_CompressProtocol::AddCoder(int opcode, LLBC_CoderFactory *coder)
 {
     LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
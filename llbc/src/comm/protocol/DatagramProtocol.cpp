@@ -0,0 +1,102 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "llbc/common/Export.h"
+
+#include "llbc/comm/Session.h"
+#include "llbc/comm/Socket.h"
+
+#include "llbc/comm/protocol/ProtoReportLevel.h"
+#include "llbc/comm/protocol/DatagramProtocol.h"
+#include "llbc/comm/protocol/ProtocolStack.h"
+
+__LLBC_INTERNAL_NS_BEGIN
+
+static const size_t __llbc_headerLen = 28;
+
+__LLBC_INTERNAL_NS_END
+
+__LLBC_NS_BEGIN
+
+LLBC_DatagramProtocol::LLBC_DatagramProtocol()
+: _headerAssembler(LLBC_INL_NS __llbc_headerLen)
+{
+}
+
+LLBC_DatagramProtocol::~LLBC_DatagramProtocol()
+{
+}
+
+int LLBC_DatagramProtocol::Recv(void *in, void *&out, bool &removeSession)
+{
+    out = nullptr;
+    removeSession = false;
+    LLBC_MessageBlock *block = reinterpret_cast<LLBC_MessageBlock *>(in);
+
+    LLBC_Defer(LLBC_Recycle(block));
+
+    // Assemble header, datagram never split, so header must assemble done at once.
+    size_t headerUsed;
+    const size_t datagramLen = block->GetReadableSize();
+    const char *datagram = reinterpret_cast<const char *>(block->GetDataStartWithReadPos());
+    if (!_headerAssembler.Assemble(datagram, datagramLen, headerUsed))
+    {
+        _headerAssembler.Reset();
+        _stack->Report(this,
+                       LLBC_ProtoReportLevel::Warn,
+                       LLBC_String().format("datagram too short, len: %lu", datagramLen));
+
+        LLBC_SetLastError(LLBC_ERROR_PACK);
+        return LLBC_FAILED;
+    }
+
+    LLBC_Packet *packet = _pktPoolInst->GetObject();
+    _headerAssembler.SetToPacket(*packet);
+    _headerAssembler.Reset();
+
+    // Check length, packet length must equal to datagram length.
+    const size_t packetLen = packet->GetLength();
+    if (packetLen != datagramLen ||
+        packetLen > _session->GetSocket()->GetMaxPacketSize())
+    {
+        _stack->Report(this,
+                       LLBC_ProtoReportLevel::Warn,
+                       LLBC_String().format("invalid datagram packet len: %lu, datagram len: %lu",
+                                            packetLen, datagramLen));
+
+        LLBC_Recycle(packet);
+        LLBC_SetLastError(LLBC_ERROR_PACK);
+        return LLBC_FAILED;
+    }
+
+    packet->SetSessionId(_sessionId);
+    packet->SetAcceptSessionId(_acceptSessionId);
+    packet->Write(datagram + headerUsed, datagramLen - headerUsed);
+
+    LLBC_MessageBlock *packetsBlock = new LLBC_MessageBlock(sizeof(LLBC_Packet *));
+    packetsBlock->Write(&packet, sizeof(LLBC_Packet *));
+    out = packetsBlock;
+
+    return LLBC_OK;
+}
+
+__LLBC_NS_END
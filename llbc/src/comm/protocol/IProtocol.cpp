@@ -70,6 +70,12 @@ const LLBC_IProtocol::Coders *LLBC_IProtocol::GetCoders() const
     return _coders;
 }
 
+int LLBC_IProtocol::SendFileHeader(void *in, size_t fileLen, void *&out, bool &removeSession)
+{
+    LLBC_SetLastError(LLBC_ERROR_NOT_SUPPORT);
+    return LLBC_FAILED;
+}
+
 bool LLBC_IProtocol::Ctrl(int cmd, const LLBC_Variant &ctrlData, bool &removeSession)
 {
     return true;
@@ -85,18 +85,52 @@ int LLBC_PacketProtocol::Send(void *in, void *&out, bool &removeSession)
 {
     LLBC_Packet *packet = reinterpret_cast<LLBC_Packet *>(in);
 
-    uint32 length = static_cast<uint32>(
-        LLBC_INL_NS __llbc_headerLen + packet->GetPayloadLength());
-
     // Create block and write header in.
-    LLBC_MessageBlock *block = new LLBC_MessageBlock(length);
+    LLBC_MessageBlock *block = new LLBC_MessageBlock(LLBC_INL_NS __llbc_headerLen + packet->GetPayloadLength());
+    WriteHeader(*packet, packet->GetPayloadLength(), *block);
+
+    // Write packet data and delete packet.
+    block->Write(packet->GetPayload(), packet->GetPayloadLength());
+    LLBC_Recycle(packet);
+
+    out = block;
+
+    return LLBC_OK;
+}
+
+int LLBC_PacketProtocol::SendFileHeader(void *in, size_t fileLen, void *&out, bool &removeSession)
+{
+    LLBC_Packet *packet = reinterpret_cast<LLBC_Packet *>(in);
+
+    // Header length field is uint32, check file region length.
+    if (UNLIKELY(fileLen > static_cast<size_t>(0xffffffffu) - LLBC_INL_NS __llbc_headerLen))
+    {
+        LLBC_Recycle(packet);
+
+        removeSession = false;
+        LLBC_SetLastError(LLBC_ERROR_LIMIT);
+        return LLBC_FAILED;
+    }
+
+    // Only write header, file region will be sent directly after header.
+    LLBC_MessageBlock *block = new LLBC_MessageBlock(LLBC_INL_NS __llbc_headerLen);
+    WriteHeader(*packet, fileLen, *block);
+    LLBC_Recycle(packet);
+
+    out = block;
 
-    sint32 opcode = packet->GetOpcode();
-    uint16 status = static_cast<uint16>(packet->GetStatus());
-    int senderServiceId = packet->GetSenderServiceId();
-    int recverServiceId = packet->GetRecverServiceId();
-    uint16 flags = static_cast<uint16>(packet->GetFlags());
-    sint64 extData1 = packet->GetExtData1();
+    return LLBC_OK;
+}
+
+void LLBC_PacketProtocol::WriteHeader(const LLBC_Packet &packet, size_t payloadLen, LLBC_MessageBlock &block)
+{
+    uint32 length = static_cast<uint32>(LLBC_INL_NS __llbc_headerLen + payloadLen);
+    sint32 opcode = packet.GetOpcode();
+    uint16 status = static_cast<uint16>(packet.GetStatus());
+    int senderServiceId = packet.GetSenderServiceId();
+    int recverServiceId = packet.GetRecverServiceId();
+    uint16 flags = static_cast<uint16>(packet.GetFlags());
+    sint64 extData1 = packet.GetExtData1();
 
 #if LLBC_CFG_COMM_ORDER_IS_NET_ORDER
     LLBC_Host2Net(length);
@@ -108,21 +142,13 @@ int LLBC_PacketProtocol::Send(void *in, void *&out, bool &removeSession)
     LLBC_Host2Net(extData1);
 #endif // Net order.
 
-    block->Write(&length, sizeof(length));
-    block->Write(&opcode, sizeof(opcode));
-    block->Write(&status, sizeof(status));
-    block->Write(&senderServiceId, sizeof(senderServiceId));
-    block->Write(&recverServiceId, sizeof(recverServiceId));
-    block->Write(&flags, sizeof(flags));
-    block->Write(&extData1, sizeof(extData1));
-
-    // Write packet data and delete packet.
-    block->Write(packet->GetPayload(), packet->GetPayloadLength());
-    LLBC_Recycle(packet);
-
-    out = block;
-
-    return LLBC_OK;
+    block.Write(&length, sizeof(length));
+    block.Write(&opcode, sizeof(opcode));
+    block.Write(&status, sizeof(status));
+    block.Write(&senderServiceId, sizeof(senderServiceId));
+    block.Write(&recverServiceId, sizeof(recverServiceId));
+    block.Write(&flags, sizeof(flags));
+    block.Write(&extData1, sizeof(extData1));
 }
 
 int LLBC_PacketProtocol::Recv(void *in, void *&out, bool &removeSession)
@@ -210,6 +210,23 @@ int LLBC_ProtocolStack::Send(LLBC_Packet *packet, LLBC_MessageBlock *&block, boo
     return SendRaw(packet, block, removeSession);
 }
 
+int LLBC_ProtocolStack::SendFileHeader(LLBC_Packet *packet, size_t fileLen, LLBC_MessageBlock *&block, bool &removeSession)
+{
+    void *in, *out = packet;
+    for (int layer = _Layer::CompressLayer; layer >= _Layer::Begin; --layer)
+    {
+        if (!_protos[layer])
+            continue;
+
+        in = out, out = nullptr;
+        if (_protos[layer]->SendFileHeader(in, fileLen, out, removeSession) != LLBC_OK)
+            return LLBC_FAILED;
+    }
+
+    block = reinterpret_cast<LLBC_MessageBlock *>(out);
+    return LLBC_OK;
+}
+
 int LLBC_ProtocolStack::RecvRaw(LLBC_MessageBlock *block, std::vector<LLBC_Packet *> &packets, bool &removeSession)
 {
     void *in, *out = nullptr;
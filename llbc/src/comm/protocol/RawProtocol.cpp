@@ -44,6 +44,14 @@ int LLBC_RawProtocol::GetLayer() const
     return LLBC_ProtocolLayer::PackLayer;
 }
 
+int LLBC_RawProtocol::SendFileHeader(void *in, size_t fileLen, void *&out, bool &removeSession)
+{
+    LLBC_Recycle(reinterpret_cast<LLBC_Packet *>(in));
+
+    out = nullptr;
+    return LLBC_OK;
+}
+
 int LLBC_RawProtocol::Send(void *in, void *&out, bool &removeSession)
 {
     LLBC_Packet *packet = reinterpret_cast<LLBC_Packet *>(in);
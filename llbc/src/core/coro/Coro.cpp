@@ -0,0 +1,199 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+ #if LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+  // Darwin ucontext routines require _XOPEN_SOURCE defined, and marked as deprecated.
+  #ifndef _XOPEN_SOURCE
+   #define _XOPEN_SOURCE 600
+  #endif
+  #pragma clang diagnostic ignored "-Wdeprecated-declarations"
+ #endif
+ #include <ucontext.h>
+#endif // Non-Win32
+
+#include "llbc/core/coro/CoroStackPool.h"
+#include "llbc/core/coro/Coro.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_Coro::LLBC_Coro(const LLBC_Delegate<void()> &entry, LLBC_CoroStackPool &stackPool)
+: _state(State::Suspended)
+, _entry(entry)
+
+, _stackPool(stackPool)
+, _stack(nullptr)
+
+, _context(nullptr)
+, _callerContext(nullptr)
+{
+}
+
+LLBC_Coro::~LLBC_Coro()
+{
+    // Note: Destroy unfinished coroutine will not unwind coroutine stack.
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    delete reinterpret_cast<ucontext_t *>(_context);
+    delete reinterpret_cast<ucontext_t *>(_callerContext);
+    if (_stack)
+        _stackPool.Release(_stack);
+#else
+    if (_context)
+        ::DeleteFiber(_context);
+#endif
+}
+
+int LLBC_Coro::GetState() const
+{
+    return _state;
+}
+
+bool LLBC_Coro::IsFinished() const
+{
+    return _state == State::Finished;
+}
+
+int LLBC_Coro::Resume()
+{
+    LLBC_SetErrAndReturnIf(_state != State::Suspended, LLBC_ERROR_INVALID, LLBC_FAILED);
+    if (UNLIKELY(!_context && CreateContext() != LLBC_OK))
+        return LLBC_FAILED;
+
+    _state = State::Running;
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (UNLIKELY(swapcontext(reinterpret_cast<ucontext_t *>(_callerContext),
+                             reinterpret_cast<ucontext_t *>(_context)) != 0))
+    {
+        _state = State::Suspended;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+
+        return LLBC_FAILED;
+    }
+#else
+    _callerContext = ::GetCurrentFiber();
+    ::SwitchToFiber(_context);
+#endif
+
+    return LLBC_OK;
+}
+
+int LLBC_Coro::Yield()
+{
+    LLBC_SetErrAndReturnIf(_state != State::Running, LLBC_ERROR_INVALID, LLBC_FAILED);
+
+    _state = State::Suspended;
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    swapcontext(reinterpret_cast<ucontext_t *>(_context),
+                reinterpret_cast<ucontext_t *>(_callerContext));
+#else
+    ::SwitchToFiber(_callerContext);
+#endif
+
+    return LLBC_OK;
+}
+
+int LLBC_Coro::CreateContext()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    _stack = _stackPool.Acquire();
+    if (UNLIKELY(!_stack))
+        return LLBC_FAILED;
+
+    ucontext_t *context = new ucontext_t;
+    if (UNLIKELY(getcontext(context) != 0))
+    {
+        delete context;
+        _stackPool.Release(_stack);
+        _stack = nullptr;
+
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+
+        return LLBC_FAILED;
+    }
+
+    context->uc_stack.ss_sp = _stack;
+    context->uc_stack.ss_size = _stackPool.GetStackSize();
+    context->uc_link = nullptr;
+
+    // makecontext only accept int arguments, split this pointer to two parts.
+    const uint64 coroPtr = static_cast<uint64>(reinterpret_cast<uintptr_t>(this));
+    makecontext(context,
+                reinterpret_cast<void (*)()>(&LLBC_Coro::Trampoline),
+                2,
+                static_cast<uint32>(coroPtr >> 32),
+                static_cast<uint32>(coroPtr & 0xffffffff));
+
+    _context = context;
+    _callerContext = new ucontext_t;
+#else
+    // Fiber could only be scheduled by fiber, convert thread to fiber if need.
+    if (!::IsThreadAFiber() && !::ConvertThreadToFiber(nullptr))
+    {
+        LLBC_SetLastError(LLBC_ERROR_OSAPI);
+        return LLBC_FAILED;
+    }
+
+    _context = ::CreateFiberEx(_stackPool.GetStackSize(),
+                               _stackPool.GetStackSize(),
+                               0,
+                               &LLBC_Coro::Trampoline,
+                               this);
+    if (UNLIKELY(!_context))
+    {
+        LLBC_SetLastError(LLBC_ERROR_OSAPI);
+        return LLBC_FAILED;
+    }
+#endif
+
+    return LLBC_OK;
+}
+
+void LLBC_Coro::RunEntry()
+{
+    _entry();
+
+    // Finished, switch back to caller and never return.
+    _state = State::Finished;
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    setcontext(reinterpret_cast<ucontext_t *>(_callerContext));
+#else
+    ::SwitchToFiber(_callerContext);
+#endif
+}
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+void LLBC_Coro::Trampoline(uint32 coroHigh, uint32 coroLow)
+{
+    const uint64 coroPtr = (static_cast<uint64>(coroHigh) << 32) | coroLow;
+    reinterpret_cast<LLBC_Coro *>(static_cast<uintptr_t>(coroPtr))->RunEntry();
+}
+#else
+void WINAPI LLBC_Coro::Trampoline(LPVOID coro)
+{
+    reinterpret_cast<LLBC_Coro *>(coro)->RunEntry();
+}
+#endif
+
+__LLBC_NS_END
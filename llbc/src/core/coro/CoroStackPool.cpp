@@ -0,0 +1,131 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "llbc/common/Export.h"
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+ #include <sys/mman.h>
+#endif // Non-Win32
+
+#include "llbc/core/coro/CoroStackPool.h"
+
+__LLBC_NS_BEGIN
+
+LLBC_CoroStackPool::LLBC_CoroStackPool(size_t stackSize, size_t maxIdleStacks)
+: _pageSize(0)
+, _stackSize(0)
+, _maxIdleStacks(maxIdleStacks)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    const long pageSize = sysconf(_SC_PAGESIZE);
+    _pageSize = pageSize > 0 ? static_cast<size_t>(pageSize) : 4096;
+#else
+    SYSTEM_INFO sysInfo;
+    ::GetSystemInfo(&sysInfo);
+    _pageSize = sysInfo.dwPageSize;
+#endif
+
+    // Round stack size up to page size.
+    stackSize = MAX(stackSize, _pageSize);
+    _stackSize = (stackSize + _pageSize - 1) / _pageSize * _pageSize;
+}
+
+LLBC_CoroStackPool::~LLBC_CoroStackPool()
+{
+    for (auto &stack : _idleStacks)
+        FreeStack(stack);
+}
+
+size_t LLBC_CoroStackPool::GetStackSize() const
+{
+    return _stackSize;
+}
+
+size_t LLBC_CoroStackPool::GetIdleStackCount() const
+{
+    return _idleStacks.size();
+}
+
+void *LLBC_CoroStackPool::Acquire()
+{
+    if (!_idleStacks.empty())
+    {
+        void *stack = _idleStacks.back();
+        _idleStacks.pop_back();
+
+        return stack;
+    }
+
+    return AllocStack();
+}
+
+void LLBC_CoroStackPool::Release(void *stack)
+{
+    if (UNLIKELY(!stack))
+        return;
+
+    if (_idleStacks.size() < _maxIdleStacks)
+        _idleStacks.push_back(stack);
+    else
+        FreeStack(stack);
+}
+
+void *LLBC_CoroStackPool::AllocStack()
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // Layout: [guard page][stack], guard page is not accessible.
+    void *mem = mmap(nullptr, _pageSize + _stackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANON, -1, 0);
+    if (UNLIKELY(mem == MAP_FAILED))
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return nullptr;
+    }
+
+    if (UNLIKELY(mprotect(mem, _pageSize, PROT_NONE) != 0))
+    {
+        munmap(mem, _pageSize + _stackSize);
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+
+        return nullptr;
+    }
+
+    return reinterpret_cast<char *>(mem) + _pageSize;
+#else
+    void *mem = ::VirtualAlloc(nullptr, _stackSize, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+    if (UNLIKELY(!mem))
+        LLBC_SetLastError(LLBC_ERROR_OSAPI);
+
+    return mem;
+#endif
+}
+
+void LLBC_CoroStackPool::FreeStack(void *stack)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    munmap(reinterpret_cast<char *>(stack) - _pageSize, _pageSize + _stackSize);
+#else
+    ::VirtualFree(stack, 0, MEM_RELEASE);
+#endif
+}
+
+__LLBC_NS_END
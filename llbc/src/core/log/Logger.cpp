@@ -154,7 +154,11 @@ int LLBC_Logger::Initialize(const LLBC_LoggerConfigInfo *config, LLBC_LogRunnabl
         _logRunnable->AddLogger(this);
 
         if (_config->IsIndependentThread())
+        {
+            _logRunnable->SetThreadName(_config->GetThreadName());
+            _logRunnable->SetCPUAffinity(_config->GetCPUAffinity());
             _logRunnable->Activate(1, LLBC_ThreadPriority::BelowNormal);
+        }
     }
 
     return LLBC_OK;
@@ -49,6 +49,8 @@ LLBC_LoggerConfigInfo::LLBC_LoggerConfigInfo()
 , _logLevel(LLBC_LogLevel::End)
 , _asyncMode(false)
 , _independentThread(false)
+, _threadName()
+, _cpuAffinity(0)
 , _flushInterval(0)
 
 , _logToConsole(true)
@@ -111,6 +113,15 @@ int LLBC_LoggerConfigInfo::Initialize(const LLBC_String &loggerName,
     if (_asyncMode)
         _independentThread = __LLBC_GetLogCfg(
             "independentThread", INDEPENDENT_THREAD, IsIndependentThread, AsLooseBool);
+    if (_asyncMode)
+    {
+        // Log thread name & cpu affinity, illegal cpu affinity will be ignored.
+        if (cfg.HasProperty("threadName"))
+            _threadName = cfg.GetValue("threadName").AsStr().strip();
+        if (cfg.HasProperty("cpuAffinity") &&
+            LLBC_ParseCPUMask(cfg.GetValue("cpuAffinity").AsStr().strip().c_str(), _cpuAffinity) != LLBC_OK)
+            _cpuAffinity = 0;
+    }
      _flushInterval = __LLBC_GetLogCfg(
          "flushInterval", LOG_FLUSH_INTERVAL, GetFlushInterval, AsInt32);
 
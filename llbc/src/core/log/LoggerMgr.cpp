@@ -32,6 +32,7 @@
 
 #include "llbc/core/log/LogLevel.h"
 #include "llbc/core/log/Logger.h"
+#include "llbc/core/log/LoggerConfigInfo.h"
 #include "llbc/core/log/LoggerConfigurator.h"
 #include "llbc/core/log/LoggerMgr.h"
 #include "llbc/core/log/LogRunnable.h"
@@ -72,8 +73,24 @@ int LLBC_LoggerMgr::Initialize(const LLBC_String &cfgFile)
 
     // Create shared log runnable.
     if (_configurator->HasSharedAsyncLoggerConfigs())
+    {
         _sharedLogRunnable = new LLBC_LogRunnable;
 
+        // Apply shared log thread name & cpu affinity, first configured shared logger win.
+        const std::map<LLBC_String, LLBC_LoggerConfigInfo *> &configs = _configurator->GetAllConfigInfos();
+        for (auto &cfgItem : configs)
+        {
+            const LLBC_LoggerConfigInfo *cfg = cfgItem.second;
+            if (!cfg->IsAsyncMode() || cfg->IsIndependentThread())
+                continue;
+
+            if (_sharedLogRunnable->GetThreadName().empty() && !cfg->GetThreadName().empty())
+                _sharedLogRunnable->SetThreadName(cfg->GetThreadName());
+            if (_sharedLogRunnable->GetCPUAffinity() == 0 && cfg->GetCPUAffinity() != 0)
+                _sharedLogRunnable->SetCPUAffinity(cfg->GetCPUAffinity());
+        }
+    }
+
     // Config root logger.
     _rootLogger = new LLBC_Logger;
     if (_configurator->Config(_rootLoggerName, _sharedLogRunnable, _rootLogger) != LLBC_OK)
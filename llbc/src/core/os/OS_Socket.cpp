@@ -25,6 +25,11 @@
 #if LLBC_TARGET_PLATFORM_NON_WIN32
  #include <fcntl.h>
 #endif // Non-Win32
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+ #include <sys/sendfile.h>
+#elif LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+ #include <sys/uio.h>
+#endif
 
 #include "llbc/core/os/OS_Socket.h"
 
@@ -204,6 +209,27 @@ LLBC_SocketHandle LLBC_CreateTcpSocketEx()
 #endif // LLBC_TARGET_PLATFORM_WIN32
 }
 
+LLBC_SocketHandle LLBC_CreateUdpSocket()
+{
+    LLBC_SocketHandle handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    if (handle == -1)
+    {
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+    }
+
+    return handle;
+#else // LLBC_TARGET_PLATFORM_WIN32
+    if (handle == INVALID_SOCKET)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NETAPI);
+    }
+
+    return handle;
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+}
+
 int LLBC_ShutdownSocketInput(LLBC_SocketHandle handle)
 {
     if (UNLIKELY(handle == LLBC_INVALID_SOCKET_HANDLE))
@@ -285,6 +311,84 @@ int LLBC_ShutdownSocketInputOutput(LLBC_SocketHandle handle)
 #endif // LLBC_TARGET_PLATFORM_NON_WIN32
 }
 
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+int LLBC_SendFile(LLBC_SocketHandle handle, int fd, sint64 &offset, size_t count)
+{
+    // Limit one call send bytes, keep return value in int range.
+    count = MIN(count, static_cast<size_t>(0x7ffff000));
+    if (UNLIKELY(count == 0))
+        return 0;
+
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    off_t off = static_cast<off_t>(offset);
+    ssize_t ret;
+    while ((ret = sendfile(handle, fd, &off, count)) < 0 && errno == EINTR);
+    if (ret > 0)
+    {
+        offset = off;
+        return static_cast<int>(ret);
+    }
+    else if (ret == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_END);
+        return LLBC_FAILED;
+    }
+
+    // File not support sendfile(eg: not mmap-able), fallback to read & send.
+    if (errno != EINVAL && errno != ENOSYS)
+    {
+        LLBC_SetLastError(errno == EWOULDBLOCK ? LLBC_ERROR_WBLOCK :
+                              (errno == EAGAIN ? LLBC_ERROR_AGAIN : LLBC_ERROR_CLIB));
+        return LLBC_FAILED;
+    }
+#elif LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+    // The len is in/out param, it contains the number bytes sent even if error occurred(eg: EAGAIN).
+    int ret;
+    off_t len;
+    do
+    {
+        len = static_cast<off_t>(count);
+        ret = sendfile(fd, handle, static_cast<off_t>(offset), &len, nullptr, 0);
+    } while (ret < 0 && errno == EINTR && len == 0);
+
+    if (len > 0)
+    {
+        offset += len;
+        return static_cast<int>(len);
+    }
+    else if (ret == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_END);
+        return LLBC_FAILED;
+    }
+
+    // File/Socket not support sendfile, fallback to read & send.
+    if (errno != ENOTSUP && errno != EINVAL && errno != ENOTSOCK)
+    {
+        LLBC_SetLastError(errno == EWOULDBLOCK ? LLBC_ERROR_WBLOCK :
+                              (errno == EAGAIN ? LLBC_ERROR_AGAIN : LLBC_ERROR_CLIB));
+        return LLBC_FAILED;
+    }
+#endif
+
+    // Read one chunk from file region and send.
+    char buf[16 * 1024];
+    ssize_t readLen;
+    while ((readLen = pread(fd, buf, MIN(count, sizeof(buf)), static_cast<off_t>(offset))) < 0 && errno == EINTR);
+    if (readLen <= 0)
+    {
+        LLBC_SetLastError(readLen == 0 ? LLBC_ERROR_END : LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    const int sent = LLBC_Send(handle, buf, static_cast<int>(readLen), 0);
+    if (sent > 0)
+        offset += sent;
+
+    return sent;
+}
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
 int LLBC_Send(LLBC_SocketHandle handle, const void *buf, int len, int flags)
 {
 #if LLBC_TARGET_PLATFORM_NON_IPHONE
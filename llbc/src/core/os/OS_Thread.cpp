@@ -503,6 +503,183 @@ int LLBC_SetThreadPriority(LLBC_NativeThreadHandle handle, int priority)
 #endif
 }
 
+int LLBC_SetThreadName(LLBC_NativeThreadHandle handle, const char *name)
+{
+    if (handle == LLBC_INVALID_NATIVE_THREAD_HANDLE || !name)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+#if LLBC_TARGET_PLATFORM_LINUX || LLBC_TARGET_PLATFORM_ANDROID
+    // Linux thread name limit to 16 bytes(include '\0').
+    char truncatedName[16];
+    strncpy(truncatedName, name, sizeof(truncatedName) - 1);
+    truncatedName[sizeof(truncatedName) - 1] = '\0';
+
+    const int status = pthread_setname_np(handle, truncatedName);
+    if (status != 0)
+    {
+        errno = status;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+#elif LLBC_TARGET_PLATFORM_MAC || LLBC_TARGET_PLATFORM_IPHONE
+    if (pthread_equal(handle, pthread_self()) == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+        return LLBC_FAILED;
+    }
+
+    const int status = pthread_setname_np(name);
+    if (status != 0)
+    {
+        errno = status;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+#else
+    // SetThreadDescription only available on Windows 10 1607 and later, dynamic load it.
+    typedef HRESULT (WINAPI *_SetThreadDescriptionFunc)(HANDLE, PCWSTR);
+    static _SetThreadDescriptionFunc setThreadDescription = reinterpret_cast<_SetThreadDescriptionFunc>(
+        ::GetProcAddress(::GetModuleHandleW(L"kernel32.dll"), "SetThreadDescription"));
+    if (!setThreadDescription)
+    {
+        LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+        return LLBC_FAILED;
+    }
+
+    wchar_t wideName[256];
+    if (::MultiByteToWideChar(CP_UTF8, 0, name, -1, wideName, sizeof(wideName) / sizeof(wideName[0])) == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_OSAPI);
+        return LLBC_FAILED;
+    }
+
+    if (FAILED(setThreadDescription(handle, wideName)))
+    {
+        LLBC_SetLastError(LLBC_ERROR_OSAPI);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+#endif
+}
+
+int LLBC_SetThreadAffinity(LLBC_NativeThreadHandle handle, uint64 cpuMask)
+{
+    if (handle == LLBC_INVALID_NATIVE_THREAD_HANDLE || cpuMask == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+#if LLBC_TARGET_PLATFORM_LINUX
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu = 0; cpu < 64; ++cpu)
+    {
+        if (cpuMask & (static_cast<uint64>(1) << cpu))
+            CPU_SET(cpu, &cpuSet);
+    }
+
+    const int status = pthread_setaffinity_np(handle, sizeof(cpuSet), &cpuSet);
+    if (status != 0)
+    {
+        errno = status;
+        LLBC_SetLastError(LLBC_ERROR_CLIB);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+#elif LLBC_TARGET_PLATFORM_WIN32
+    if (::SetThreadAffinityMask(handle, static_cast<DWORD_PTR>(cpuMask)) == 0)
+    {
+        LLBC_SetLastError(LLBC_ERROR_OSAPI);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+#else
+    LLBC_SetLastError(LLBC_ERROR_NOT_IMPL);
+    return LLBC_FAILED;
+#endif
+}
+
+int LLBC_ParseCPUMask(const char *cpuList, uint64 &cpuMask)
+{
+    cpuMask = 0;
+    if (!cpuList || *cpuList == '\0')
+    {
+        LLBC_SetLastError(LLBC_ERROR_ARG);
+        return LLBC_FAILED;
+    }
+
+    // Hex mask format, eg: 0x4f.
+    char *endPtr = nullptr;
+    if (cpuList[0] == '0' && (cpuList[1] == 'x' || cpuList[1] == 'X'))
+    {
+        cpuMask = strtoull(cpuList + 2, &endPtr, 16);
+        if (endPtr == cpuList + 2 || *endPtr != '\0' || cpuMask == 0)
+        {
+            cpuMask = 0;
+            LLBC_SetLastError(LLBC_ERROR_FORMAT);
+            return LLBC_FAILED;
+        }
+
+        return LLBC_OK;
+    }
+
+    // Cpu list format, eg: 0-3,6.
+    const char *ptr = cpuList;
+    while (*ptr != '\0')
+    {
+        while (*ptr == ' ')
+            ++ptr;
+
+        const long beg = strtol(ptr, &endPtr, 10);
+        long end = beg;
+        if (endPtr == ptr)
+            break;
+
+        ptr = endPtr;
+        if (*ptr == '-')
+        {
+            end = strtol(ptr + 1, &endPtr, 10);
+            if (endPtr == ptr + 1)
+                break;
+
+            ptr = endPtr;
+        }
+
+        if (beg < 0 || end < beg || end >= 64)
+            break;
+
+        for (long cpu = beg; cpu <= end; ++cpu)
+            cpuMask |= static_cast<uint64>(1) << cpu;
+
+        while (*ptr == ' ')
+            ++ptr;
+        if (*ptr == ',')
+            ++ptr;
+        else if (*ptr != '\0')
+            break;
+    }
+
+    if (*ptr != '\0' || cpuMask == 0)
+    {
+        cpuMask = 0;
+        LLBC_SetLastError(LLBC_ERROR_FORMAT);
+        return LLBC_FAILED;
+    }
+
+    return LLBC_OK;
+}
+
 int LLBC_SuspendThread(LLBC_NativeThreadHandle handle)
 {
     if (handle == LLBC_INVALID_NATIVE_THREAD_HANDLE)
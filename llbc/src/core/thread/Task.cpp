@@ -40,6 +40,8 @@ LLBC_Task::LLBC_Task(LLBC_ThreadMgr *threadMgr)
 
 , _threadNum(0)
 , _activatingThreadNum(0)
+
+, _cpuMask(0)
 {
 }
 
@@ -106,6 +108,26 @@ int LLBC_Task::Activate(int threadNum,
     return LLBC_OK;
 }
 
+int LLBC_Task::SetThreadName(const LLBC_String &threadName)
+{
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_taskState != LLBC_TaskState::NotActivated, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
+
+    _threadName = threadName;
+
+    return LLBC_OK;
+}
+
+int LLBC_Task::SetCPUAffinity(uint64 cpuMask)
+{
+    LLBC_LockGuard guard(_lock);
+    LLBC_SetErrAndReturnIf(_taskState != LLBC_TaskState::NotActivated, LLBC_ERROR_NOT_ALLOW, LLBC_FAILED);
+
+    _cpuMask = cpuMask;
+
+    return LLBC_OK;
+}
+
 int LLBC_Task::Wait()
 {
     // Task state check.
@@ -162,6 +184,12 @@ void LLBC_Task::TaskEntry(void *arg)
     // Incr activating thread num.
     (void)LLBC_AtomicFetchAndAdd(&_activatingThreadNum, 1);
 
+    // Apply thread name and cpu affinity(if set), failure is not fatal.
+    if (!_threadName.empty())
+        (void)LLBC_SetThreadName(LLBC_GetCurrentThread(), _threadName.c_str());
+    if (_cpuMask != 0)
+        (void)LLBC_SetThreadAffinity(LLBC_GetCurrentThread(), _cpuMask);
+
     // Waiting for Task::Activate() call finished.
     while (GetTaskState() != LLBC_NS LLBC_TaskState::Activated)
         LLBC_NS LLBC_Sleep(0);
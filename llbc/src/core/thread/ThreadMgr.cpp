@@ -320,6 +320,36 @@ int LLBC_ThreadMgr::SetPriority(LLBC_Handle handle, int priority)
     return rtn;
 }
 
+int LLBC_ThreadMgr::SetThreadName(LLBC_Handle handle, const LLBC_String &name)
+{
+    LLBC_SetErrAndReturnIf(UNLIKELY(handle == LLBC_INVALID_HANDLE),
+                           LLBC_ERROR_ARG,
+                           LLBC_FAILED);
+    LLBC_ReturnIf(handle == LLBC_CFG_THREAD_ENTRY_THREAD_HANDLE,
+                  LLBC_NS LLBC_SetThreadName(GetNativeThreadHandle(handle), name.c_str()));
+
+    LLBC_LockGuard guard(_lock);
+    LLBC_ThreadDescriptor *threadDesc = FindThreadDescriptor(handle);
+    LLBC_SetErrAndReturnIf(!threadDesc, LLBC_ERROR_NOT_FOUND, LLBC_FAILED);
+
+    return LLBC_NS LLBC_SetThreadName(threadDesc->GetNativeHandle(), name.c_str());
+}
+
+int LLBC_ThreadMgr::SetThreadAffinity(LLBC_Handle handle, uint64 cpuMask)
+{
+    LLBC_SetErrAndReturnIf(UNLIKELY(handle == LLBC_INVALID_HANDLE),
+                           LLBC_ERROR_ARG,
+                           LLBC_FAILED);
+    LLBC_ReturnIf(handle == LLBC_CFG_THREAD_ENTRY_THREAD_HANDLE,
+                  LLBC_NS LLBC_SetThreadAffinity(GetNativeThreadHandle(handle), cpuMask));
+
+    LLBC_LockGuard guard(_lock);
+    LLBC_ThreadDescriptor *threadDesc = FindThreadDescriptor(handle);
+    LLBC_SetErrAndReturnIf(!threadDesc, LLBC_ERROR_NOT_FOUND, LLBC_FAILED);
+
+    return LLBC_NS LLBC_SetThreadAffinity(threadDesc->GetNativeHandle(), cpuMask);
+}
+
 int LLBC_ThreadMgr::GetGroupThreadHandles(LLBC_Handle groupHandle, std::vector<LLBC_Handle> &handles)
 {
     LLBC_SetErrAndReturnIf(UNLIKELY(groupHandle == LLBC_INVALID_HANDLE),
@@ -23,6 +23,7 @@
 #include "llbc/common/Export.h"
 
 #include "llbc/core/os/OS_Time.h"
+#include "llbc/core/utils/Util_Debug.h"
 
 #include "llbc/core/timer/Timer.h"
 #include "llbc/core/timer/TimerData.h"
@@ -35,6 +36,9 @@ LLBC_TimerScheduler::LLBC_TimerScheduler()
 : _maxTimerId(0)
 , _enabled(true)
 , _destroyed(false)
+, _timeoutProfileEnabled(false)
+, _slowestTimerId(0)
+, _slowestTimeoutTime(0)
 {
 }
 
@@ -68,6 +72,12 @@ LLBC_TimerScheduler::_This *LLBC_TimerScheduler::GetCurrentThreadScheduler()
 
 void LLBC_TimerScheduler::Update()
 {
+    if (UNLIKELY(_timeoutProfileEnabled))
+    {
+        _slowestTimerId = 0;
+        _slowestTimeoutTime = 0;
+    }
+
     if (UNLIKELY(!_enabled))
         return;
     else if (_heap.IsEmpty())
@@ -99,7 +109,22 @@ void LLBC_TimerScheduler::Update()
 #endif // LLBC_CFG_CORE_TIMER_STRICT_SCHEDULE
         {
             ++data->repeatTimes;
-            timer->OnTimeout();
+            if (LIKELY(!_timeoutProfileEnabled))
+            {
+                timer->OnTimeout();
+            }
+            else
+            {
+                const LLBC_CPUTime begTime = LLBC_CPUTime::Current();
+                timer->OnTimeout();
+
+                const sint64 timeoutTime = (LLBC_CPUTime::Current() - begTime).ToNanoSeconds();
+                if (timeoutTime > _slowestTimeoutTime)
+                {
+                    _slowestTimerId = data->timerId;
+                    _slowestTimeoutTime = timeoutTime;
+                }
+            }
 
             // Cancel() or Schedule() called.
             if (!data->validate)
@@ -152,6 +177,17 @@ size_t LLBC_TimerScheduler::GetTimerCount() const
     return _heap.GetSize();
 }
 
+void LLBC_TimerScheduler::SetTimeoutProfileEnabled(bool enabled)
+{
+    _timeoutProfileEnabled = enabled;
+}
+
+void LLBC_TimerScheduler::GetSlowestTimeout(LLBC_TimerId &timerId, sint64 &timeoutTime) const
+{
+    timerId = _slowestTimerId;
+    timeoutTime = _slowestTimeoutTime;
+}
+
 bool LLBC_TimerScheduler::IsDstroyed() const
 {
     return _destroyed;
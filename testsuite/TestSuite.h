@@ -91,6 +91,25 @@
 #include "comm/TestCase_Comm_MessageBuffer.h"
 #include "comm/TestCase_Comm_DynLoadComp.h"
 #include "comm/TestCase_Comm_Echo.h"
+#include "comm/TestCase_Comm_LocalSession.h"
+#include "comm/TestCase_Comm_Udp.h"
+#include "comm/TestCase_Comm_PollerPlace.h"
+#include "comm/TestCase_Comm_RecvBudget.h"
+#include "comm/TestCase_Comm_CompactProtocol.h"
+#include "comm/TestCase_Comm_OpcodeStats.h"
+#include "comm/TestCase_Comm_FrameProfile.h"
+#include "comm/TestCase_Comm_QueueStats.h"
+#include "comm/TestCase_Comm_ThreadCfg.h"
+#include "comm/TestCase_Comm_BusyPoll.h"
+#include "comm/TestCase_Comm_PacketPriority.h"
+#include "comm/TestCase_Comm_Overload.h"
+#include "comm/TestCase_Comm_DecodeOffload.h"
+#include "comm/TestCase_Comm_Rpc.h"
+#include "comm/TestCase_Comm_Coro.h"
+#include "comm/TestCase_Comm_IdleReaper.h"
+#include "comm/TestCase_Comm_PollPoller.h"
+#include "comm/TestCase_Comm_SendFile.h"
+#include "comm/TestCase_Comm_PacketCapture.h"
 
 #include "app/TestCase_App_AppTest.h"
 #include "app/TestCase_App_AppCfgTest.h"
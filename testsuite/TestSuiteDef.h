@@ -70,6 +70,25 @@ __DEFINE_TEST_CASE(TestCase_Comm_ProtoStackCtrl)
 __DEFINE_TEST_CASE(TestCase_Comm_MessageBuffer)
 __DEFINE_TEST_CASE(TestCase_Comm_DynLoadComp)
 __DEFINE_TEST_CASE(TestCase_Comm_Echo)
+__DEFINE_TEST_CASE(TestCase_Comm_LocalSession)
+__DEFINE_TEST_CASE(TestCase_Comm_Udp)
+__DEFINE_TEST_CASE(TestCase_Comm_PollerPlace)
+__DEFINE_TEST_CASE(TestCase_Comm_RecvBudget)
+__DEFINE_TEST_CASE(TestCase_Comm_CompactProtocol)
+__DEFINE_TEST_CASE(TestCase_Comm_OpcodeStats)
+__DEFINE_TEST_CASE(TestCase_Comm_FrameProfile)
+__DEFINE_TEST_CASE(TestCase_Comm_QueueStats)
+__DEFINE_TEST_CASE(TestCase_Comm_ThreadCfg)
+__DEFINE_TEST_CASE(TestCase_Comm_BusyPoll)
+__DEFINE_TEST_CASE(TestCase_Comm_PacketPriority)
+__DEFINE_TEST_CASE(TestCase_Comm_Overload)
+__DEFINE_TEST_CASE(TestCase_Comm_DecodeOffload)
+__DEFINE_TEST_CASE(TestCase_Comm_Rpc)
+__DEFINE_TEST_CASE(TestCase_Comm_Coro)
+__DEFINE_TEST_CASE(TestCase_Comm_IdleReaper)
+__DEFINE_TEST_CASE(TestCase_Comm_PollPoller)
+__DEFINE_TEST_CASE(TestCase_Comm_SendFile)
+__DEFINE_TEST_CASE(TestCase_Comm_PacketCapture)
 __DEFINE_TEST_CASE(TestCase_App_AppTest)
 __DEFINE_TEST_CASE(TestCase_App_AppCfgTest)
 __DEFINE_TEST_CASE(TestCase_App_AppPhaseWaitingTest)
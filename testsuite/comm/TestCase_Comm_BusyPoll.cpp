@@ -0,0 +1,169 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_BusyPoll.h"
+
+namespace
+{
+
+const int OPCODE_PING = 1;
+const int PING_TIMES = 2000;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7797;
+
+class TestComp : public LLBC_Component
+{
+public:
+    TestComp(bool asClient)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _asClient(asClient)
+    , _pingTimes(0)
+    , _sendTime(0)
+    , _rttHistogram()
+    , _finished(false)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (_asClient && !sessionInfo.IsListenSession())
+            SendPing(sessionInfo.GetSessionId());
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        const int sessionId = packet.GetSessionId();
+        if (!_asClient)
+        {
+            GetService()->Send(sessionId, OPCODE_PING, nullptr);
+            return;
+        }
+
+        _rttHistogram.Record(LLBC_CPUTime::Current().ToNanoSeconds() - _sendTime);
+        if (++_pingTimes < PING_TIMES)
+        {
+            SendPing(sessionId);
+        }
+        else
+        {
+            LLBC_PrintLn("  rtt: %s", _rttHistogram.ToString().c_str());
+            GetService()->RemoveSession(sessionId, "Ping finished");
+            _finished = true;
+        }
+    }
+
+    bool IsFinished() const
+    {
+        return _finished;
+    }
+
+private:
+    void SendPing(int sessionId)
+    {
+        _sendTime = LLBC_CPUTime::Current().ToNanoSeconds();
+        GetService()->Send(sessionId, OPCODE_PING, nullptr);
+    }
+
+private:
+    bool _asClient;
+    int _pingTimes;
+    sint64 _sendTime;
+    LLBC_LatencyHistogram _rttHistogram;
+    volatile bool _finished;
+};
+
+}
+
+TestCase_Comm_BusyPoll::TestCase_Comm_BusyPoll()
+{
+}
+
+TestCase_Comm_BusyPoll::~TestCase_Comm_BusyPoll()
+{
+}
+
+int TestCase_Comm_BusyPoll::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Poller busy poll(low-latency mode) test:");
+
+    // Compare ping-pong rtt between blocking mode and busy poll mode.
+    if (RunPingPong(0) != LLBC_OK ||
+        RunPingPong(200) != LLBC_OK)
+        return LLBC_FAILED;
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_BusyPoll::RunPingPong(int busyPollWindow)
+{
+    LLBC_PrintLn("Ping-pong %d times, busy poll window: %d us", PING_TIMES, busyPollWindow);
+
+    // Create client & server services, client service frame tasks driven at max fps.
+    LLBC_Service *svcs[2];
+    TestComp *clientComp = nullptr;
+    for (int i = 0; i < 2; ++i)
+    {
+        const bool asClient = i == 0;
+        LLBC_Service *svc = LLBC_Service::Create(asClient ? "BusyPollClient" : "BusyPollServer");
+
+        TestComp *comp = new TestComp(asClient);
+        svc->AddComponent(comp);
+        svc->Subscribe(OPCODE_PING, comp, &TestComp::OnRecv);
+        svc->SuppressCoderNotFoundWarning();
+        svc->SetFPS(LLBC_CFG_COMM_MAX_SERVICE_FPS);
+        svc->SetPollerBusyPoll(busyPollWindow);
+        if (svc->Start(1) != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+            delete svc;
+            for (int j = 0; j < i; ++j)
+                delete svcs[j];
+
+            return LLBC_FAILED;
+        }
+
+        if (asClient)
+            clientComp = comp;
+        svcs[i] = svc;
+    }
+
+    if (svcs[1]->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+    else if (svcs[0]->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+    else
+    {
+        // Wait ping-pong finished, at most 30 seconds.
+        for (int waitTimes = 0; !clientComp->IsFinished() && waitTimes < 3000; ++waitTimes)
+            LLBC_Sleep(10);
+    }
+
+    delete svcs[0];
+    delete svcs[1];
+
+    return LLBC_OK;
+}
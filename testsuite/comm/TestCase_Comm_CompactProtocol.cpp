@@ -0,0 +1,214 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_CompactProtocol.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int PING_TIMES = 3;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7793;
+
+class TestComp : public LLBC_Component
+{
+public:
+    TestComp(bool asClient)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _asClient(asClient)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (_asClient && !sessionInfo.IsListenSession())
+            SendPing(sessionInfo.GetSessionId(), 1);
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        int seq;
+        packet >>seq;
+
+        LLBC_PrintLn("[%s]Recv packet, opcode: %d, flags: %d, extData1: %lld, seq: %d, peer: %s",
+                     GetService()->GetName().c_str(),
+                     packet.GetOpcode(),
+                     packet.GetFlags(),
+                     packet.GetExtData1(),
+                     seq,
+                     packet.GetPeerAddr().ToString().c_str());
+
+        const int sessionId = packet.GetSessionId();
+        if (!_asClient)
+            SendPing(sessionId, seq);
+        else if (seq < PING_TIMES)
+            SendPing(sessionId, seq + 1);
+        else
+            GetService()->RemoveSession(sessionId, "Ping finished");
+    }
+
+private:
+    void SendPing(int sessionId, int seq)
+    {
+        LLBC_Packet *packet = GetService()->GetPacketObjectPool().GetObject();
+        packet->SetHeader(sessionId, OPCODE, 0);
+        packet->SetFlags(seq % 2);
+        packet->SetExtData1(seq == PING_TIMES ? -1 : seq * 1000);
+        *packet <<seq;
+
+        GetService()->Send(packet);
+    }
+
+private:
+    bool _asClient;
+};
+
+}
+
+TestCase_Comm_CompactProtocol::TestCase_Comm_CompactProtocol()
+{
+}
+
+TestCase_Comm_CompactProtocol::~TestCase_Comm_CompactProtocol()
+{
+}
+
+int TestCase_Comm_CompactProtocol::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Compact packet protocol test:");
+
+    if (AssemblerTest() != LLBC_OK)
+        return LLBC_FAILED;
+
+    return ServiceTest();
+}
+
+int TestCase_Comm_CompactProtocol::AssemblerTest()
+{
+    LLBC_PrintLn("Compact packet header assembler test:");
+
+    // Build header, then assemble it byte by byte.
+    LLBC_Packet packets[3];
+    packets[0].SetOpcode(1);
+    packets[1].SetOpcode(10001);
+    packets[1].SetStatus(3);
+    packets[1].SetSenderServiceId(2);
+    packets[1].SetRecverServiceId(300);
+    packets[1].SetFlags(1);
+    packets[1].SetExtData1(-1);
+    packets[2].SetOpcode(-1);
+    packets[2].Write("Hello, World", 12);
+
+    for (size_t i = 0; i < sizeof(packets) / sizeof(packets[0]); ++i)
+    {
+        LLBC_Packet &packet = packets[i];
+
+        char header[LLBC_CompactPacketHeaderAssembler::MaxHeaderLen];
+        const size_t headerLen = LLBC_CompactPacketHeaderAssembler::BuildHeader(packet, header);
+
+        size_t used;
+        bool assembled = false;
+        LLBC_CompactPacketHeaderAssembler assembler;
+        for (size_t pos = 0; pos < headerLen && !assembled; ++pos)
+            assembled = assembler.Assemble(header + pos, 1, used);
+
+        LLBC_Packet assembledPacket;
+        if (!assembled ||
+            assembler.GetHeaderLen() != headerLen ||
+            !assembler.SetToPacket(assembledPacket) ||
+            assembledPacket.GetLength() != headerLen + packet.GetPayloadLength() ||
+            assembledPacket.GetOpcode() != packet.GetOpcode() ||
+            assembledPacket.GetStatus() != packet.GetStatus() ||
+            assembledPacket.GetSenderServiceId() != packet.GetSenderServiceId() ||
+            assembledPacket.GetRecverServiceId() != packet.GetRecverServiceId() ||
+            assembledPacket.GetFlags() != packet.GetFlags() ||
+            assembledPacket.GetExtData1() != packet.GetExtData1())
+        {
+            LLBC_FilePrintLn(stderr, "Packet %lu assemble failed", i);
+            return LLBC_FAILED;
+        }
+
+        LLBC_PrintLn("Packet %lu header length: %lu(normal header length: 28)", i, headerLen);
+    }
+
+    // Malformed header(unknown field mask bit) test.
+    size_t used;
+    const char malformed[] = {static_cast<char>(0x80), 0x01};
+    LLBC_CompactPacketHeaderAssembler assembler;
+    LLBC_Packet packet;
+    if (!assembler.Assemble(malformed, sizeof(malformed), used) || assembler.SetToPacket(packet))
+    {
+        LLBC_FilePrintLn(stderr, "Malformed header check failed");
+        return LLBC_FAILED;
+    }
+
+    LLBC_PrintLn("Malformed header check success");
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_CompactProtocol::ServiceTest()
+{
+    LLBC_PrintLn("Compact protocol service test:");
+
+    // Create client & server services, both use compact protocol factory.
+    LLBC_Service *svcs[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        const bool asClient = i == 0;
+        LLBC_Service *svc = LLBC_Service::Create(asClient ? "CompactClient" : "CompactServer",
+                                                 new LLBC_CompactProtocolFactory);
+
+        TestComp *comp = new TestComp(asClient);
+        svc->AddComponent(comp);
+        svc->Subscribe(OPCODE, comp, &TestComp::OnRecv);
+        svc->SuppressCoderNotFoundWarning();
+        if (svc->Start() != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+            delete svc;
+            for (int j = 0; j < i; ++j)
+                delete svcs[j];
+
+            return LLBC_FAILED;
+        }
+
+        svcs[i] = svc;
+    }
+
+    if (svcs[1]->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+    else if (svcs[0]->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    delete svcs[0];
+    delete svcs[1];
+
+    return LLBC_OK;
+}
@@ -0,0 +1,212 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_Coro.h"
+
+namespace
+{
+
+const int OPCODE_REQ = 1;
+const int OPCODE_RSP = 2;
+const int CORO_COUNT = 20;
+const int CALLS_PER_CORO = 10;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7802;
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    {
+    }
+
+public:
+    void OnRequest(LLBC_Packet &packet)
+    {
+        // Handler run in coroutine, sleep a while then reply, packet still available after sleep.
+        int seq;
+        memcpy(&seq, packet.GetPayload(), sizeof(seq));
+        GetService()->CoroSleep(seq % 3 * 5);
+
+        GetService()->Reply(packet, OPCODE_RSP, &seq, sizeof(seq));
+    }
+};
+
+class ClientComp : public LLBC_Component
+{
+public:
+    ClientComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _svcThreadId(LLBC_INVALID_NATIVE_THREAD_ID)
+    , _okCount(0)
+    , _failedCount(0)
+    , _threadMismatchCount(0)
+    , _finishedCoros(0)
+    , _cancelledCoros(0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        _svcThreadId = LLBC_GetCurrentThreadId();
+
+        // Every coroutine issue calls one by one, all coroutines run concurrently.
+        const int sessionId = sessionInfo.GetSessionId();
+        for (int coroIdx = 0; coroIdx < CORO_COUNT; ++coroIdx)
+        {
+            GetService()->Go([this, sessionId, coroIdx]() {
+                for (int callIdx = 0; callIdx < CALLS_PER_CORO; ++callIdx)
+                {
+                    const int seq = coroIdx * CALLS_PER_CORO + callIdx;
+                    LLBC_RpcResult result;
+                    if (GetService()->CoroCall(sessionId, OPCODE_REQ, &seq, sizeof(seq), result) != LLBC_OK ||
+                        !result.IsOk())
+                    {
+                        ++_failedCount;
+                        continue;
+                    }
+
+                    int rspSeq;
+                    memcpy(&rspSeq, result.response->GetPayload(), sizeof(rspSeq));
+                    if (rspSeq == seq)
+                        ++_okCount;
+                    else
+                        ++_failedCount;
+
+                    if (LLBC_GetCurrentThreadId() != _svcThreadId)
+                        ++_threadMismatchCount;
+                }
+
+                ++_finishedCoros;
+            });
+        }
+
+        // Forever waiting coroutine, will be cancelled when service stop.
+        GetService()->Go([this]() {
+            if (GetService()->YieldCoro() != LLBC_OK &&
+                LLBC_GetLastError() == LLBC_ERROR_CANCELLED)
+                ++_cancelledCoros;
+        });
+
+        LLBC_PrintLn("Client started %d coroutines, alive coroutines: %lu",
+                     CORO_COUNT + 1, GetService()->GetCoroCount());
+    }
+
+public:
+    bool IsFinished() const { return _finishedCoros == CORO_COUNT; }
+    void PrintResult() const
+    {
+        LLBC_PrintLn("Coroutines finished: %d, calls ok: %d, failed: %d, thread mismatch: %d",
+                     static_cast<int>(_finishedCoros), _okCount, _failedCount, _threadMismatchCount);
+    }
+    int GetCancelledCoros() const { return _cancelledCoros; }
+
+private:
+    LLBC_ThreadId _svcThreadId;
+    int _okCount;
+    int _failedCount;
+    int _threadMismatchCount;
+    volatile int _finishedCoros;
+    int _cancelledCoros;
+};
+
+}
+
+TestCase_Comm_Coro::TestCase_Comm_Coro()
+{
+}
+
+TestCase_Comm_Coro::~TestCase_Comm_Coro()
+{
+}
+
+int TestCase_Comm_Coro::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service coroutine test:");
+
+    // Coroutine basic test, resume & yield in current thread.
+    LLBC_CoroStackPool stackPool;
+    int step = 0;
+    LLBC_Coro *coro = nullptr;
+    coro = new LLBC_Coro([&step, &coro]() {
+        ++step;
+        coro->Yield();
+        ++step;
+    }, stackPool);
+    coro->Resume();
+    LLBC_PrintLn("After first resume, step: %d, finished: %s", step, coro->IsFinished() ? "true" : "false");
+    coro->Resume();
+    LLBC_PrintLn("After second resume, step: %d, finished: %s", step, coro->IsFinished() ? "true" : "false");
+    delete coro;
+    LLBC_PrintLn("Stack size: %lu, idle stacks: %lu", stackPool.GetStackSize(), stackPool.GetIdleStackCount());
+
+    LLBC_Service *server = LLBC_Service::Create("CoroServer");
+    ServerComp *serverComp = new ServerComp;
+    server->AddComponent(serverComp);
+    server->SubscribeCoro(OPCODE_REQ, serverComp, &ServerComp::OnRequest);
+    server->SuppressCoderNotFoundWarning();
+
+    LLBC_Service *client = LLBC_Service::Create("CoroClient");
+    ClientComp *clientComp = new ClientComp;
+    client->AddComponent(clientComp);
+    client->SuppressCoderNotFoundWarning();
+
+    LLBC_Defer(delete client; delete server);
+
+    // Go before service started will failed.
+    const sint64 coroId = client->Go([]() {});
+    LLBC_PrintLn("Go before service started, coroId: %lld, err: %s", coroId, LLBC_FormatLastError());
+
+    if (server->Start() != LLBC_OK || client->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (server->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (client->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    for (int i = 0; i < 500 && !clientComp->IsFinished(); ++i)
+        LLBC_Sleep(10);
+
+    clientComp->PrintResult();
+
+    client->Stop();
+    LLBC_PrintLn("After client stopped, cancelled coroutines: %d", clientComp->GetCancelledCoros());
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
@@ -0,0 +1,196 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include <atomic>
+
+#include "comm/TestCase_Comm_DecodeOffload.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int PACKET_COUNT = 10000;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7800;
+
+LLBC_ThreadId __svcThreadId = LLBC_INVALID_NATIVE_THREAD_ID;
+std::atomic<int> __offloadedDecodeCount(0);
+
+struct SeqData : public LLBC_Coder
+{
+    int seq;
+    LLBC_String payload;
+
+    SeqData()
+    : seq(0)
+    {
+    }
+
+    virtual bool Encode(LLBC_Packet &packet)
+    {
+        packet <<seq <<payload;
+        return true;
+    }
+
+    virtual bool Decode(LLBC_Packet &packet)
+    {
+        packet >>seq >>payload;
+        if (LLBC_GetCurrentThreadId() != __svcThreadId)
+            ++__offloadedDecodeCount;
+
+        return true;
+    }
+
+    virtual void Clear()
+    {
+        seq = 0;
+        payload.clear();
+    }
+};
+
+class SeqDataFactory : public LLBC_CoderFactory
+{
+public:
+    virtual LLBC_Coder *Create() const
+    {
+        return new SeqData;
+    }
+};
+
+class ClientComp : public LLBC_Component
+{
+public:
+    ClientComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        for (int i = 0; i < PACKET_COUNT; ++i)
+        {
+            SeqData *data = new SeqData;
+            data->seq = i;
+            data->payload.append(64, 'x');
+            GetService()->Send(sessionInfo.GetSessionId(), OPCODE, data);
+        }
+    }
+};
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _recvCount(0)
+    , _outOfOrderCount(0)
+    {
+    }
+
+public:
+    virtual bool OnStart(bool &finished)
+    {
+        __svcThreadId = LLBC_GetCurrentThreadId();
+        return true;
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        SeqData *data = packet.GetDecoder<SeqData>();
+        if (data->seq != _recvCount)
+            ++_outOfOrderCount;
+        ++_recvCount;
+    }
+
+    int GetRecvCount() const { return _recvCount; }
+    int GetOutOfOrderCount() const { return _outOfOrderCount; }
+
+private:
+    volatile int _recvCount;
+    volatile int _outOfOrderCount;
+};
+
+}
+
+TestCase_Comm_DecodeOffload::TestCase_Comm_DecodeOffload()
+{
+}
+
+TestCase_Comm_DecodeOffload::~TestCase_Comm_DecodeOffload()
+{
+}
+
+int TestCase_Comm_DecodeOffload::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service decode offload test:");
+
+    // Create non full-stack server service, enable decode offload.
+    LLBC_Service *server = LLBC_Service::Create("DecodeOffloadServer", nullptr, false);
+    ServerComp *serverComp = new ServerComp;
+    server->AddComponent(serverComp);
+    server->AddCoderFactory(OPCODE, new SeqDataFactory);
+    server->Subscribe(OPCODE, serverComp, &ServerComp::OnRecv);
+    server->SetDecodeOffload(true);
+
+    // Create client service(full-stack), decode offload not allowed.
+    LLBC_Service *client = LLBC_Service::Create("DecodeOffloadClient");
+    client->AddComponent(new ClientComp);
+    client->AddCoderFactory(OPCODE, new SeqDataFactory);
+    const int ret = client->SetDecodeOffload(true);
+    LLBC_PrintLn("Full-stack service set decode offload, ret: %d, err: %s", ret, LLBC_FormatLastError());
+
+    LLBC_Defer(delete client; delete server);
+    if (server->Start() != LLBC_OK || client->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (server->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (client->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    // Wait all packets received.
+    for (int i = 0; i < 500 && serverComp->GetRecvCount() < PACKET_COUNT; ++i)
+        LLBC_Sleep(10);
+
+    LLBC_PrintLn("Server recv packets: %d/%d, out of order: %d, decoded in poller threads: %d",
+                 serverComp->GetRecvCount(),
+                 PACKET_COUNT,
+                 serverComp->GetOutOfOrderCount(),
+                 __offloadedDecodeCount.load());
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
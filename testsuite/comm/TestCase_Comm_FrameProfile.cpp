@@ -0,0 +1,160 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_FrameProfile.h"
+
+namespace
+{
+
+const int OPCODE_SLOW = 1;
+const int SLOW_FRAME_BUDGET = 10;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7795;
+
+class SlowUpdateComp : public LLBC_Component
+{
+public:
+    SlowUpdateComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents | LLBC_ComponentEvents::OnUpdate)
+    , _updateTimes(0)
+    {
+    }
+
+public:
+    virtual void OnUpdate()
+    {
+        // Every 400 frames, sleep 20 milli-seconds.
+        if (++_updateTimes % 400 == 0)
+            LLBC_Sleep(20);
+    }
+
+private:
+    int _updateTimes;
+};
+
+class SlowHandleComp : public LLBC_Component
+{
+public:
+    SlowHandleComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _timer(nullptr)
+    , _sessionId(0)
+    {
+    }
+
+public:
+    virtual bool OnStart(bool &startFinished)
+    {
+        // Slow timer, timeout every 1 second, every timeout sleep 15 milli-seconds and send slow packet.
+        _timer = new LLBC_Timer(std::bind(&SlowHandleComp::OnTimeout, this, std::placeholders::_1));
+        _timer->Schedule(LLBC_TimeSpan::FromSeconds(1), LLBC_TimeSpan::FromSeconds(1));
+
+        return true;
+    }
+
+    virtual void OnStop(bool &stopFinished)
+    {
+        _timer->Cancel();
+        LLBC_XDelete(_timer);
+    }
+
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (!sessionInfo.IsListenSession() && sessionInfo.GetAcceptSessionId() == 0)
+            _sessionId = sessionInfo.GetSessionId();
+    }
+
+public:
+    void OnRecvSlow(LLBC_Packet &packet)
+    {
+        LLBC_Sleep(25);
+    }
+
+private:
+    void OnTimeout(LLBC_Timer *timer)
+    {
+        LLBC_Sleep(15);
+        if (_sessionId != 0)
+            GetService()->Send(_sessionId, OPCODE_SLOW, nullptr);
+    }
+
+private:
+    LLBC_Timer *_timer;
+    int _sessionId;
+};
+
+}
+
+TestCase_Comm_FrameProfile::TestCase_Comm_FrameProfile()
+{
+}
+
+TestCase_Comm_FrameProfile::~TestCase_Comm_FrameProfile()
+{
+}
+
+int TestCase_Comm_FrameProfile::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service frame profile test:");
+
+    LLBC_Service *svc = LLBC_Service::Create("FrameProfileSvc");
+    svc->AddComponent(new SlowUpdateComp);
+
+    SlowHandleComp *handleComp = new SlowHandleComp;
+    svc->AddComponent(handleComp);
+    svc->Subscribe(OPCODE_SLOW, handleComp, &SlowHandleComp::OnRecvSlow);
+    svc->SuppressCoderNotFoundWarning();
+
+    // Enable frame profile & set slow frame handler.
+    svc->SetFrameProfileEnabled(true);
+    svc->SetSlowFrameHandler([](const LLBC_SlowFrameInfo &slowFrameInfo) {
+        LLBC_PrintLn("Slow frame: %s", slowFrameInfo.ToString().c_str());
+    }, SLOW_FRAME_BUDGET);
+
+    if (svc->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        delete svc;
+
+        return LLBC_FAILED;
+    }
+
+    if (svc->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+    else if (svc->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+
+    LLBC_PrintLn("Press any key to dump frame profile...");
+    getchar();
+
+    LLBC_FrameProfile profile;
+    svc->GetFrameProfile(profile, true);
+    LLBC_PrintLn("Frame profile(current window): %s", profile.ToString().c_str());
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    delete svc;
+
+    return LLBC_OK;
+}
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_IdleReaper.h"
+
+namespace
+{
+
+const int READ_IDLE_TIMEOUT = 500;
+const int WRITE_IDLE_TIMEOUT = 200;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7803;
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents | LLBC_ComponentEvents::OnUnHandledPacket)
+    , _beginTime(LLBC_GetMilliSeconds())
+    , _reapedCount(0)
+    , _unhandledCount(0)
+    {
+    }
+
+public:
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        if (destroyInfo.GetSessionInfo().IsListenSession())
+            return;
+
+        LLBC_PrintLn("Session %d destroyed after %lld ms, reason: %s",
+                     destroyInfo.GetSessionId(),
+                     LLBC_GetMilliSeconds() - _beginTime,
+                     destroyInfo.GetReason().c_str());
+        if (destroyInfo.GetErrno() == LLBC_ERROR_TIMEOUTED)
+            ++_reapedCount;
+    }
+
+    virtual void OnUnHandledPacket(const LLBC_Packet &packet)
+    {
+        ++_unhandledCount;
+    }
+
+public:
+    int GetReapedCount() const { return _reapedCount; }
+    int GetUnhandledCount() const { return _unhandledCount; }
+
+private:
+    sint64 _beginTime;
+    volatile int _reapedCount;
+    volatile int _unhandledCount;
+};
+
+}
+
+TestCase_Comm_IdleReaper::TestCase_Comm_IdleReaper()
+{
+}
+
+TestCase_Comm_IdleReaper::~TestCase_Comm_IdleReaper()
+{
+}
+
+int TestCase_Comm_IdleReaper::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Poller idle session reaper test:");
+
+    LLBC_Service *server = LLBC_Service::Create("IdleReaperServer");
+    ServerComp *serverComp = new ServerComp;
+    server->AddComponent(serverComp);
+
+    LLBC_Service *client = LLBC_Service::Create("IdleReaperClient");
+
+    LLBC_Defer(delete client; delete server);
+
+    if (server->Start() != LLBC_OK || client->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    // Server close the sessions which not received any data in read idle timeout.
+    LLBC_SessionOpts serverOpts;
+    serverOpts.SetReadIdleTimeout(READ_IDLE_TIMEOUT);
+    if (server->Listen(LISTEN_IP, LISTEN_PORT, nullptr, serverOpts) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    // Heartbeat session keep alive, silent session will be reaped.
+    LLBC_SessionOpts heartbeatOpts;
+    heartbeatOpts.SetWriteIdleTimeout(WRITE_IDLE_TIMEOUT);
+    heartbeatOpts.SetAutoHeartbeat(true);
+    const int heartbeatSessionId = client->Connect(LISTEN_IP, LISTEN_PORT, -1.0, nullptr, heartbeatOpts);
+    const int silentSessionId = client->Connect(LISTEN_IP, LISTEN_PORT);
+    if (heartbeatSessionId == 0 || silentSessionId == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    LLBC_PrintLn("Heartbeat session: %d, silent session: %d, wait %d ms...",
+                 heartbeatSessionId, silentSessionId, READ_IDLE_TIMEOUT * 4);
+    LLBC_Sleep(READ_IDLE_TIMEOUT * 4);
+
+    LLBC_PrintLn("Reaped sessions: %d(expect 1), unhandled packets: %d(expect 0)",
+                 serverComp->GetReapedCount(), serverComp->GetUnhandledCount());
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
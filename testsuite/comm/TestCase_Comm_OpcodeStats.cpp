@@ -0,0 +1,198 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_OpcodeStats.h"
+
+namespace
+{
+
+const int OPCODE_PING = 1;
+const int OPCODE_BIG_PING = 2;
+const int PING_TIMES = 100;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7794;
+
+class TestComp : public LLBC_Component
+{
+public:
+    TestComp(bool asClient)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _asClient(asClient)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (_asClient && !sessionInfo.IsListenSession())
+            SendPing(sessionInfo.GetSessionId(), 1);
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        int seq;
+        packet >>seq;
+
+        const int sessionId = packet.GetSessionId();
+        if (!_asClient)
+        {
+            SendPing(sessionId, seq);
+        }
+        else if (seq < PING_TIMES)
+        {
+            SendPing(sessionId, seq + 1);
+        }
+        else
+        {
+            DumpStats();
+            GetService()->RemoveSession(sessionId, "Ping finished");
+        }
+    }
+
+private:
+    void SendPing(int sessionId, int seq)
+    {
+        // Odd seq use small payload, even seq use big payload.
+        LLBC_Packet *packet = GetService()->GetPacketObjectPool().GetObject();
+        packet->SetHeader(sessionId, seq % 2 ? OPCODE_PING : OPCODE_BIG_PING, 0);
+        *packet <<seq;
+        if (seq % 2 == 0)
+            *packet <<LLBC_String(1024, 'x');
+
+        GetService()->Send(packet);
+    }
+
+    void DumpStats()
+    {
+        std::map<int, LLBC_OpcodeStat> stats;
+        GetService()->GetOpcodeStats(stats);
+        for (auto &statItem : stats)
+            LLBC_PrintLn("[%s]opcode: %d, %s",
+                         GetService()->GetName().c_str(), statItem.first, statItem.second.ToString().c_str());
+    }
+
+private:
+    bool _asClient;
+};
+
+}
+
+TestCase_Comm_OpcodeStats::TestCase_Comm_OpcodeStats()
+{
+}
+
+TestCase_Comm_OpcodeStats::~TestCase_Comm_OpcodeStats()
+{
+}
+
+int TestCase_Comm_OpcodeStats::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Opcode statistics test:");
+
+    if (HistogramTest() != LLBC_OK)
+        return LLBC_FAILED;
+
+    return ServiceTest();
+}
+
+int TestCase_Comm_OpcodeStats::HistogramTest()
+{
+    LLBC_PrintLn("Latency histogram test:");
+
+    // Record 1us ~ 1000us.
+    LLBC_LatencyHistogram histogram;
+    for (int i = 1; i <= 1000; ++i)
+        histogram.Record(i * 1000);
+
+    LLBC_PrintLn("Histogram: %s", histogram.ToString().c_str());
+    const sint64 p50 = histogram.GetValueAtPercentile(50.0);
+    const sint64 p99 = histogram.GetValueAtPercentile(99.0);
+    if (histogram.GetCount() != 1000 ||
+        histogram.GetMin() != 1000 ||
+        histogram.GetMax() != 1000 * 1000 ||
+        p50 < 500 * 1000 || p50 > 500 * 1000 * 9 / 8 ||
+        p99 < 990 * 1000 || p99 > 1000 * 1000)
+    {
+        LLBC_FilePrintLn(stderr, "Histogram check failed, p50: %lld, p99: %lld", p50, p99);
+        return LLBC_FAILED;
+    }
+
+    histogram.Reset();
+    if (histogram.GetCount() != 0 || histogram.GetValueAtPercentile(99.0) != 0)
+    {
+        LLBC_FilePrintLn(stderr, "Histogram reset check failed");
+        return LLBC_FAILED;
+    }
+
+    LLBC_PrintLn("Latency histogram check success");
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_OpcodeStats::ServiceTest()
+{
+    LLBC_PrintLn("Service opcode statistics test:");
+
+    // Create client & server services, server dump opcode statistics every 500 milli-seconds.
+    LLBC_Service *svcs[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        const bool asClient = i == 0;
+        LLBC_Service *svc = LLBC_Service::Create(asClient ? "StatsClient" : "StatsServer");
+
+        TestComp *comp = new TestComp(asClient);
+        svc->AddComponent(comp);
+        svc->Subscribe(OPCODE_PING, comp, &TestComp::OnRecv);
+        svc->Subscribe(OPCODE_BIG_PING, comp, &TestComp::OnRecv);
+        svc->SuppressCoderNotFoundWarning();
+        svc->SetOpcodeStatsEnabled(true);
+        if (!asClient)
+            svc->SetOpcodeStatsDump(500);
+
+        if (svc->Start() != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+            delete svc;
+            for (int j = 0; j < i; ++j)
+                delete svcs[j];
+
+            return LLBC_FAILED;
+        }
+
+        svcs[i] = svc;
+    }
+
+    if (svcs[1]->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+    else if (svcs[0]->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    delete svcs[0];
+    delete svcs[1];
+
+    return LLBC_OK;
+}
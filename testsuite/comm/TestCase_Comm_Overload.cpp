@@ -0,0 +1,188 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_Overload.h"
+
+namespace
+{
+
+const int OPCODE_NORMAL = 1;
+const int OPCODE_LOW = 2;
+const int PACKET_COUNT = 1000;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7799;
+
+class ClientComp : public LLBC_Component
+{
+public:
+    ClientComp(bool flood)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _flood(flood)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (!_flood)
+            return;
+
+        // Flood normal & low priority packets.
+        const int sessionId = sessionInfo.GetSessionId();
+        for (int i = 0; i < PACKET_COUNT; ++i)
+        {
+            GetService()->Send(sessionId, OPCODE_NORMAL, nullptr);
+            GetService()->Send(sessionId, OPCODE_LOW, nullptr);
+        }
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        if (!_flood)
+            LLBC_PrintLn("Client session destroyed while server overloaded(accept rejected): %s",
+                         destroyInfo.GetReason().c_str());
+    }
+
+private:
+    bool _flood;
+};
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _normalCount(0)
+    , _lowCount(0)
+    {
+    }
+
+public:
+    virtual void OnOverloadChanged(const LLBC_OverloadInfo &info)
+    {
+        LLBC_PrintLn("Server overload changed: %s", info.ToString().c_str());
+    }
+
+public:
+    void OnNormal(LLBC_Packet &packet)
+    {
+        // Slow handler, make service falls behind.
+        ++_normalCount;
+        LLBC_Sleep(1);
+    }
+
+    void OnLow(LLBC_Packet &packet)
+    {
+        ++_lowCount;
+    }
+
+    int GetNormalCount() const { return _normalCount; }
+    int GetLowCount() const { return _lowCount; }
+
+private:
+    volatile int _normalCount;
+    volatile int _lowCount;
+};
+
+}
+
+TestCase_Comm_Overload::TestCase_Comm_Overload()
+{
+}
+
+TestCase_Comm_Overload::~TestCase_Comm_Overload()
+{
+}
+
+int TestCase_Comm_Overload::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service overload protection test:");
+    LLBC_PrintLn("Overload policy repr: %s, parse 'pauseRead|RejectAccept': %d, parse 'Foo': %d",
+                 LLBC_OverloadPolicy::Policy2Str(LLBC_OverloadPolicy::All).c_str(),
+                 LLBC_OverloadPolicy::Str2Policy("pauseRead|RejectAccept"),
+                 LLBC_OverloadPolicy::Str2Policy("Foo"));
+
+    // Create server service, enable all overload policies, low priority opcode will be shed while overloaded.
+    LLBC_Service *server = LLBC_Service::Create("OverloadServer");
+    ServerComp *serverComp = new ServerComp;
+    server->AddComponent(serverComp);
+    server->Subscribe(OPCODE_NORMAL, serverComp, &ServerComp::OnNormal);
+    server->Subscribe(OPCODE_LOW, serverComp, &ServerComp::OnLow);
+    server->SuppressCoderNotFoundWarning();
+    server->SetOpcodePriority(OPCODE_LOW, LLBC_PacketPriority::Low);
+    LLBC_PrintLn("Set invalid overload protection(low watermark >= high watermark), ret: %d",
+                 server->SetOverloadProtection(LLBC_OverloadPolicy::All, 100, 100));
+    server->SetOverloadProtection(LLBC_OverloadPolicy::All, 200, 0, 500);
+
+    // Create flood client service and probe client service.
+    LLBC_Service *client = LLBC_Service::Create("OverloadClient");
+    client->AddComponent(new ClientComp(true));
+    client->SuppressCoderNotFoundWarning();
+
+    LLBC_Service *probeClient = LLBC_Service::Create("OverloadProbeClient");
+    probeClient->AddComponent(new ClientComp(false));
+    probeClient->SuppressCoderNotFoundWarning();
+
+    LLBC_Defer(delete probeClient; delete client; delete server);
+    if (server->Start() != LLBC_OK || client->Start() != LLBC_OK || probeClient->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (server->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (client->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    // Wait server overloaded, then connect probe client, server will close it immediately.
+    for (int i = 0; i < 1000 && !server->IsOverloaded(); ++i)
+        LLBC_Sleep(1);
+    if (server->IsOverloaded())
+        probeClient->Connect(LISTEN_IP, LISTEN_PORT);
+    else
+        LLBC_FilePrintLn(stderr, "Server not overloaded");
+
+    // Wait all normal packets handled(read paused, not lost).
+    for (int i = 0; i < 1000 && serverComp->GetNormalCount() < PACKET_COUNT; ++i)
+        LLBC_Sleep(10);
+    LLBC_Sleep(200);
+
+    LLBC_PrintLn("Server handled normal packets: %d/%d, low packets: %d, shed packets: %llu, overloaded: %s",
+                 serverComp->GetNormalCount(),
+                 PACKET_COUNT,
+                 serverComp->GetLowCount(),
+                 server->GetShedPacketCount(),
+                 server->IsOverloaded() ? "true" : "false");
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
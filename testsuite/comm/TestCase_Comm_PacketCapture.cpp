@@ -0,0 +1,242 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_PacketCapture.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int BATCH_COUNT = 10;
+const int BATCH_SIZE = 20;
+const int BATCH_INTERVAL = 30;
+const int PACKET_COUNT = BATCH_COUNT * BATCH_SIZE;
+const char *CAPTURE_FILE = "TestCase_Comm_PacketCapture.cap";
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7807;
+
+struct TestData : public LLBC_Coder
+{
+    int seq;
+    LLBC_String payload;
+
+    TestData()
+    : seq(0)
+    {
+    }
+
+    virtual bool Encode(LLBC_Packet &packet)
+    {
+        packet <<seq <<payload;
+        return true;
+    }
+
+    virtual bool Decode(LLBC_Packet &packet)
+    {
+        packet >>seq >>payload;
+        return true;
+    }
+
+    virtual void Clear()
+    {
+        seq = 0;
+        payload.clear();
+    }
+};
+
+class TestDataFactory : public LLBC_CoderFactory
+{
+public:
+    virtual LLBC_Coder *Create() const
+    {
+        return new TestData;
+    }
+};
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _recvCount(0)
+    , _seqSum(0)
+    , _sessionId(0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (!sessionInfo.IsListenSession())
+            _sessionId = sessionInfo.GetSessionId();
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        TestData *data = packet.GetDecoder<TestData>();
+        if (data->payload.size() != static_cast<size_t>(data->seq))
+            LLBC_FilePrintLn(stderr, "Packet payload mismatch, seq: %d, payload size: %lu",
+                             data->seq, data->payload.size());
+
+        ++_recvCount;
+        _seqSum += data->seq;
+    }
+
+    void Reset()
+    {
+        _recvCount = 0;
+        _seqSum = 0;
+    }
+
+    int GetRecvCount() const { return _recvCount; }
+    sint64 GetSeqSum() const { return _seqSum; }
+    int GetSessionId() const { return _sessionId; }
+
+private:
+    volatile int _recvCount;
+    volatile sint64 _seqSum;
+    volatile int _sessionId;
+};
+
+}
+
+TestCase_Comm_PacketCapture::TestCase_Comm_PacketCapture()
+{
+}
+
+TestCase_Comm_PacketCapture::~TestCase_Comm_PacketCapture()
+{
+}
+
+int TestCase_Comm_PacketCapture::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Packet capture & replay test:");
+
+    LLBC_Service *server = LLBC_Service::Create("PacketCaptureServer");
+    ServerComp *serverComp = new ServerComp;
+    server->AddComponent(serverComp);
+    server->AddCoderFactory(OPCODE, new TestDataFactory);
+    server->Subscribe(OPCODE, serverComp, &ServerComp::OnRecv);
+
+    LLBC_Service *client = LLBC_Service::Create("PacketCaptureClient");
+    client->AddCoderFactory(OPCODE, new TestDataFactory);
+
+    LLBC_Defer(delete client; delete server; LLBC_File::DeleteFile(CAPTURE_FILE));
+
+    if (server->Start() != LLBC_OK || client->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (server->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    const int sessionId = client->Connect(LISTEN_IP, LISTEN_PORT);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    // Capture live traffic, packets sent in batches.
+    if (server->StartPacketCapture(CAPTURE_FILE) != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start packet capture failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    sint64 expectSeqSum = 0;
+    for (int batch = 0; batch < BATCH_COUNT; ++batch)
+    {
+        for (int i = 0; i < BATCH_SIZE; ++i)
+        {
+            TestData *data = new TestData;
+            data->seq = batch * BATCH_SIZE + i;
+            data->payload.append(data->seq, 'c');
+            expectSeqSum += data->seq;
+
+            client->Send(sessionId, OPCODE, data);
+        }
+
+        LLBC_Sleep(BATCH_INTERVAL);
+    }
+
+    for (int i = 0; i < 500 && serverComp->GetRecvCount() < PACKET_COUNT; ++i)
+        LLBC_Sleep(10);
+    server->StopPacketCapture();
+
+    LLBC_PrintLn("Captured: recv: %d/%d, seq sum: %lld/%lld",
+                 serverComp->GetRecvCount(), PACKET_COUNT, serverComp->GetSeqSum(), expectSeqSum);
+
+    // Read capture file.
+    LLBC_PacketCaptureReader reader;
+    if (reader.Open(CAPTURE_FILE) != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Open capture file failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    int recordCount = 0;
+    sint64 captureDuration = 0;
+    LLBC_PacketCaptureRecord record;
+    while (reader.Read(record) == LLBC_OK)
+    {
+        ++recordCount;
+        captureDuration = record.timestamp;
+    }
+    LLBC_PrintLn("Capture file records: %d, duration: %lld ms, read end: %s",
+                 recordCount, captureDuration / 1000000, LLBC_FormatLastError());
+
+    // Replay capture at different speeds, replay to the still connected session.
+    const double speeds[] = {1.0, 4.0, 0.0};
+    for (auto &speed : speeds)
+    {
+        serverComp->Reset();
+
+        const sint64 beginTime = LLBC_GetMilliSeconds();
+        if (server->ReplayPacketCapture(CAPTURE_FILE, speed, serverComp->GetSessionId()) != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Replay packet capture failed, err: %s", LLBC_FormatLastError());
+            return LLBC_FAILED;
+        }
+
+        for (int i = 0; i < 1000 && (server->IsPacketReplaying() || serverComp->GetRecvCount() < PACKET_COUNT); ++i)
+            LLBC_Sleep(1);
+
+        LLBC_PrintLn("Replay(speed: %.1f): recv: %d/%d, seq sum: %lld/%lld, cost: %lld ms",
+                     speed,
+                     serverComp->GetRecvCount(), PACKET_COUNT,
+                     serverComp->GetSeqSum(), expectSeqSum,
+                     LLBC_GetMilliSeconds() - beginTime);
+    }
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
@@ -138,6 +138,32 @@ int TestCase_Comm_PacketOp::Run(int argc, char *argv[])
     std::cout <<"Delete prehandle test packet" <<std::endl;
     LLBC_XDelete(preHandleTestPacket);
 
+    // Inline payload test.
+    std::cout <<"\nInline payload test(inline payload size: " <<LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE <<"):" <<std::endl;
+    LLBC_Packet inlPacket;
+    inlPacket <<sint32Val <<llbcStr;
+    std::cout <<"After write small payload, payload length: " <<inlPacket.GetPayloadLength() <<std::endl;
+
+    LLBC_String bigStr(LLBC_CFG_COMM_PACKET_INLINE_PAYLOAD_SIZE * 2, 'x');
+    inlPacket <<bigStr;
+    std::cout <<"After write big payload(spill to message block), payload length: "
+        <<inlPacket.GetPayloadLength() <<std::endl;
+
+    sint32 inlSint32Val = 0;
+    LLBC_String inlLLBCStr, inlBigStr;
+    inlPacket >>inlSint32Val >>inlLLBCStr >>inlBigStr;
+    std::cout <<"Packet::Read(): sint32Val: " <<inlSint32Val <<", LLBC_String: " <<inlLLBCStr
+        <<", big string match: " <<(inlBigStr == bigStr ? "true" : "false") <<std::endl;
+
+    LLBC_Packet inlPacket2;
+    inlPacket2 <<uint64Val;
+    LLBC_MessageBlock *givenUpPayload = inlPacket2.GiveUpPayload();
+    std::cout <<"Giveup inline payload, readable size: " <<givenUpPayload->GetReadableSize()
+        <<", packet payload length: " <<inlPacket2.GetPayloadLength() <<std::endl;
+    LLBC_Recycle(givenUpPayload);
+    inlPacket2 <<longVal;
+    std::cout <<"Rewrite after giveup, payload length: " <<inlPacket2.GetPayloadLength() <<std::endl;
+
     // Stream output test.
     std::cout <<"\nPacket stream output test:" <<std::endl;
     LLBC_Packet streamOutputTest;
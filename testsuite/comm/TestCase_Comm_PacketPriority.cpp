@@ -0,0 +1,138 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_PacketPriority.h"
+
+namespace
+{
+
+const int OPCODE_BULK = 1;
+const int OPCODE_ADMIN = 2;
+const int BULK_COUNT = 20000;
+const int LOW_PRIORITY_BUDGET = 500;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7798;
+
+class ClientComp : public LLBC_Component
+{
+public:
+    ClientComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        // Flood bulk packets, then send admin packet.
+        const int sessionId = sessionInfo.GetSessionId();
+        for (int i = 0; i < BULK_COUNT; ++i)
+            GetService()->Send(sessionId, OPCODE_BULK, nullptr);
+        GetService()->Send(sessionId, OPCODE_ADMIN, nullptr);
+    }
+};
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _bulkCount(0)
+    {
+    }
+
+public:
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        LLBC_PrintLn("Server session destroyed, handled bulk packets: %d, pending low priority packets: %lu",
+                     _bulkCount, GetService()->GetPendingPacketCount(LLBC_PacketPriority::Low));
+    }
+
+public:
+    void OnBulk(LLBC_Packet &packet)
+    {
+        ++_bulkCount;
+    }
+
+    void OnAdmin(LLBC_Packet &packet)
+    {
+        // Admin packet handled before flooded bulk packets.
+        LLBC_PrintLn("Server handled admin packet, handled bulk packets: %d, pending low priority packets: %lu",
+                     _bulkCount, GetService()->GetPendingPacketCount(LLBC_PacketPriority::Low));
+    }
+
+private:
+    int _bulkCount;
+};
+
+}
+
+TestCase_Comm_PacketPriority::TestCase_Comm_PacketPriority()
+{
+}
+
+TestCase_Comm_PacketPriority::~TestCase_Comm_PacketPriority()
+{
+}
+
+int TestCase_Comm_PacketPriority::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service packet priority lanes test:");
+
+    // Create server service, admin packet high priority, bulk packet low priority and limit per-frame budget.
+    LLBC_Service *server = LLBC_Service::Create("PacketPriorityServer");
+    ServerComp *serverComp = new ServerComp;
+    server->AddComponent(serverComp);
+    server->Subscribe(OPCODE_BULK, serverComp, &ServerComp::OnBulk);
+    server->Subscribe(OPCODE_ADMIN, serverComp, &ServerComp::OnAdmin);
+    server->SuppressCoderNotFoundWarning();
+    server->SetOpcodePriority(OPCODE_ADMIN, LLBC_PacketPriority::High);
+    server->SetOpcodePriority(OPCODE_BULK, LLBC_PacketPriority::Low);
+    server->SetPriorityBudget(LLBC_PacketPriority::Low, LOW_PRIORITY_BUDGET);
+    LLBC_PrintLn("Set invalid priority, ret: %d", server->SetOpcodePriority(OPCODE_BULK, -1));
+
+    // Create client service.
+    LLBC_Service *client = LLBC_Service::Create("PacketPriorityClient");
+    client->AddComponent(new ClientComp);
+    client->SuppressCoderNotFoundWarning();
+
+    LLBC_Defer(delete client; delete server);
+    if (server->Start() != LLBC_OK || client->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (server->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+    else if (client->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+
+    // Stop client after all packets sent, server pending bulk packets will be handled before session destroy event.
+    LLBC_Sleep(1000);
+    client->Stop();
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
@@ -0,0 +1,215 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_PollPoller.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int SESSION_COUNT = 64;
+const int PACKET_COUNT = 100;
+const char *POLLER_MODEL = "PollPoller";
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7804;
+
+struct EchoData : public LLBC_Coder
+{
+    int seq;
+    LLBC_String payload;
+
+    EchoData()
+    : seq(0)
+    {
+    }
+
+    virtual bool Encode(LLBC_Packet &packet)
+    {
+        packet <<seq <<payload;
+        return true;
+    }
+
+    virtual bool Decode(LLBC_Packet &packet)
+    {
+        packet >>seq >>payload;
+        return true;
+    }
+
+    virtual void Clear()
+    {
+        seq = 0;
+        payload.clear();
+    }
+};
+
+class EchoDataFactory : public LLBC_CoderFactory
+{
+public:
+    virtual LLBC_Coder *Create() const
+    {
+        return new EchoData;
+    }
+};
+
+class ClientComp : public LLBC_Component
+{
+public:
+    ClientComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _connectedCount(0)
+    , _echoCount(0)
+    {
+    }
+
+public:
+    virtual void OnAsyncConnResult(const LLBC_AsyncConnResult &result)
+    {
+        if (!result.IsConnected())
+            LLBC_PrintLn("Async connect failed, reason: %s", result.GetReason().c_str());
+    }
+
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        ++_connectedCount;
+
+        // Send large payloads, make sure socket send buffer full and writable event watched.
+        for (int i = 0; i < PACKET_COUNT; ++i)
+        {
+            EchoData *data = new EchoData;
+            data->seq = i;
+            data->payload.append(4096, 'x');
+            GetService()->Send(sessionInfo.GetSessionId(), OPCODE, data);
+        }
+    }
+
+public:
+    void OnEcho(LLBC_Packet &packet)
+    {
+        ++_echoCount;
+    }
+
+    int GetConnectedCount() const { return _connectedCount; }
+    int GetEchoCount() const { return _echoCount; }
+
+private:
+    volatile int _connectedCount;
+    volatile int _echoCount;
+};
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        EchoData *recvData = packet.GetDecoder<EchoData>();
+        EchoData *data = new EchoData;
+        data->seq = recvData->seq;
+        data->payload = recvData->payload;
+        GetService()->Send(packet.GetSessionId(), OPCODE, data);
+    }
+};
+
+}
+
+TestCase_Comm_PollPoller::TestCase_Comm_PollPoller()
+{
+}
+
+TestCase_Comm_PollPoller::~TestCase_Comm_PollPoller()
+{
+}
+
+int TestCase_Comm_PollPoller::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Poll poller test:");
+
+    LLBC_Service *server = LLBC_Service::Create("PollPollerServer");
+    ServerComp *serverComp = new ServerComp;
+    server->AddComponent(serverComp);
+    server->AddCoderFactory(OPCODE, new EchoDataFactory);
+    server->Subscribe(OPCODE, serverComp, &ServerComp::OnRecv);
+
+    LLBC_Service *client = LLBC_Service::Create("PollPollerClient");
+    ClientComp *clientComp = new ClientComp;
+    client->AddComponent(clientComp);
+    client->AddCoderFactory(OPCODE, new EchoDataFactory);
+    client->Subscribe(OPCODE, clientComp, &ClientComp::OnEcho);
+
+    LLBC_Defer(delete client; delete server);
+
+    // Invalid poller model will be rejected.
+    const int ret = server->SetPollerModel("NotExistPoller");
+    LLBC_PrintLn("Set invalid poller model, ret: %d, err: %s", ret, LLBC_FormatLastError());
+
+    if (server->SetPollerModel(POLLER_MODEL) != LLBC_OK ||
+        client->SetPollerModel(POLLER_MODEL) != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Set poller model failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (server->Start(2) != LLBC_OK || client->Start(2) != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    LLBC_PrintLn("Server poller model: %s, client poller model: %s",
+                 server->GetPollerModel().c_str(), client->GetPollerModel().c_str());
+
+    if (server->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    // Async connect, test non-blocking connect completion in poll poller.
+    for (int i = 0; i < SESSION_COUNT; ++i)
+    {
+        if (client->AsyncConn(LISTEN_IP, LISTEN_PORT) == 0)
+        {
+            LLBC_FilePrintLn(stderr, "Async connect failed, err: %s", LLBC_FormatLastError());
+            return LLBC_FAILED;
+        }
+    }
+
+    // Wait all packets echoed.
+    const int totalPackets = SESSION_COUNT * PACKET_COUNT;
+    for (int i = 0; i < 1000 && clientComp->GetEchoCount() < totalPackets; ++i)
+        LLBC_Sleep(10);
+
+    LLBC_PrintLn("Connected sessions: %d/%d, echoed packets: %d/%d",
+                 clientComp->GetConnectedCount(), SESSION_COUNT,
+                 clientComp->GetEchoCount(), totalPackets);
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
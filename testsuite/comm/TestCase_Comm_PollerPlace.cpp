@@ -0,0 +1,181 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_PollerPlace.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int PING_TIMES = 5;
+const int POLLER_COUNT = 4;
+const int CLIENT_COUNT = 8;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7791;
+
+class TestComp : public LLBC_Component
+{
+public:
+    TestComp(bool asClient)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _asClient(asClient)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (_asClient && !sessionInfo.IsListenSession())
+            SendPing(sessionInfo.GetSessionId(), 1);
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        LLBC_PrintLn("[%s]Session destroy: %s",
+                     GetService()->GetName().c_str(), destroyInfo.ToString().c_str());
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        int seq;
+        packet >>seq;
+
+        const int sessionId = packet.GetSessionId();
+        if (!_asClient)
+        {
+            // Pong first, then migrate session to next poller, all later pings will handle by new poller.
+            SendPing(sessionId, seq);
+            if (seq == 2)
+            {
+                const int toPollerIdx = (sessionId + 1) % GetService()->GetPollerCount();
+                LLBC_PrintLn("[%s]Migrate session %d to poller %d, ret: %d",
+                             GetService()->GetName().c_str(),
+                             sessionId,
+                             toPollerIdx,
+                             GetService()->MigrateSession(sessionId, toPollerIdx));
+            }
+
+            return;
+        }
+
+        if (seq < PING_TIMES)
+        {
+            SendPing(sessionId, seq + 1);
+        }
+        else
+        {
+            LLBC_PrintLn("[%s]Session %d ping finished", GetService()->GetName().c_str(), sessionId);
+            GetService()->RemoveSession(sessionId, "Ping finished");
+        }
+    }
+
+private:
+    void SendPing(int sessionId, int seq)
+    {
+        LLBC_Packet *packet = GetService()->GetPacketObjectPool().GetObject();
+        packet->SetHeader(sessionId, OPCODE, 0);
+        *packet <<seq;
+
+        GetService()->Send(packet);
+    }
+
+private:
+    bool _asClient;
+};
+
+}
+
+TestCase_Comm_PollerPlace::TestCase_Comm_PollerPlace()
+{
+}
+
+TestCase_Comm_PollerPlace::~TestCase_Comm_PollerPlace()
+{
+}
+
+int TestCase_Comm_PollerPlace::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Poller place policy & session migrate test:");
+
+    // Create client & server services, server use LeastSessions place policy.
+    LLBC_Service *svcs[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        const bool asClient = i == 0;
+        LLBC_Service *svc = LLBC_Service::Create(asClient ? "PlaceClient" : "PlaceServer");
+
+        TestComp *comp = new TestComp(asClient);
+        svc->AddComponent(comp);
+        svc->Subscribe(OPCODE, comp, &TestComp::OnRecv);
+        svc->SuppressCoderNotFoundWarning();
+        if (!asClient)
+            svc->SetPollerPlacePolicy(LLBC_PollerPlacePolicy::LeastSessions);
+
+        if (svc->Start(POLLER_COUNT) != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+            delete svc;
+            for (int j = 0; j < i; ++j)
+                delete svcs[j];
+
+            return LLBC_FAILED;
+        }
+
+        svcs[i] = svc;
+    }
+
+    // Listen & connect, after every round ping finished, change server poller count(shrink then grow),
+    // the listen session will be migrated when shrink, next round connections must be accepted still.
+    if (svcs[1]->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+    }
+    else
+    {
+        const int roundPollerCounts[] = {1, POLLER_COUNT, 0};
+        for (int round = 0; ; ++round)
+        {
+            for (int i = 0; i < CLIENT_COUNT; ++i)
+            {
+                if (svcs[0]->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+                    LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+            }
+
+            LLBC_Sleep(1000);
+            if (roundPollerCounts[round] == 0)
+                break;
+
+            const int ret = svcs[1]->SetPollerCount(roundPollerCounts[round]);
+            LLBC_PrintLn("Set server poller count to %d, ret: %d, now poller count: %d",
+                         roundPollerCounts[round], ret, svcs[1]->GetPollerCount());
+        }
+    }
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    delete svcs[0];
+    delete svcs[1];
+
+    return LLBC_OK;
+}
@@ -0,0 +1,147 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_QueueStats.h"
+
+namespace
+{
+
+const int OPCODE_PING = 1;
+const int PING_TIMES = 1000;
+const int PIPELINE_SIZE = 10;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7796;
+
+class TestComp : public LLBC_Component
+{
+public:
+    TestComp(bool asClient)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _asClient(asClient)
+    , _recvTimes(0)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        // Client pipeline send pings, make queues have backlog.
+        if (_asClient && !sessionInfo.IsListenSession())
+        {
+            for (int i = 0; i < PIPELINE_SIZE; ++i)
+                GetService()->Send(sessionInfo.GetSessionId(), OPCODE_PING, nullptr);
+        }
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        const int sessionId = packet.GetSessionId();
+        if (!_asClient)
+        {
+            GetService()->Send(sessionId, OPCODE_PING, nullptr);
+        }
+        else if (++_recvTimes < PING_TIMES)
+        {
+            GetService()->Send(sessionId, OPCODE_PING, nullptr);
+        }
+        else
+        {
+            DumpStats();
+            GetService()->RemoveSession(sessionId, "Ping finished");
+        }
+    }
+
+private:
+    void DumpStats()
+    {
+        LLBC_QueueStat svcStat;
+        std::vector<LLBC_QueueStat> pollerStats;
+        GetService()->GetQueueStats(svcStat, pollerStats);
+
+        LLBC_PrintLn("[%s]service queue: %s", GetService()->GetName().c_str(), svcStat.ToString().c_str());
+        for (size_t pollerIdx = 0; pollerIdx != pollerStats.size(); ++pollerIdx)
+            LLBC_PrintLn("[%s]poller %lu queue: %s",
+                         GetService()->GetName().c_str(), pollerIdx, pollerStats[pollerIdx].ToString().c_str());
+    }
+
+private:
+    bool _asClient;
+    int _recvTimes;
+};
+
+}
+
+TestCase_Comm_QueueStats::TestCase_Comm_QueueStats()
+{
+}
+
+TestCase_Comm_QueueStats::~TestCase_Comm_QueueStats()
+{
+}
+
+int TestCase_Comm_QueueStats::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service & poller queue statistics test:");
+
+    // Create client & server services, server dump queue statistics every 500 milli-seconds.
+    LLBC_Service *svcs[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        const bool asClient = i == 0;
+        LLBC_Service *svc = LLBC_Service::Create(asClient ? "QueueStatsClient" : "QueueStatsServer");
+
+        TestComp *comp = new TestComp(asClient);
+        svc->AddComponent(comp);
+        svc->Subscribe(OPCODE_PING, comp, &TestComp::OnRecv);
+        svc->SuppressCoderNotFoundWarning();
+        svc->SetQueueStatsEnabled(true);
+        if (!asClient)
+            svc->SetQueueStatsDump(500);
+
+        if (svc->Start(2) != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+            delete svc;
+            for (int j = 0; j < i; ++j)
+                delete svcs[j];
+
+            return LLBC_FAILED;
+        }
+
+        svcs[i] = svc;
+    }
+
+    if (svcs[1]->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+    else if (svcs[0]->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    delete svcs[0];
+    delete svcs[1];
+
+    return LLBC_OK;
+}
@@ -0,0 +1,141 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_RecvBudget.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int FLOOD_PACKETS = 256;
+const size_t FLOOD_PACKET_SIZE = 4096;
+const int NORMAL_CLIENT_COUNT = 4;
+const size_t RECV_BUDGET = 1024;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7792;
+
+class TestComp : public LLBC_Component
+{
+public:
+    TestComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    {
+    }
+
+public:
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        LLBC_PrintLn("[%s]Session destroy: %s",
+                     GetService()->GetName().c_str(), destroyInfo.ToString().c_str());
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        // Print first packet and flood finished packet only.
+        const int sessionId = packet.GetSessionId();
+        const int recvedCount = ++_recvedCounts[sessionId];
+        if (recvedCount == 1 || recvedCount == FLOOD_PACKETS)
+            LLBC_PrintLn("[%s]Session %d recved %d packets, payload length: %lu",
+                         GetService()->GetName().c_str(),
+                         sessionId,
+                         recvedCount,
+                         packet.GetPayloadLength());
+    }
+
+private:
+    std::map<int, int> _recvedCounts;
+};
+
+}
+
+TestCase_Comm_RecvBudget::TestCase_Comm_RecvBudget()
+{
+}
+
+TestCase_Comm_RecvBudget::~TestCase_Comm_RecvBudget()
+{
+}
+
+int TestCase_Comm_RecvBudget::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Session recv budget test:");
+
+    // Create server service, server sessions recv budget is very small, flooding session will be read many times.
+    LLBC_Service *server = LLBC_Service::Create("BudgetServer");
+    TestComp *comp = new TestComp;
+    server->AddComponent(comp);
+    server->Subscribe(OPCODE, comp, &TestComp::OnRecv);
+    server->SuppressCoderNotFoundWarning();
+
+    LLBC_SessionOpts sessionOpts;
+    sessionOpts.SetRecvBudget(RECV_BUDGET);
+    if (server->Listen(LISTEN_IP, LISTEN_PORT, nullptr, sessionOpts) == 0 ||
+        server->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start server failed, err: %s", LLBC_FormatLastError());
+        delete server;
+
+        return LLBC_FAILED;
+    }
+
+    // Create client service, flood packets in one session, and send one packet in other sessions.
+    LLBC_Service *client = LLBC_Service::Create("BudgetClient");
+    client->SuppressCoderNotFoundWarning();
+    if (client->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start client failed, err: %s", LLBC_FormatLastError());
+        delete client;
+        delete server;
+
+        return LLBC_FAILED;
+    }
+
+    const int floodSessionId = client->Connect(LISTEN_IP, LISTEN_PORT);
+    if (floodSessionId == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+    }
+    else
+    {
+        char floodData[FLOOD_PACKET_SIZE];
+        memset(floodData, 'F', sizeof(floodData));
+        for (int i = 0; i < FLOOD_PACKETS; ++i)
+            client->Send(floodSessionId, OPCODE, floodData, sizeof(floodData));
+
+        for (int i = 0; i < NORMAL_CLIENT_COUNT; ++i)
+        {
+            const int sessionId = client->Connect(LISTEN_IP, LISTEN_PORT);
+            if (sessionId != 0)
+                client->Send(sessionId, OPCODE, "Hello", 6);
+        }
+    }
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    delete client;
+    delete server;
+
+    return LLBC_OK;
+}
@@ -0,0 +1,199 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_Rpc.h"
+
+namespace
+{
+
+const int OPCODE_REQ = 1;
+const int OPCODE_RSP = 2;
+const int CALL_COUNT = 100;
+const int DROP_CALL_COUNT = 5;
+const int CALL_TIMEOUT = 500;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7801;
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    {
+    }
+
+public:
+    void OnRequest(LLBC_Packet &packet)
+    {
+        // Don't reply every 10th request, make these calls timeout.
+        int seq;
+        memcpy(&seq, packet.GetPayload(), sizeof(seq));
+        if (seq % 10 == 9)
+            return;
+
+        GetService()->Reply(packet, OPCODE_RSP, &seq, sizeof(seq));
+    }
+};
+
+class ClientComp : public LLBC_Component
+{
+public:
+    ClientComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _okCount(0)
+    , _mismatchCount(0)
+    , _timeoutCount(0)
+    , _sessionDestroyedCount(0)
+    , _finished(false)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        // Pipeline all calls, no need wait for previous call responded.
+        for (int seq = 0; seq < CALL_COUNT; ++seq)
+        {
+            const sint64 callId = GetService()->Call(
+                sessionInfo.GetSessionId(), OPCODE_REQ, &seq, sizeof(seq),
+                [this, seq](const LLBC_RpcResult &result) { OnCallFinished(result, seq); },
+                CALL_TIMEOUT);
+            if (callId == 0)
+                LLBC_FilePrintLn(stderr, "Call failed, err: %s", LLBC_FormatLastError());
+        }
+
+        LLBC_PrintLn("Client issued %d calls, pending calls: %lu",
+                     CALL_COUNT, GetService()->GetPendingCallCount());
+    }
+
+public:
+    bool IsFinished() const { return _finished; }
+    void PrintResult() const
+    {
+        LLBC_PrintLn("Rpc calls finished, ok: %d, mismatch: %d, timeout: %d, session destroyed: %d",
+                     _okCount, _mismatchCount, _timeoutCount, _sessionDestroyedCount);
+    }
+
+private:
+    void OnCallFinished(const LLBC_RpcResult &result, int seq)
+    {
+        if (result.IsOk())
+        {
+            int rspSeq;
+            memcpy(&rspSeq, result.response->GetPayload(), sizeof(rspSeq));
+            if (rspSeq == seq && result.response->GetOpcode() == OPCODE_RSP)
+                ++_okCount;
+            else
+                ++_mismatchCount;
+        }
+        else if (result.status == LLBC_RpcStatus::Timeout)
+        {
+            LLBC_PrintLn("Call timeout: %s", result.ToString().c_str());
+            ++_timeoutCount;
+        }
+        else if (result.status == LLBC_RpcStatus::SessionDestroyed)
+        {
+            ++_sessionDestroyedCount;
+        }
+
+        if (_okCount + _mismatchCount + _timeoutCount == CALL_COUNT &&
+            _sessionDestroyedCount == 0)
+        {
+            // All pipelined calls finished, issue some calls and remove session immediately.
+            for (int i = 0; i < DROP_CALL_COUNT; ++i)
+                GetService()->Call(result.sessionId, OPCODE_REQ, &i, sizeof(i),
+                                   [this](const LLBC_RpcResult &result) { OnCallFinished(result, -1); });
+            GetService()->RemoveSession(result.sessionId, "Rpc test finished");
+        }
+        else if (_sessionDestroyedCount == DROP_CALL_COUNT)
+        {
+            _finished = true;
+        }
+    }
+
+private:
+    int _okCount;
+    int _mismatchCount;
+    int _timeoutCount;
+    int _sessionDestroyedCount;
+    volatile bool _finished;
+};
+
+}
+
+TestCase_Comm_Rpc::TestCase_Comm_Rpc()
+{
+}
+
+TestCase_Comm_Rpc::~TestCase_Comm_Rpc()
+{
+}
+
+int TestCase_Comm_Rpc::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service rpc test:");
+
+    LLBC_Service *server = LLBC_Service::Create("RpcServer");
+    ServerComp *serverComp = new ServerComp;
+    server->AddComponent(serverComp);
+    server->Subscribe(OPCODE_REQ, serverComp, &ServerComp::OnRequest);
+    server->SuppressCoderNotFoundWarning();
+
+    LLBC_Service *client = LLBC_Service::Create("RpcClient");
+    ClientComp *clientComp = new ClientComp;
+    client->AddComponent(clientComp);
+    client->SuppressCoderNotFoundWarning();
+
+    LLBC_Defer(delete client; delete server);
+
+    // Call before service started will failed.
+    const sint64 callId = client->Call(1, OPCODE_REQ, nullptr, 0, [](const LLBC_RpcResult &) {});
+    LLBC_PrintLn("Call before service started, callId: %lld, err: %s", callId, LLBC_FormatLastError());
+
+    if (server->Start() != LLBC_OK || client->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (server->Listen(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (client->Connect(LISTEN_IP, LISTEN_PORT) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    for (int i = 0; i < 300 && !clientComp->IsFinished(); ++i)
+        LLBC_Sleep(10);
+
+    clientComp->PrintResult();
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
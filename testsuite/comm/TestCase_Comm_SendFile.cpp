@@ -0,0 +1,208 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+
+#include "comm/TestCase_Comm_SendFile.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int FILE_SIZE = 4 * 1024 * 1024 + 123;
+const int REGION_OFFSET = 100;
+const int REGION_LENGTH = FILE_SIZE - REGION_OFFSET;
+const char *FILE_NAME = "TestCase_Comm_SendFile.dat";
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7805;
+
+char FileByte(int pos)
+{
+    return static_cast<char>((pos * 31 + 7) & 0xff);
+}
+
+class ServerComp : public LLBC_Component
+{
+public:
+    ServerComp(int fd)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _fd(fd)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        if (sessionInfo.IsListenSession())
+            return;
+
+        if (GetService()->SendFile(sessionInfo.GetSessionId(),
+                                   OPCODE,
+                                   _fd,
+                                   REGION_OFFSET,
+                                   REGION_LENGTH) != LLBC_OK)
+            LLBC_FilePrintLn(stderr, "Send file failed, err: %s", LLBC_FormatLastError());
+    }
+
+private:
+    int _fd;
+};
+
+class ClientComp : public LLBC_Component
+{
+public:
+    ClientComp()
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _recved(false)
+    , _verified(false)
+    {
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        const char *payload = reinterpret_cast<const char *>(packet.GetPayload());
+        bool verified = packet.GetPayloadLength() == static_cast<size_t>(REGION_LENGTH);
+        for (int i = 0; verified && i < REGION_LENGTH; ++i)
+            verified = payload[i] == FileByte(REGION_OFFSET + i);
+
+        LLBC_PrintLn("Recv file region packet, payload len: %lu, verified: %s",
+                     packet.GetPayloadLength(), verified ? "true" : "false");
+
+        _verified = verified;
+        _recved = true;
+    }
+
+    bool IsRecved() const { return _recved; }
+    bool IsVerified() const { return _verified; }
+
+private:
+    volatile bool _recved;
+    volatile bool _verified;
+};
+
+}
+
+TestCase_Comm_SendFile::TestCase_Comm_SendFile()
+{
+}
+
+TestCase_Comm_SendFile::~TestCase_Comm_SendFile()
+{
+}
+
+int TestCase_Comm_SendFile::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Send file test:");
+
+#if LLBC_TARGET_PLATFORM_WIN32
+    LLBC_PrintLn("Send file not support in WIN32 platform");
+#else // Non-Win32
+    // Prepare test file.
+    LLBC_String content;
+    content.resize(FILE_SIZE);
+    for (int i = 0; i < FILE_SIZE; ++i)
+        content[i] = FileByte(i);
+
+    LLBC_File file;
+    if (file.Open(FILE_NAME, LLBC_FileMode::BinaryWrite) != LLBC_OK ||
+        file.Write(content.data(), content.size()) != static_cast<long>(content.size()))
+    {
+        LLBC_FilePrintLn(stderr, "Prepare test file failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+    file.Close();
+
+    // Normal protocol stack, file region will be sent by sendfile().
+    int ret = Run("SendFile", new LLBC_NormalProtocolFactory, new LLBC_NormalProtocolFactory, LISTEN_PORT);
+    // Compact protocol stack not support file region header, will fallback to chunked read.
+    if (ret == LLBC_OK)
+        ret = Run("ChunkedSendFile", new LLBC_CompactProtocolFactory, new LLBC_CompactProtocolFactory, LISTEN_PORT + 1);
+
+    LLBC_File::DeleteFile(FILE_NAME);
+    if (ret != LLBC_OK)
+        return LLBC_FAILED;
+#endif // LLBC_TARGET_PLATFORM_WIN32
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    return LLBC_OK;
+}
+
+int TestCase_Comm_SendFile::Run(const char *name,
+                                LLBC_IProtocolFactory *serverProtoFactory,
+                                LLBC_IProtocolFactory *clientProtoFactory,
+                                uint16 port)
+{
+#if LLBC_TARGET_PLATFORM_NON_WIN32
+    // File will be dup() in SendFile(), keep file opened until service stopped is enough.
+    LLBC_File file;
+    if (file.Open(FILE_NAME, LLBC_FileMode::BinaryRead) != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Open test file failed, err: %s", LLBC_FormatLastError());
+        delete serverProtoFactory;
+        delete clientProtoFactory;
+
+        return LLBC_FAILED;
+    }
+
+    LLBC_Service *server = LLBC_Service::Create(LLBC_String().format("%sServer", name), serverProtoFactory);
+    server->AddComponent(new ServerComp(file.GetFileNo()));
+    server->SuppressCoderNotFoundWarning();
+
+    LLBC_Service *client = LLBC_Service::Create(LLBC_String().format("%sClient", name), clientProtoFactory);
+    ClientComp *clientComp = new ClientComp;
+    client->AddComponent(clientComp);
+    client->Subscribe(OPCODE, clientComp, &ClientComp::OnRecv);
+    client->SuppressCoderNotFoundWarning();
+
+    LLBC_Defer(delete client; delete server);
+
+    if (server->Start() != LLBC_OK || client->Start() != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (server->Listen(LISTEN_IP, port) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    if (client->Connect(LISTEN_IP, port) == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Connect failed, err: %s", LLBC_FormatLastError());
+        return LLBC_FAILED;
+    }
+
+    for (int i = 0; i < 500 && !clientComp->IsRecved(); ++i)
+        LLBC_Sleep(10);
+
+    LLBC_PrintLn("%s: recved: %s, verified: %s",
+                 name,
+                 clientComp->IsRecved() ? "true" : "false",
+                 clientComp->IsVerified() ? "true" : "false");
+#endif // LLBC_TARGET_PLATFORM_NON_WIN32
+
+    return LLBC_OK;
+}
@@ -0,0 +1,134 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_ThreadCfg.h"
+
+#if LLBC_TARGET_PLATFORM_LINUX
+ #include <dirent.h>
+#endif // Linux
+
+namespace
+{
+
+void DumpThreads(const char *namePrefix)
+{
+#if LLBC_TARGET_PLATFORM_LINUX
+    DIR *taskDir = opendir("/proc/self/task");
+    if (!taskDir)
+        return;
+
+    struct dirent *ent;
+    while ((ent = readdir(taskDir)) != nullptr)
+    {
+        if (ent->d_name[0] == '.')
+            continue;
+
+        char threadName[32] = {0};
+        FILE *commFile = fopen(LLBC_String().format("/proc/self/task/%s/comm", ent->d_name).c_str(), "r");
+        if (!commFile)
+            continue;
+        if (!fgets(threadName, sizeof(threadName), commFile))
+            threadName[0] = '\0';
+        fclose(commFile);
+
+        LLBC_String name(threadName);
+        name.strip();
+        if (!name.startswith(namePrefix))
+            continue;
+
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        LLBC_String cpus;
+        if (sched_getaffinity(atoi(ent->d_name), sizeof(cpuSet), &cpuSet) == 0)
+        {
+            for (int cpu = 0; cpu < 64; ++cpu)
+            {
+                if (CPU_ISSET(cpu, &cpuSet))
+                    cpus.append_format("%s%d", cpus.empty() ? "" : ",", cpu);
+            }
+        }
+
+        LLBC_PrintLn("  thread %s: name: %s, cpus: %s", ent->d_name, name.c_str(), cpus.c_str());
+    }
+
+    closedir(taskDir);
+#else // Non-Linux
+    LLBC_PrintLn("  Dump threads only support in linux platform");
+#endif // LLBC_TARGET_PLATFORM_LINUX
+}
+
+}
+
+TestCase_Comm_ThreadCfg::TestCase_Comm_ThreadCfg()
+{
+}
+
+TestCase_Comm_ThreadCfg::~TestCase_Comm_ThreadCfg()
+{
+}
+
+int TestCase_Comm_ThreadCfg::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service & poller thread name/cpu affinity test:");
+
+    // Cpu mask parse test.
+    const char *cpuLists[] = {"0-3,6", "0x4f", "1, 3", "3-1", "64", "abc"};
+    for (auto &cpuList : cpuLists)
+    {
+        uint64 cpuMask;
+        const int ret = LLBC_ParseCPUMask(cpuList, cpuMask);
+        LLBC_PrintLn("Parse cpu list [%s], ret: %d, mask: 0x%llx",
+                     cpuList, ret, static_cast<unsigned long long>(cpuMask));
+    }
+
+    // Create service, set service thread name/cpu affinity, poller threads name prefix/cpu affinity(spread to cpu 0,1).
+    LLBC_Service *svc = LLBC_Service::Create("ThreadCfgTest");
+    svc->SetThreadName("tc_svc");
+    svc->SetCPUAffinity(0x1);
+    svc->SetPollerThreadName("tc_poller");
+    svc->SetPollerCPUAffinity(0x3, true);
+    if (svc->Start(2) != LLBC_OK)
+    {
+        LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+        delete svc;
+
+        return LLBC_FAILED;
+    }
+
+    // Set thread name after service started, must failed.
+    const int ret = svc->SetThreadName("tc_svc2");
+    LLBC_PrintLn("Set thread name after service started, ret: %d, err: %s", ret, LLBC_FormatLastError());
+
+    // Grow poller count, new poller also use poller thread settings.
+    svc->SetPollerCount(3);
+    LLBC_Sleep(200);
+
+    LLBC_PrintLn("Service & poller threads:");
+    DumpThreads("tc_");
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    delete svc;
+
+    return LLBC_OK;
+}
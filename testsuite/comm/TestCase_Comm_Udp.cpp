@@ -0,0 +1,192 @@
+// The MIT License (MIT)
+
+// Copyright (c) 2013 lailongwei<lailongwei@126.com>
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy of 
+// this software and associated documentation files (the "Software"), to deal in 
+// the Software without restriction, including without limitation the rights to 
+// use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of 
+// the Software, and to permit persons to whom the Software is furnished to do so, 
+// subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in all 
+// copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS 
+// FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR 
+// COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER 
+// IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN 
+// CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+
+
+#include "comm/TestCase_Comm_Udp.h"
+
+namespace
+{
+
+const int OPCODE = 1;
+const int PING_TIMES = 5;
+const char *LISTEN_IP = "127.0.0.1";
+const uint16 LISTEN_PORT = 7790;
+
+struct PingData : public LLBC_Coder
+{
+    int seq;
+    LLBC_String msg;
+
+    PingData()
+    : seq(0)
+    {
+    }
+
+    virtual bool Encode(LLBC_Packet &packet)
+    {
+        packet <<seq <<msg;
+        return true;
+    }
+
+    virtual bool Decode(LLBC_Packet &packet)
+    {
+        packet >>seq >>msg;
+        return true;
+    }
+
+    virtual void Clear()
+    {
+        seq = 0;
+        msg.clear();
+    }
+};
+
+class PingDataFactory : public LLBC_CoderFactory
+{
+public:
+    virtual LLBC_Coder *Create() const
+    {
+        return new PingData;
+    }
+};
+
+class TestComp : public LLBC_Component
+{
+public:
+    TestComp(bool asClient)
+    : LLBC_Component(LLBC_ComponentEvents::DefaultEvents)
+    , _asClient(asClient)
+    {
+    }
+
+public:
+    virtual void OnSessionCreate(const LLBC_SessionInfo &sessionInfo)
+    {
+        LLBC_PrintLn("[%s]Udp session create: %s",
+                     GetService()->GetName().c_str(), sessionInfo.ToString().c_str());
+        if (_asClient && !sessionInfo.IsListenSession())
+            SendPing(sessionInfo.GetSessionId(), 1);
+    }
+
+    virtual void OnSessionDestroy(const LLBC_SessionDestroyInfo &destroyInfo)
+    {
+        LLBC_PrintLn("[%s]Udp session destroy: %s",
+                     GetService()->GetName().c_str(), destroyInfo.ToString().c_str());
+    }
+
+public:
+    void OnRecv(LLBC_Packet &packet)
+    {
+        PingData *data = packet.GetDecoder<PingData>();
+        LLBC_PrintLn("[%s]Session[%d] recv packet, from svc: %d, seq: %d, msg: %s",
+                     GetService()->GetName().c_str(),
+                     packet.GetSessionId(),
+                     packet.GetSenderServiceId(),
+                     data->seq,
+                     data->msg.c_str());
+
+        if (!_asClient)
+        {
+            SendPing(packet.GetSessionId(), data->seq);
+            return;
+        }
+
+        if (data->seq < PING_TIMES)
+            SendPing(packet.GetSessionId(), data->seq + 1);
+        else
+            GetService()->RemoveSession(packet.GetSessionId(), "Ping finished");
+    }
+
+private:
+    void SendPing(int sessionId, int seq)
+    {
+        PingData *data = new PingData;
+        data->seq = seq;
+        data->msg = _asClient ? "ping" : "pong";
+
+        GetService()->Send(sessionId, OPCODE, data);
+    }
+
+private:
+    bool _asClient;
+};
+
+}
+
+TestCase_Comm_Udp::TestCase_Comm_Udp()
+{
+}
+
+TestCase_Comm_Udp::~TestCase_Comm_Udp()
+{
+}
+
+int TestCase_Comm_Udp::Run(int argc, char *argv[])
+{
+    LLBC_PrintLn("Service udp(datagram) session test:");
+
+    // Create client & server services.
+    LLBC_Service *svcs[2];
+    for (int i = 0; i < 2; ++i)
+    {
+        const bool asClient = i == 0;
+        LLBC_Service *svc = LLBC_Service::Create(asClient ? "UdpClient" : "UdpServer");
+
+        TestComp *comp = new TestComp(asClient);
+        svc->AddComponent(comp);
+        svc->AddCoderFactory(OPCODE, new PingDataFactory);
+        svc->Subscribe(OPCODE, comp, &TestComp::OnRecv);
+        if (svc->Start() != LLBC_OK)
+        {
+            LLBC_FilePrintLn(stderr, "Start service failed, err: %s", LLBC_FormatLastError());
+            delete svc;
+            for (int j = 0; j < i; ++j)
+                delete svcs[j];
+
+            return LLBC_FAILED;
+        }
+
+        svcs[i] = svc;
+    }
+
+    // Listen & connect, every client address will be a pseudo-session in server.
+    int sessionId = svcs[1]->ListenUdp(LISTEN_IP, LISTEN_PORT);
+    if (sessionId == 0)
+    {
+        LLBC_FilePrintLn(stderr, "Listen udp failed, err: %s", LLBC_FormatLastError());
+    }
+    else
+    {
+        LLBC_PrintLn("Listen udp succeed, sessionId: %d", sessionId);
+        if ((sessionId = svcs[0]->ConnectUdp(LISTEN_IP, LISTEN_PORT)) == 0)
+            LLBC_FilePrintLn(stderr, "Connect udp failed, err: %s", LLBC_FormatLastError());
+        else
+            LLBC_PrintLn("Connect udp succeed, sessionId: %d", sessionId);
+    }
+
+    LLBC_PrintLn("Press any key to continue...");
+    getchar();
+
+    delete svcs[0];
+    delete svcs[1];
+
+    return LLBC_OK;
+}
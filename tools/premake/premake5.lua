@@ -12,6 +12,7 @@ IS_WINDOWS = string.match(_ACTION, 'vs') ~= nil
 SLN_PATH = "../.."
 CORELIB_PATH = SLN_PATH .. "/llbc"
 TESTSUITE_PATH = SLN_PATH .. "/testsuite"
+BENCHMARK_PATH = SLN_PATH .. "/benchmark"
 WRAPS_PATH = SLN_PATH .. "/wrap"
 PY_WRAP_PATH = WRAPS_PATH .. "/pyllbc"
 LU_WRAP_PATH = WRAPS_PATH .. "/lullbc"
@@ -303,6 +304,79 @@ project "testsuite"
         end
     filter {}
 
+-- ****************************************************************************
+-- core library benchmark compile setting
+project "benchmark"
+    -- language, kind
+    language "c++"
+    kind "ConsoleApp"
+
+    -- dependents
+    dependson {
+        "llbc",
+    }
+
+    -- files
+    files {
+        BENCHMARK_PATH .. "/**.h",
+        BENCHMARK_PATH .. "/**.cpp",
+    }
+
+    -- includedirs
+    includedirs {
+        CORELIB_PATH .. "/include",
+        BENCHMARK_PATH,
+    }
+
+    -- links
+    libdirs { LLBC_OUTPUT_DIR }
+    filter { "system:linux" }
+        links {
+            "dl",
+            "pthread",
+        }
+    filter {}
+
+    filter { "system:not windows", "configurations:debug*" }
+        links {
+            "llbc_debug",
+        }
+    filter {}
+
+    filter { "system:not windows", "configurations:release*" }
+        links {
+            "llbc",
+        }
+    filter {}
+
+    filter { "system:windows" }
+        links {
+            "ws2_32",
+        }
+    filter {}
+
+    filter { "system:windows", "configurations:debug*" }
+        links {
+            "libllbc_debug",
+        }
+    filter {}
+
+    filter { "system:windows", "configurations:release*" }
+        links {
+            "libllbc",
+        }
+    filter {}
+
+    -- Enable c++11 support.
+    filter { "system:not windows" }
+        buildoptions {
+            "-std=c++11",
+        }
+    filter {}
+
+    -- Specific debug directory.
+    debugdir(LLBC_OUTPUT_DIR)
+
 group "wrap"
 
 -- ****************************************************************************